@@ -31,8 +31,15 @@
 #include "samba/ndr_security.h"
 
 #include <QCoreApplication>
+#include <QDataStream>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QLocale>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThreadPool>
 #include <algorithm>
 
 #define ATTRIBUTE_ATTRIBUTE_DISPLAY_NAMES "attributeDisplayNames"
@@ -67,7 +74,29 @@
 
 #define FLAG_ATTR_IS_CONSTRUCTED 0x00000004
 
-AdConfigPrivate::AdConfigPrivate() {
+// NOTE: increment version when format of cached data
+// changes, so that old caches are discarded
+#define SCHEMA_CACHE_MAGIC 0x41444d43
+#define SCHEMA_CACHE_VERSION 2
+
+QDataStream &operator<<(QDataStream &stream, const AdObject &object) {
+    stream << object.get_dn() << object.get_attributes_data();
+
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, AdObject &object) {
+    QString dn;
+    QHash<QString, QList<QByteArray>> attributes_data;
+    stream >> dn >> attributes_data;
+
+    object.load(dn, attributes_data);
+
+    return stream;
+}
+
+AdConfigPrivate::AdConfigPrivate()
+: class_extended_rights_loaded(false) {
 }
 
 AdConfig::AdConfig() {
@@ -81,14 +110,7 @@ AdConfig::~AdConfig() {
 void AdConfig::load(AdInterface &ad, const QLocale &locale) {
     d->domain = ad.get_domain();
 
-    d->filter_containers.clear();
-    d->columns.clear();
-    d->column_display_names.clear();
-    d->class_display_names.clear();
-    d->find_attributes.clear();
-    d->attribute_display_names.clear();
-    d->attribute_schemas.clear();
-    d->class_schemas.clear();
+    d->clear_schema_data();
 
     const AdObject rootDSE_object = ad.search_object(ROOT_DSE);
     d->domain_dn = rootDSE_object.get_string(ATTRIBUTE_DEFAULT_NAMING_CONTEXT);
@@ -100,6 +122,30 @@ void AdConfig::load(AdInterface &ad, const QLocale &locale) {
     const AdObject domain_object = ad.search_object(domain_dn());
     d->domain_sid = object_sid_display_value(domain_object.get_value(ATTRIBUTE_OBJECT_SID));
 
+    // NOTE: any schema modification updates schemaInfo
+    // of schema container and therefore it's uSNChanged.
+    // objectVersion changes on schema upgrades, which also
+    // update display specifiers. USN's are local to DC, so
+    // DC is also part of the key.
+    const QString cache_key = [&]() {
+        const AdObject schema_object = ad.search_object(schema_dn(), {ATTRIBUTE_OBJECT_VERSION, ATTRIBUTE_USN_CHANGED});
+        const QString object_version = schema_object.get_string(ATTRIBUTE_OBJECT_VERSION);
+        const QString usn_changed = schema_object.get_string(ATTRIBUTE_USN_CHANGED);
+        const QString ds_service_name = rootDSE_object.get_string(ATTRIBUTE_DS_SERVICE_NAME);
+
+        if (schema_object.is_empty() || usn_changed.isEmpty()) {
+            return QString();
+        }
+
+        return QString("%1;%2;%3;%4").arg(schema_dn(), object_version, usn_changed, ds_service_name);
+    }();
+
+    const QString cache_path = get_cache_path(locale);
+
+    if (!cache_key.isEmpty() && load_cache(cache_path, cache_key)) {
+        return;
+    }
+
     const QString locale_dir = [this, locale]() {
         const QString locale_code = [locale]() {
             if (locale.language() == QLocale::Russian) {
@@ -125,7 +171,9 @@ void AdConfig::load(AdInterface &ad, const QLocale &locale) {
 
     load_extended_rights(ad);
 
-    load_permissionable_attributes(CLASS_DOMAIN, ad);
+    if (!cache_key.isEmpty() && !ad.any_error_messages()) {
+        save_cache(cache_path, cache_key);
+    }
 }
 
 QString AdConfig::domain() const {
@@ -413,6 +461,11 @@ int AdConfig::get_attribute_range_upper(const QString &attribute) const {
     return d->attribute_schemas[attribute].get_int(ATTRIBUTE_RANGE_UPPER);
 }
 
+// NOTE: both forward links and back links have a link id
+bool AdConfig::get_attribute_is_linked(const QString &attribute) const {
+    return d->attribute_schemas[attribute].contains(ATTRIBUTE_LINK_ID);
+}
+
 bool AdConfig::get_attribute_is_backlink(const QString &attribute) const {
     if (d->attribute_schemas[attribute].contains(ATTRIBUTE_LINK_ID)) {
         const int link_id = d->attribute_schemas[attribute].get_int(ATTRIBUTE_LINK_ID);
@@ -442,92 +495,95 @@ QByteArray AdConfig::get_right_guid(const QString &right_cn) const {
 // dssec.dll. And we don't have dssec.dll, nor do we
 // have the ability to interact with it!
 QString AdConfig::get_right_name(const QByteArray &right_guid, const QLocale::Language language) const {
-    const QHash<QString, QString> cn_to_map_russian = {
-        {"DS-Replication-Get-Changes", QCoreApplication::translate("AdConfig", "DS Replication Get Changes")},
-        {"DS-Replication-Get-Changes-All", QCoreApplication::translate("AdConfig", "DS Replication Get Changes All")},
-        {"Email-Information", QCoreApplication::translate("AdConfig", "Phone and Mail Options")},
-        {"DS-Bypass-Quota", QCoreApplication::translate("AdConfig", "Bypass the quota restrictions during creation.")},
-        {"Receive-As", QCoreApplication::translate("AdConfig", "Receive As")},
-        {"Unexpire-Password", QCoreApplication::translate("AdConfig", "Unexpire Password")},
-        {"Do-Garbage-Collection", QCoreApplication::translate("AdConfig", "Do Garbage Collection")},
-        {"Allowed-To-Authenticate", QCoreApplication::translate("AdConfig", "Allowed To Authenticate")},
-        {"Change-PDC", QCoreApplication::translate("AdConfig", "Change PDC")},
-        {"Reanimate-Tombstones", QCoreApplication::translate("AdConfig", "Reanimate Tombstones")},
-        {"msmq-Peek-Dead-Letter", QCoreApplication::translate("AdConfig", "msmq Peek Dead Letter")},
-        {"Certificate-AutoEnrollment", QCoreApplication::translate("AdConfig", "AutoEnrollment")},
-        {"DS-Install-Replica", QCoreApplication::translate("AdConfig", "DS Install Replica")},
-        {"Domain-Password", QCoreApplication::translate("AdConfig", "Domain Password & Lockout Policies")},
-        {"Generate-RSoP-Logging", QCoreApplication::translate("AdConfig", "Generate RSoP Logging")},
-        {"Run-Protect-Admin-Groups-Task", QCoreApplication::translate("AdConfig", "Run Protect Admin Groups Task")},
-        {"Self-Membership", QCoreApplication::translate("AdConfig", "Self Membership")},
-        {"DS-Clone-Domain-Controller", QCoreApplication::translate("AdConfig", "Allow a DC to create a clone of itself")},
-        {"Domain-Other-Parameters", QCoreApplication::translate("AdConfig", "Other Domain Parameters (for use by SAM)")},
-        {"SAM-Enumerate-Entire-Domain", QCoreApplication::translate("AdConfig", "SAM Enumerate Entire Domain")},
-        {"DS-Write-Partition-Secrets", QCoreApplication::translate("AdConfig", "Write secret attributes of objects in a Partition")},
-        {"Send-As", QCoreApplication::translate("AdConfig", "Send As")},
-        {"DS-Replication-Manage-Topology", QCoreApplication::translate("AdConfig", "DS Replication Manage Topology")},
-        {"DS-Set-Owner", QCoreApplication::translate("AdConfig", "Set Owner of an object during creation.")},
-        {"Generate-RSoP-Planning", QCoreApplication::translate("AdConfig", "Generate RSoP Planning")},
-        {"Certificate-Enrollment", QCoreApplication::translate("AdConfig", "Certificate Enrollment")},
-        {"Web-Information", QCoreApplication::translate("AdConfig", "Web Information")},
-        {"Create-Inbound-Forest-Trust", QCoreApplication::translate("AdConfig", "Create Inbound Forest Trust")},
-        {"Migrate-SID-History", QCoreApplication::translate("AdConfig", "Migrate SID History")},
-        {"Update-Password-Not-Required-Bit", QCoreApplication::translate("AdConfig", "Update Password Not Required Bit")},
-        {"MS-TS-GatewayAccess", QCoreApplication::translate("AdConfig", "MS-TS-GatewayAccess")},
-        {"Validated-MS-DS-Additional-DNS-Host-Name", QCoreApplication::translate("AdConfig", "Validated write to MS DS Additional DNS Host Name")},
-        {"msmq-Receive", QCoreApplication::translate("AdConfig", "msmq Receive")},
-        {"Validated-DNS-Host-Name", QCoreApplication::translate("AdConfig", "Validated DNS Host Name")},
-        {"Send-To", QCoreApplication::translate("AdConfig", "Send To")},
-        {"DS-Replication-Get-Changes-In-Filtered-Set", QCoreApplication::translate("AdConfig", "DS Replication Get Changes In Filtered Set")},
-        {"Read-Only-Replication-Secret-Synchronization", QCoreApplication::translate("AdConfig", "Read Only Replication Secret Synchronization")},
-        {"Validated-MS-DS-Behavior-Version", QCoreApplication::translate("AdConfig", "Validated write to MS DS behavior version")},
-        {"msmq-Open-Connector", QCoreApplication::translate("AdConfig", "msmq Open Connector")},
-        {"Terminal-Server-License-Server", QCoreApplication::translate("AdConfig", "Terminal Server License Server")},
-        {"Change-Schema-Master", QCoreApplication::translate("AdConfig", "Change Schema Master")},
-        {"Recalculate-Hierarchy", QCoreApplication::translate("AdConfig", "Recalculate Hierarchy")},
-        {"DS-Check-Stale-Phantoms", QCoreApplication::translate("AdConfig", "DS Check Stale Phantoms")},
-        {"msmq-Receive-computer-Journal", QCoreApplication::translate("AdConfig", "msmq Receive computer Journal")},
-        {"User-Force-Change-Password", QCoreApplication::translate("AdConfig", "User Force Change Password")},
-        {"Domain-Administer-Server", QCoreApplication::translate("AdConfig", "Domain Administer Server")},
-        {"DS-Replication-Synchronize", QCoreApplication::translate("AdConfig", "DS Replication Synchronize")},
-        {"Personal-Information", QCoreApplication::translate("AdConfig", "Personal Information")},
-        {"msmq-Peek", QCoreApplication::translate("AdConfig", "msmq Peek")},
-        {"General-Information", QCoreApplication::translate("AdConfig", "General Information")},
-        {"Membership", QCoreApplication::translate("AdConfig", "Group Membership")},
-        {"Add-GUID", QCoreApplication::translate("AdConfig", "Add GUID")},
-        {"RAS-Information", QCoreApplication::translate("AdConfig", "Remote Access Information")},
-        {"DS-Execute-Intentions-Script", QCoreApplication::translate("AdConfig", "DS Execute Intentions Script")},
-        {"Allocate-Rids", QCoreApplication::translate("AdConfig", "Allocate Rids")},
-        {"Update-Schema-Cache", QCoreApplication::translate("AdConfig", "Update Schema Cache")},
-        {"Apply-Group-Policy", QCoreApplication::translate("AdConfig", "Apply Group Policy")},
-        {"User-Account-Restrictions", QCoreApplication::translate("AdConfig", "Account Restrictions")},
-        {"Validated-SPN", QCoreApplication::translate("AdConfig", "Validated SPN")},
-        {"DS-Read-Partition-Secrets", QCoreApplication::translate("AdConfig", "Read secret attributes of objects in a Partition")},
-        {"User-Logon", QCoreApplication::translate("AdConfig", "Logon Information")},
-        {"DS-Query-Self-Quota", QCoreApplication::translate("AdConfig", "DS Query Self Quota")},
-        {"Change-Infrastructure-Master", QCoreApplication::translate("AdConfig", "Change Infrastructure Master")},
-        {"Open-Address-Book", QCoreApplication::translate("AdConfig", "Open Address Book")},
-        {"User-Change-Password", QCoreApplication::translate("AdConfig", "User Change Password")},
-        {"msmq-Peek-computer-Journal", QCoreApplication::translate("AdConfig", "msmq Peek computer Journal")},
-        {"Change-Domain-Master", QCoreApplication::translate("AdConfig", "Change Domain Master")},
-        {"msmq-Send", QCoreApplication::translate("AdConfig", "msmq Send")},
-        {"Change-Rid-Master", QCoreApplication::translate("AdConfig", "Change Rid Master")},
-        {"Recalculate-Security-Inheritance", QCoreApplication::translate("AdConfig", "Recalculate Security Inheritance")},
-        {"Refresh-Group-Cache", QCoreApplication::translate("AdConfig", "Refresh Group Cache")},
-        {"Manage-Optional-Features", QCoreApplication::translate("AdConfig", "Manage Optional Features")},
-        {"Reload-SSL-Certificate", QCoreApplication::translate("AdConfig", "Reload SSL Certificate")},
-        {"Enable-Per-User-Reversibly-Encrypted-Password", QCoreApplication::translate("AdConfig", "Enable Per User Reversibly Encrypted Password")},
-        {"DS-Replication-Monitor-Topology", QCoreApplication::translate("AdConfig", "DS Replication Monitor Topology")},
-        {"Public-Information", QCoreApplication::translate("AdConfig", "Public Information")},
-        {"Private-Information", QCoreApplication::translate("AdConfig", "Private Information")},
-        {"msmq-Receive-Dead-Letter", QCoreApplication::translate("AdConfig", "msmq Receive Dead Letter")},
-        {"msmq-Receive-journal", QCoreApplication::translate("AdConfig", "msmq Receive journal")},
-        {"DNS-Host-Name-Attributes", QCoreApplication::translate("AdConfig", "DNS Host Name Attributes")},
+    // NOTE: map stores untranslated source strings and is
+    // built once. Strings are translated on lookup, so that
+    // changing app language at runtime still works.
+    static const QHash<QString, const char *> cn_to_name_russian = {
+        {"DS-Replication-Get-Changes", QT_TRANSLATE_NOOP("AdConfig", "DS Replication Get Changes")},
+        {"DS-Replication-Get-Changes-All", QT_TRANSLATE_NOOP("AdConfig", "DS Replication Get Changes All")},
+        {"Email-Information", QT_TRANSLATE_NOOP("AdConfig", "Phone and Mail Options")},
+        {"DS-Bypass-Quota", QT_TRANSLATE_NOOP("AdConfig", "Bypass the quota restrictions during creation.")},
+        {"Receive-As", QT_TRANSLATE_NOOP("AdConfig", "Receive As")},
+        {"Unexpire-Password", QT_TRANSLATE_NOOP("AdConfig", "Unexpire Password")},
+        {"Do-Garbage-Collection", QT_TRANSLATE_NOOP("AdConfig", "Do Garbage Collection")},
+        {"Allowed-To-Authenticate", QT_TRANSLATE_NOOP("AdConfig", "Allowed To Authenticate")},
+        {"Change-PDC", QT_TRANSLATE_NOOP("AdConfig", "Change PDC")},
+        {"Reanimate-Tombstones", QT_TRANSLATE_NOOP("AdConfig", "Reanimate Tombstones")},
+        {"msmq-Peek-Dead-Letter", QT_TRANSLATE_NOOP("AdConfig", "msmq Peek Dead Letter")},
+        {"Certificate-AutoEnrollment", QT_TRANSLATE_NOOP("AdConfig", "AutoEnrollment")},
+        {"DS-Install-Replica", QT_TRANSLATE_NOOP("AdConfig", "DS Install Replica")},
+        {"Domain-Password", QT_TRANSLATE_NOOP("AdConfig", "Domain Password & Lockout Policies")},
+        {"Generate-RSoP-Logging", QT_TRANSLATE_NOOP("AdConfig", "Generate RSoP Logging")},
+        {"Run-Protect-Admin-Groups-Task", QT_TRANSLATE_NOOP("AdConfig", "Run Protect Admin Groups Task")},
+        {"Self-Membership", QT_TRANSLATE_NOOP("AdConfig", "Self Membership")},
+        {"DS-Clone-Domain-Controller", QT_TRANSLATE_NOOP("AdConfig", "Allow a DC to create a clone of itself")},
+        {"Domain-Other-Parameters", QT_TRANSLATE_NOOP("AdConfig", "Other Domain Parameters (for use by SAM)")},
+        {"SAM-Enumerate-Entire-Domain", QT_TRANSLATE_NOOP("AdConfig", "SAM Enumerate Entire Domain")},
+        {"DS-Write-Partition-Secrets", QT_TRANSLATE_NOOP("AdConfig", "Write secret attributes of objects in a Partition")},
+        {"Send-As", QT_TRANSLATE_NOOP("AdConfig", "Send As")},
+        {"DS-Replication-Manage-Topology", QT_TRANSLATE_NOOP("AdConfig", "DS Replication Manage Topology")},
+        {"DS-Set-Owner", QT_TRANSLATE_NOOP("AdConfig", "Set Owner of an object during creation.")},
+        {"Generate-RSoP-Planning", QT_TRANSLATE_NOOP("AdConfig", "Generate RSoP Planning")},
+        {"Certificate-Enrollment", QT_TRANSLATE_NOOP("AdConfig", "Certificate Enrollment")},
+        {"Web-Information", QT_TRANSLATE_NOOP("AdConfig", "Web Information")},
+        {"Create-Inbound-Forest-Trust", QT_TRANSLATE_NOOP("AdConfig", "Create Inbound Forest Trust")},
+        {"Migrate-SID-History", QT_TRANSLATE_NOOP("AdConfig", "Migrate SID History")},
+        {"Update-Password-Not-Required-Bit", QT_TRANSLATE_NOOP("AdConfig", "Update Password Not Required Bit")},
+        {"MS-TS-GatewayAccess", QT_TRANSLATE_NOOP("AdConfig", "MS-TS-GatewayAccess")},
+        {"Validated-MS-DS-Additional-DNS-Host-Name", QT_TRANSLATE_NOOP("AdConfig", "Validated write to MS DS Additional DNS Host Name")},
+        {"msmq-Receive", QT_TRANSLATE_NOOP("AdConfig", "msmq Receive")},
+        {"Validated-DNS-Host-Name", QT_TRANSLATE_NOOP("AdConfig", "Validated DNS Host Name")},
+        {"Send-To", QT_TRANSLATE_NOOP("AdConfig", "Send To")},
+        {"DS-Replication-Get-Changes-In-Filtered-Set", QT_TRANSLATE_NOOP("AdConfig", "DS Replication Get Changes In Filtered Set")},
+        {"Read-Only-Replication-Secret-Synchronization", QT_TRANSLATE_NOOP("AdConfig", "Read Only Replication Secret Synchronization")},
+        {"Validated-MS-DS-Behavior-Version", QT_TRANSLATE_NOOP("AdConfig", "Validated write to MS DS behavior version")},
+        {"msmq-Open-Connector", QT_TRANSLATE_NOOP("AdConfig", "msmq Open Connector")},
+        {"Terminal-Server-License-Server", QT_TRANSLATE_NOOP("AdConfig", "Terminal Server License Server")},
+        {"Change-Schema-Master", QT_TRANSLATE_NOOP("AdConfig", "Change Schema Master")},
+        {"Recalculate-Hierarchy", QT_TRANSLATE_NOOP("AdConfig", "Recalculate Hierarchy")},
+        {"DS-Check-Stale-Phantoms", QT_TRANSLATE_NOOP("AdConfig", "DS Check Stale Phantoms")},
+        {"msmq-Receive-computer-Journal", QT_TRANSLATE_NOOP("AdConfig", "msmq Receive computer Journal")},
+        {"User-Force-Change-Password", QT_TRANSLATE_NOOP("AdConfig", "User Force Change Password")},
+        {"Domain-Administer-Server", QT_TRANSLATE_NOOP("AdConfig", "Domain Administer Server")},
+        {"DS-Replication-Synchronize", QT_TRANSLATE_NOOP("AdConfig", "DS Replication Synchronize")},
+        {"Personal-Information", QT_TRANSLATE_NOOP("AdConfig", "Personal Information")},
+        {"msmq-Peek", QT_TRANSLATE_NOOP("AdConfig", "msmq Peek")},
+        {"General-Information", QT_TRANSLATE_NOOP("AdConfig", "General Information")},
+        {"Membership", QT_TRANSLATE_NOOP("AdConfig", "Group Membership")},
+        {"Add-GUID", QT_TRANSLATE_NOOP("AdConfig", "Add GUID")},
+        {"RAS-Information", QT_TRANSLATE_NOOP("AdConfig", "Remote Access Information")},
+        {"DS-Execute-Intentions-Script", QT_TRANSLATE_NOOP("AdConfig", "DS Execute Intentions Script")},
+        {"Allocate-Rids", QT_TRANSLATE_NOOP("AdConfig", "Allocate Rids")},
+        {"Update-Schema-Cache", QT_TRANSLATE_NOOP("AdConfig", "Update Schema Cache")},
+        {"Apply-Group-Policy", QT_TRANSLATE_NOOP("AdConfig", "Apply Group Policy")},
+        {"User-Account-Restrictions", QT_TRANSLATE_NOOP("AdConfig", "Account Restrictions")},
+        {"Validated-SPN", QT_TRANSLATE_NOOP("AdConfig", "Validated SPN")},
+        {"DS-Read-Partition-Secrets", QT_TRANSLATE_NOOP("AdConfig", "Read secret attributes of objects in a Partition")},
+        {"User-Logon", QT_TRANSLATE_NOOP("AdConfig", "Logon Information")},
+        {"DS-Query-Self-Quota", QT_TRANSLATE_NOOP("AdConfig", "DS Query Self Quota")},
+        {"Change-Infrastructure-Master", QT_TRANSLATE_NOOP("AdConfig", "Change Infrastructure Master")},
+        {"Open-Address-Book", QT_TRANSLATE_NOOP("AdConfig", "Open Address Book")},
+        {"User-Change-Password", QT_TRANSLATE_NOOP("AdConfig", "User Change Password")},
+        {"msmq-Peek-computer-Journal", QT_TRANSLATE_NOOP("AdConfig", "msmq Peek computer Journal")},
+        {"Change-Domain-Master", QT_TRANSLATE_NOOP("AdConfig", "Change Domain Master")},
+        {"msmq-Send", QT_TRANSLATE_NOOP("AdConfig", "msmq Send")},
+        {"Change-Rid-Master", QT_TRANSLATE_NOOP("AdConfig", "Change Rid Master")},
+        {"Recalculate-Security-Inheritance", QT_TRANSLATE_NOOP("AdConfig", "Recalculate Security Inheritance")},
+        {"Refresh-Group-Cache", QT_TRANSLATE_NOOP("AdConfig", "Refresh Group Cache")},
+        {"Manage-Optional-Features", QT_TRANSLATE_NOOP("AdConfig", "Manage Optional Features")},
+        {"Reload-SSL-Certificate", QT_TRANSLATE_NOOP("AdConfig", "Reload SSL Certificate")},
+        {"Enable-Per-User-Reversibly-Encrypted-Password", QT_TRANSLATE_NOOP("AdConfig", "Enable Per User Reversibly Encrypted Password")},
+        {"DS-Replication-Monitor-Topology", QT_TRANSLATE_NOOP("AdConfig", "DS Replication Monitor Topology")},
+        {"Public-Information", QT_TRANSLATE_NOOP("AdConfig", "Public Information")},
+        {"Private-Information", QT_TRANSLATE_NOOP("AdConfig", "Private Information")},
+        {"msmq-Receive-Dead-Letter", QT_TRANSLATE_NOOP("AdConfig", "msmq Receive Dead Letter")},
+        {"msmq-Receive-journal", QT_TRANSLATE_NOOP("AdConfig", "msmq Receive journal")},
+        {"DNS-Host-Name-Attributes", QT_TRANSLATE_NOOP("AdConfig", "DNS Host Name Attributes")},
     };
 
     const QString right_cn = d->right_guid_to_cn_map[right_guid];
-    if (language == QLocale::Russian && cn_to_map_russian.contains(right_cn)) {
-        const QString out = cn_to_map_russian[right_cn];
+    if (language == QLocale::Russian && cn_to_name_russian.contains(right_cn)) {
+        const QString out = QCoreApplication::translate("AdConfig", cn_to_name_russian[right_cn]);
 
         return out;
     }
@@ -537,13 +593,23 @@ QString AdConfig::get_right_name(const QByteArray &right_guid, const QLocale::La
 }
 
 QList<QString> AdConfig::get_extended_rights_list(const QList<QString> &class_list) const {
+    d->load_class_extended_rights();
+
+    // NOTE: collect indexes and sort them to preserve the
+    // order of extended rights list
+    QList<int> index_list;
+    for (const QString &object_class : class_list) {
+        index_list += d->class_extended_rights_map.value(object_class);
+    }
+
+    std::sort(index_list.begin(), index_list.end());
+    index_list.erase(std::unique(index_list.begin(), index_list.end()), index_list.end());
+
     QList<QString> out;
+    out.reserve(index_list.size());
 
-    for (const QString &rights : d->extended_rights_list) {
-        const bool applies_to = rights_applies_to_class(rights, class_list);
-        if (applies_to) {
-            out.append(rights);
-        }
+    for (const int index : index_list) {
+        out.append(d->extended_rights_list[index]);
     }
 
     return out;
@@ -593,14 +659,31 @@ QList<QString> AdConfig::get_noncontainer_classes() {
 bool AdConfig::rights_applies_to_class(const QString &rights_cn, const QList<QString> &class_list) const {
     const QByteArray rights_guid = d->rights_name_to_guid_map[rights_cn];
 
-    const QList<QString> applies_to_list = d->rights_applies_to_map[rights_guid];
-    const QSet<QString> applies_to_set = QSet<QString>(applies_to_list.begin(), applies_to_list.end());
+    const QList<QString> applies_to_list = d->rights_applies_to_map.value(rights_guid);
+
+    // NOTE: both lists are short, so linear search is
+    // cheaper than building sets
+    for (const QString &object_class : class_list) {
+        if (applies_to_list.contains(object_class)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool AdConfig::get_cached_right_list(const QString &key, QList<SecurityRight> *out) const {
+    if (!d->right_list_cache.contains(key)) {
+        return false;
+    }
 
-    const QSet<QString> class_set = QSet<QString>(class_list.begin(), class_list.end());
+    *out = d->right_list_cache.value(key);
 
-    const bool applies = applies_to_set.intersects(class_set);
+    return true;
+}
 
-    return applies;
+void AdConfig::cache_right_list(const QString &key, const QList<SecurityRight> &right_list) const {
+    d->right_list_cache.insert(key, right_list);
 }
 
 QStringList AdConfig::get_possible_inferiors(const QString &obj_class) const {
@@ -608,6 +691,10 @@ QStringList AdConfig::get_possible_inferiors(const QString &obj_class) const {
 }
 
 QStringList AdConfig::get_permissionable_attributes(const QString &obj_class) const {
+    if (!d->class_permissionable_attributes_map.contains(obj_class)) {
+        load_permissionable_attributes(obj_class);
+    }
+
     return d->class_permissionable_attributes_map[obj_class];
 }
 
@@ -898,22 +985,76 @@ void AdConfig::load_filter_containers(AdInterface &ad, const QString &locale_dir
     d->filter_containers.append({CLASS_CONFIGURATION, CLASS_dMD});
 }
 
-void AdConfig::load_permissionable_attributes(const QString &obj_class, AdInterface &ad) {
-    const QString filter = filter_CONDITION(Condition_Equals, ATTRIBUTE_LDAP_DISPLAY_NAME, obj_class);
-    QHash<QString, AdObject> results = ad.search(schema_dn(), SearchScope_Children, filter,
-                                             {ATTRIBUTE_ALLOWED_ATTRIBUTES, ATTRIBUTE_SYSTEM_MAY_CONTAIN});
-    if (results.isEmpty()) {
+// NOTE: permissionable attributes are derived from
+// already loaded class schemas instead of requesting
+// constructed allowedAttributes from server for each
+// class. Class attributes are attributes of the class
+// itself, it's superclasses and auxiliary classes. This is
+// done lazily, only for classes requested by security tab.
+void AdConfig::load_permissionable_attributes(const QString &obj_class) const {
+    // NOTE: permissions can only be assigned for classes
+    // that can be (indirectly) contained in domain
+    const bool is_permissionable_class = [&]() {
+        if (d->permissionable_classes.isEmpty()) {
+            QList<QString> stack = {CLASS_DOMAIN};
+
+            while (!stack.isEmpty()) {
+                const QString current_class = stack.takeLast();
+
+                if (d->permissionable_classes.contains(current_class)) {
+                    continue;
+                }
+
+                d->permissionable_classes.insert(current_class);
+                stack.append(d->class_possible_inferiors_map.value(current_class));
+            }
+        }
+
+        return d->permissionable_classes.contains(obj_class);
+    }();
+
+    if (!is_permissionable_class) {
+        d->class_permissionable_attributes_map[obj_class] = QStringList();
+
         return;
     }
-    const AdObject class_schema_object = results.values()[0];
 
-    const QStringList allowed_attrs = bytearray_list_to_string_list(class_schema_object.get_values(ATTRIBUTE_ALLOWED_ATTRIBUTES));
-    const QStringList attrs_system_may_contain = bytearray_list_to_string_list(class_schema_object.get_values(ATTRIBUTE_SYSTEM_MAY_CONTAIN));
+    const QList<QString> class_attributes_list = {
+        ATTRIBUTE_MAY_CONTAIN,
+        ATTRIBUTE_SYSTEM_MAY_CONTAIN,
+        ATTRIBUTE_MUST_CONTAIN,
+        ATTRIBUTE_SYSTEM_MUST_CONTAIN,
+    };
+
+    QSet<QString> allowed_attrs_set;
+    QSet<QString> visited_classes;
+    QList<QString> stack = {obj_class};
+
+    while (!stack.isEmpty()) {
+        const QString current_class = stack.takeLast();
+
+        if (visited_classes.contains(current_class) || !d->class_schemas.contains(current_class)) {
+            continue;
+        }
+
+        visited_classes.insert(current_class);
+
+        const AdObject &schema = d->class_schemas[current_class];
+
+        for (const QString &class_attribute : class_attributes_list) {
+            const QList<QString> attrs = schema.get_strings(class_attribute);
+            allowed_attrs_set.unite(QSet<QString>(attrs.begin(), attrs.end()));
+        }
+
+        stack.append(schema.get_strings(ATTRIBUTE_AUXILIARY_CLASS));
+        stack.append(schema.get_strings(ATTRIBUTE_SYSTEM_AUXILIARY_CLASS));
 
-    // Use set to remove duplicates (just in case)
-    QSet<QString> allowed_attrs_set = QSet<QString>(allowed_attrs.begin(), allowed_attrs.end());
-    QSet<QString> may_contain_attrs_set = QSet<QString>(attrs_system_may_contain.begin(), attrs_system_may_contain.end());
-    allowed_attrs_set |= may_contain_attrs_set;
+        // NOTE: top is subclass of itself
+        const QString parent_class = d->sub_class_of_map.value(current_class);
+        if (parent_class != current_class) {
+            stack.append(parent_class);
+        }
+    }
 
     QSet<QString> permissionable_attrs_set = allowed_attrs_set;
     // Remove backlinks, constructed and system-only attributes
@@ -926,13 +1067,189 @@ void AdConfig::load_permissionable_attributes(const QString &obj_class, AdInterf
     QStringList permissionable_attrs = QStringList(permissionable_attrs_set.begin(), permissionable_attrs_set.end());
     permissionable_attrs.sort();
     d->class_permissionable_attributes_map[obj_class] = permissionable_attrs;
+}
 
-    for (const QString &inferior : d->class_possible_inferiors_map.value(obj_class, QStringList())) {
-        if (inferior == obj_class || d->class_permissionable_attributes_map.contains(inferior)) {
-            continue;
+QString AdConfig::get_cache_path(const QLocale &locale) const {
+    const QString cache_dir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (cache_dir.isEmpty() || domain().isEmpty()) {
+        return QString();
+    }
+
+    const QString file_name = QString("%1_%2.cache").arg(domain().toLower(), locale.name());
+    const QString out = QDir(cache_dir).filePath(QString("admc/schema/%1").arg(file_name));
+
+    return out;
+}
+
+bool AdConfig::load_cache(const QString &cache_path, const QString &cache_key) {
+    if (cache_path.isEmpty()) {
+        return false;
+    }
+
+    QFile file(cache_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 file_size = file.size();
+    uchar *file_data = file.map(0, file_size);
+    if (file_data == nullptr) {
+        return false;
+    }
+
+    // NOTE: read directly from mapped memory, without
+    // copying whole file into a buffer
+    const QByteArray bytes = QByteArray::fromRawData((const char *) file_data, file_size);
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic;
+    quint32 version;
+    QString saved_key;
+    stream >> magic >> version >> saved_key;
+
+    const bool header_ok = (stream.status() == QDataStream::Ok && magic == SCHEMA_CACHE_MAGIC && version == SCHEMA_CACHE_VERSION && saved_key == cache_key);
+
+    bool out = false;
+
+    if (header_ok) {
+        d->read_schema_data(stream);
+
+        out = (stream.status() == QDataStream::Ok);
+
+        if (!out) {
+            d->clear_schema_data();
+        }
+    }
+
+    file.unmap(file_data);
+
+    return out;
+}
+
+// NOTE: saving is done in the background because cache
+// files are large. A copy of data is saved, which is cheap
+// because Qt containers are implicitly shared.
+void AdConfig::save_cache(const QString &cache_path, const QString &cache_key) const {
+    if (cache_path.isEmpty()) {
+        return;
+    }
+
+    const AdConfigPrivate data_copy = *d;
+
+    QThreadPool::globalInstance()->start([cache_path, cache_key, data_copy]() {
+        QDir().mkpath(QFileInfo(cache_path).absolutePath());
+
+        QSaveFile file(cache_path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return;
+        }
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_6_0);
+
+        stream << (quint32) SCHEMA_CACHE_MAGIC << (quint32) SCHEMA_CACHE_VERSION << cache_key;
+        data_copy.write_schema_data(stream);
+
+        if (stream.status() == QDataStream::Ok) {
+            file.commit();
+        } else {
+            file.cancelWriting();
+        }
+    });
+}
+
+void AdConfigPrivate::clear_schema_data() {
+    filter_containers.clear();
+    columns.clear();
+    column_display_names.clear();
+    class_display_names.clear();
+    find_attributes.clear();
+    attribute_display_names.clear();
+    attribute_schemas.clear();
+    class_schemas.clear();
+    right_to_guid_map.clear();
+    right_guid_to_cn_map.clear();
+    rights_guid_to_name_map.clear();
+    rights_name_to_guid_map.clear();
+    rights_applies_to_map.clear();
+    extended_rights_list.clear();
+    rights_valid_accesses_map.clear();
+    guid_to_attribute_map.clear();
+    guid_to_class_map.clear();
+    sub_class_of_map.clear();
+    class_possible_inferiors_map.clear();
+    class_permissionable_attributes_map.clear();
+    permissionable_classes.clear();
+    class_extended_rights_map.clear();
+    class_extended_rights_loaded = false;
+    right_list_cache.clear();
+}
+
+void AdConfigPrivate::load_class_extended_rights() {
+    if (class_extended_rights_loaded) {
+        return;
+    }
+
+    for (int i = 0; i < extended_rights_list.size(); i++) {
+        const QString &rights = extended_rights_list[i];
+        const QByteArray rights_guid = rights_name_to_guid_map.value(rights);
+        const QList<QString> applies_to_list = rights_applies_to_map.value(rights_guid);
+
+        for (const QString &object_class : applies_to_list) {
+            QList<int> &index_list = class_extended_rights_map[object_class];
+
+            if (index_list.isEmpty() || index_list.last() != i) {
+                index_list.append(i);
+            }
         }
-        load_permissionable_attributes(inferior, ad);
     }
+
+    class_extended_rights_loaded = true;
+}
+
+void AdConfigPrivate::write_schema_data(QDataStream &stream) const {
+    stream << filter_containers;
+    stream << columns;
+    stream << column_display_names;
+    stream << class_display_names;
+    stream << find_attributes;
+    stream << attribute_display_names;
+    stream << attribute_schemas;
+    stream << class_schemas;
+    stream << right_to_guid_map;
+    stream << right_guid_to_cn_map;
+    stream << rights_guid_to_name_map;
+    stream << rights_name_to_guid_map;
+    stream << rights_applies_to_map;
+    stream << extended_rights_list;
+    stream << rights_valid_accesses_map;
+    stream << guid_to_attribute_map;
+    stream << guid_to_class_map;
+    stream << sub_class_of_map;
+    stream << class_possible_inferiors_map;
+}
+
+void AdConfigPrivate::read_schema_data(QDataStream &stream) {
+    stream >> filter_containers;
+    stream >> columns;
+    stream >> column_display_names;
+    stream >> class_display_names;
+    stream >> find_attributes;
+    stream >> attribute_display_names;
+    stream >> attribute_schemas;
+    stream >> class_schemas;
+    stream >> right_to_guid_map;
+    stream >> right_guid_to_cn_map;
+    stream >> rights_guid_to_name_map;
+    stream >> rights_name_to_guid_map;
+    stream >> rights_applies_to_map;
+    stream >> extended_rights_list;
+    stream >> rights_valid_accesses_map;
+    stream >> guid_to_attribute_map;
+    stream >> guid_to_class_map;
+    stream >> sub_class_of_map;
+    stream >> class_possible_inferiors_map;
 }
 
 QList<QString> AdConfigPrivate::add_auxiliary_classes(const QList<QString> &object_classes) const {
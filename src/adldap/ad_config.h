@@ -37,6 +37,7 @@ class QLocale;
 class QString;
 class QLineEdit;
 class QByteArray;
+struct SecurityRight;
 template <typename T>
 class QList;
 
@@ -91,6 +92,7 @@ public:
     bool get_attribute_is_single_valued(const Attribute &attribute) const;
     bool get_attribute_is_system_only(const Attribute &attribute) const;
     int get_attribute_range_upper(const Attribute &attribute) const;
+    bool get_attribute_is_linked(const Attribute &attribute) const;
     bool get_attribute_is_backlink(const Attribute &attribute) const;
     bool get_attribute_is_constructed(const Attribute &attribute) const;
 
@@ -115,6 +117,12 @@ public:
 
     bool rights_applies_to_class(const QString &rights_cn, const QList<QString> &class_list) const;
 
+    // Storage for right lists computed by ad_security
+    // f-ns. Right lists only depend on schema, so they are
+    // computed once and reused until config is reloaded.
+    bool get_cached_right_list(const QString &key, QList<SecurityRight> *out) const;
+    void cache_right_list(const QString &key, const QList<SecurityRight> &right_list) const;
+
     QStringList get_possible_inferiors(const QString &obj_class) const;
     QStringList get_permissionable_attributes(const QString &obj_class) const;
 
@@ -142,7 +150,14 @@ private:
     void load_columns(AdInterface &ad, const QString &locale_dir);
     void load_filter_containers(AdInterface &ad, const QString &locale_dir);
 
-    void load_permissionable_attributes(const QString &obj_class, AdInterface &ad);
+    void load_permissionable_attributes(const QString &obj_class) const;
+
+    // Schema cache is stored on disk per domain and
+    // locale. Cache is valid only if it was created for
+    // the same cache key.
+    QString get_cache_path(const QLocale &locale) const;
+    bool load_cache(const QString &cache_path, const QString &cache_key);
+    void save_cache(const QString &cache_path, const QString &cache_key) const;
 
     AdConfigPrivate *d;
 };
@@ -22,12 +22,16 @@
 #define AD_CONFIG_P_H
 
 #include "ad_object.h"
+#include "ad_security.h"
 
 #include <QByteArray>
 #include <QHash>
 #include <QList>
+#include <QSet>
 #include <QString>
 
+class QDataStream;
+
 // NOTE: name strings to reduce confusion
 typedef QString ObjectClass;
 typedef QString Attribute;
@@ -58,6 +62,15 @@ public:
 
     QList<ObjectClass> add_auxiliary_classes(const QList<QString> &object_classes) const;
 
+    // Clears all data that is loaded from schema and
+    // display specifiers
+    void clear_schema_data();
+
+    // Read/write data that is loaded from schema and
+    // display specifiers. Used for on-disk cache.
+    void write_schema_data(QDataStream &stream) const;
+    void read_schema_data(QDataStream &stream);
+
     QHash<QString, QByteArray> right_to_guid_map;
     QHash<QByteArray, QString> right_guid_to_cn_map;
     QHash<QByteArray, QString> rights_guid_to_name_map;
@@ -76,9 +89,27 @@ public:
     // Contains classes of possible child objects for given container class.
     // This also includes possible child classes of child classes (and etc).
     QHash<QString, QStringList> class_possible_inferiors_map;
-    // Contains editable attributes for the object class and its child classes.
-    // Used when assigning custom permissions.
+    // Contains editable attributes for the object class.
+    // Used when assigning custom permissions. Loaded
+    // lazily, on first request for given class.
     QHash<QString, QStringList> class_permissionable_attributes_map;
+    // Classes that can be contained in domain, directly or
+    // indirectly. Only these classes have permissionable
+    // attributes.
+    QSet<QString> permissionable_classes;
+
+    // Maps class to indexes of extended rights (in
+    // extended_rights_list) that apply to that class.
+    // Built lazily from rights_applies_to_map, on first
+    // request.
+    QHash<QString, QList<int>> class_extended_rights_map;
+    bool class_extended_rights_loaded;
+    void load_class_extended_rights();
+
+    // Right lists computed by ad_security f-ns. They only
+    // depend on schema, so they are computed once per
+    // config load.
+    QHash<QString, QList<SecurityRight>> right_list_cache;
 };
 
 #endif /* AD_CONFIG_P_H */
@@ -0,0 +1,212 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ad_connection_pool.h"
+
+#include <ldap.h>
+#include <poll.h>
+
+#include <QMutexLocker>
+
+// NOTE: AD drops connections that were idle for longer
+// than MaxConnIdleTime, which is 900 seconds by default.
+// Expire idle handles a bit earlier than that so that we
+// don't lease a handle that is about to be dropped.
+#define DEFAULT_MAX_IDLE_TIME_SECONDS 600
+#define DEFAULT_MAX_IDLE_PER_DC 4
+
+AdConnectionPool *AdConnectionPool::instance() {
+    static AdConnectionPool pool;
+
+    return &pool;
+}
+
+AdConnectionPool::AdConnectionPool()
+: m_generation(0),
+  max_idle_per_dc(DEFAULT_MAX_IDLE_PER_DC),
+  max_idle_time_ms(DEFAULT_MAX_IDLE_TIME_SECONDS * 1000) {
+}
+
+AdConnectionPool::~AdConnectionPool() {
+    for (const QList<PooledConnection> &connection_list : idle_map) {
+        for (const PooledConnection &connection : connection_list) {
+            unbind(connection.ld);
+        }
+    }
+}
+
+LDAP *AdConnectionPool::acquire(const QString &dc, QString *client_user_out, int *generation_out) {
+    QElapsedTimer wait_timer;
+    wait_timer.start();
+
+    QMutexLocker locker(&mutex);
+
+    *generation_out = m_generation;
+
+    LDAP *out = NULL;
+
+    QList<PooledConnection> &connection_list = idle_map[dc];
+    while (!connection_list.isEmpty()) {
+        // NOTE: take most recently returned handle, it is
+        // the least likely to be expired
+        const PooledConnection connection = connection_list.takeLast();
+
+        const bool expired = connection.idle_timer.hasExpired(max_idle_time_ms);
+        if (expired || !connection_is_alive(connection.ld)) {
+            unbind(connection.ld);
+            m_stats.discarded++;
+
+            continue;
+        }
+
+        *client_user_out = connection.client_user;
+        out = connection.ld;
+
+        break;
+    }
+
+    if (out != NULL) {
+        m_stats.hits++;
+        m_stats.leased_count++;
+    } else {
+        m_stats.misses++;
+    }
+
+    m_stats.idle_count = 0;
+    for (const QList<PooledConnection> &list : idle_map) {
+        m_stats.idle_count += list.size();
+    }
+
+    m_stats.wait_time_ms += wait_timer.elapsed();
+
+    return out;
+}
+
+void AdConnectionPool::release(LDAP *ld, const QString &dc, const QString &client_user, const int generation, const bool reusable) {
+    if (ld == NULL) {
+        return;
+    }
+
+    QMutexLocker locker(&mutex);
+
+    m_stats.leased_count--;
+
+    QList<PooledConnection> &connection_list = idle_map[dc];
+
+    const bool is_outdated = (generation != m_generation);
+    const bool pool_is_full = (connection_list.size() >= max_idle_per_dc);
+
+    if (!reusable || is_outdated || pool_is_full) {
+        unbind(ld);
+
+        return;
+    }
+
+    PooledConnection connection;
+    connection.ld = ld;
+    connection.client_user = client_user;
+    connection.idle_timer.start();
+
+    connection_list.append(connection);
+    m_stats.idle_count++;
+}
+
+void AdConnectionPool::add_leased(const qint64 bind_time_ms, const bool bind_success) {
+    QMutexLocker locker(&mutex);
+
+    m_stats.bind_time_ms += bind_time_ms;
+
+    if (bind_success) {
+        m_stats.binds++;
+        m_stats.leased_count++;
+    } else {
+        m_stats.bind_failures++;
+    }
+}
+
+void AdConnectionPool::invalidate() {
+    QMutexLocker locker(&mutex);
+
+    for (const QList<PooledConnection> &connection_list : idle_map) {
+        for (const PooledConnection &connection : connection_list) {
+            unbind(connection.ld);
+            m_stats.discarded++;
+        }
+    }
+
+    idle_map.clear();
+    m_stats.idle_count = 0;
+
+    m_generation++;
+}
+
+int AdConnectionPool::generation() const {
+    QMutexLocker locker(&mutex);
+
+    return m_generation;
+}
+
+void AdConnectionPool::set_max_idle_per_dc(const int max_idle) {
+    QMutexLocker locker(&mutex);
+
+    max_idle_per_dc = max_idle;
+}
+
+void AdConnectionPool::set_max_idle_time(const int seconds) {
+    QMutexLocker locker(&mutex);
+
+    max_idle_time_ms = seconds * 1000;
+}
+
+AdConnectionPoolStats AdConnectionPool::stats() const {
+    QMutexLocker locker(&mutex);
+
+    return m_stats;
+}
+
+// NOTE: server doesn't send anything over an idle
+// connection unless it is about to close it (notice of
+// disconnection) or has already closed it (EOF). So if
+// socket of an idle handle is readable or has an error,
+// handle is dead. This check doesn't require a round trip.
+bool AdConnectionPool::connection_is_alive(LDAP *ld) {
+    int fd = -1;
+    const int get_result = ldap_get_option(ld, LDAP_OPT_DESC, &fd);
+    if (get_result != LDAP_OPT_SUCCESS || fd < 0) {
+        return false;
+    }
+
+    struct pollfd poll_fd;
+    poll_fd.fd = fd;
+    poll_fd.events = POLLIN;
+    poll_fd.revents = 0;
+
+    const int poll_result = poll(&poll_fd, 1, 0);
+    if (poll_result < 0) {
+        return false;
+    }
+
+    const bool has_pending_event = ((poll_fd.revents & (POLLIN | POLLHUP | POLLERR | POLLNVAL)) != 0);
+
+    return !has_pending_event;
+}
+
+void AdConnectionPool::unbind(LDAP *ld) {
+    ldap_unbind_ext(ld, NULL, NULL);
+}
@@ -0,0 +1,120 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AD_CONNECTION_POOL_H
+#define AD_CONNECTION_POOL_H
+
+/**
+ * Process-wide pool of bound LDAP handles. AdInterface
+ * leases a handle from the pool on construction and returns
+ * it on destruction, so that short-lived AdInterface's
+ * don't have to discover DC's and perform a full SASL bind
+ * every time. Handles are keyed by DC. Changing any
+ * connection option (DC, port, credentials, etc.)
+ * invalidates the pool, after which all handles that are
+ * currently leased are unbound on release instead of being
+ * returned to the pool.
+ */
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+typedef struct ldap LDAP;
+
+struct AdConnectionPoolStats {
+    // Leases served by an idle handle from the pool
+    int hits = 0;
+    // Leases that had to create a new handle
+    int misses = 0;
+    // Successful and failed SASL binds
+    int binds = 0;
+    int bind_failures = 0;
+    // Idle handles that were dropped because they failed
+    // health check, expired or were invalidated
+    int discarded = 0;
+    int idle_count = 0;
+    int leased_count = 0;
+    // Total time spent inside acquire() and total time
+    // spent binding new handles
+    qint64 wait_time_ms = 0;
+    qint64 bind_time_ms = 0;
+};
+
+class AdConnectionPool final {
+
+public:
+    static AdConnectionPool *instance();
+
+    ~AdConnectionPool();
+
+    AdConnectionPool(const AdConnectionPool &) = delete;
+    AdConnectionPool &operator=(const AdConnectionPool &) = delete;
+
+    // Returns an idle bound handle for given DC or NULL if
+    // there are none. "client_user_out" is set to the user
+    // that the handle was bound as. "generation_out" must
+    // be passed back to release().
+    LDAP *acquire(const QString &dc, QString *client_user_out, int *generation_out);
+
+    // Returns handle to the pool. Handle is unbound
+    // instead if it is not reusable, if pool was
+    // invalidated after handle was leased or if pool is
+    // full.
+    void release(LDAP *ld, const QString &dc, const QString &client_user, const int generation, const bool reusable);
+
+    // Call this when a new handle was bound outside of
+    // acquire(), so that it is counted as leased
+    void add_leased(const qint64 bind_time_ms, const bool bind_success);
+
+    // Drops all idle handles and makes handles that are
+    // currently leased non-reusable. Should be called when
+    // connection options or credentials change.
+    void invalidate();
+
+    int generation() const;
+
+    void set_max_idle_per_dc(const int max_idle);
+    void set_max_idle_time(const int seconds);
+
+    AdConnectionPoolStats stats() const;
+
+private:
+    struct PooledConnection {
+        LDAP *ld;
+        QString client_user;
+        QElapsedTimer idle_timer;
+    };
+
+    AdConnectionPool();
+
+    mutable QMutex mutex;
+    QHash<QString, QList<PooledConnection>> idle_map;
+    AdConnectionPoolStats m_stats;
+    int m_generation;
+    int max_idle_per_dc;
+    int max_idle_time_ms;
+
+    static bool connection_is_alive(LDAP *ld);
+    static void unbind(LDAP *ld);
+};
+
+#endif /* AD_CONNECTION_POOL_H */
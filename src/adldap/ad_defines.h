@@ -155,9 +155,11 @@ enum SystemFlagsBit {
 #define ATTRIBUTE_VERSION_NUMBER "versionNumber"
 #define ATTRIBUTE_FLAGS "flags"
 #define ATTRIBUTE_OBJECT_GUID "objectGUID"
+#define ATTRIBUTE_IS_DELETED "isDeleted"
 #define ATTRIBUTE_PRIMARY_GROUP_ID "primaryGroupID"
 #define ATTRIBUTE_MANAGER "manager"
 #define ATTRIBUTE_MANAGED_BY "managedBy"
+#define ATTRIBUTE_MANAGED_OBJECTS "managedObjects"
 #define ATTRIBUTE_DIRECT_REPORTS "directReports"
 #define ATTRIBUTE_PROFILE_PATH "profilePath"
 #define ATTRIBUTE_SCRIPT_PATH "scriptPath"
@@ -344,6 +346,11 @@ enum SystemFlagsBit {
 const long long MILLIS_TO_100_NANOS = 10000LL;
 
 #define MATCHING_RULE_IN_CHAIN_OID "1.2.840.113556.1.4.1941"
+#define MATCHING_RULE_BIT_AND_OID "1.2.840.113556.1.4.803"
+#define MATCHING_RULE_BIT_OR_OID "1.2.840.113556.1.4.804"
+
+#define LDAP_SERVER_NOTIFICATION_OID "1.2.840.113556.1.4.528"
+#define LDAP_SERVER_SHOW_DELETED_OID "1.2.840.113556.1.4.417"
 
 #define LDAP_SERVER_SD_FLAGS_OID "1.2.840.113556.1.4.801"
 #define OWNER_SECURITY_INFORMATION 0x01
@@ -30,7 +30,9 @@
 #include <QDateTime>
 #include <QList>
 #include <QString>
+#include <QVariant>
 #include <algorithm>
+#include <limits>
 
 const qint64 SECONDS_TO_MILLIS = 1000LL;
 const qint64 MINUTES_TO_SECONDS = 60LL;
@@ -100,6 +102,66 @@ QString attribute_display_value(const QString &attribute, const QByteArray &valu
     }
 }
 
+QVariant attribute_sort_value(const QString &attribute, const QByteArray &value, const AdConfig *adconfig) {
+    if (adconfig == nullptr) {
+        return QVariant();
+    }
+
+    const AttributeType type = adconfig->get_attribute_type(attribute);
+
+    switch (type) {
+        case AttributeType_Integer: {
+            // NOTE: flag attributes are displayed as
+            // decoded strings, sort them by those strings
+            const bool has_special_display = (attribute == ATTRIBUTE_SAM_ACCOUNT_TYPE || attribute == ATTRIBUTE_PRIMARY_GROUP_ID ||
+                                              attribute == ATTRIBUTE_MSDS_USER_ACCOUNT_CONTROL_COMPUTED || attribute_value_is_hex_displayed(attribute));
+            if (has_special_display) {
+                return QVariant();
+            }
+
+            bool ok;
+            const qlonglong out = value.toLongLong(&ok);
+            if (!ok) {
+                return QVariant();
+            }
+
+            return QVariant(out);
+        }
+        case AttributeType_LargeInteger: {
+            bool ok;
+            const qlonglong raw = value.toLongLong(&ok);
+            if (!ok) {
+                return QVariant();
+            }
+
+            // NOTE: timespans are stored as negative
+            // values but displayed as positive ones
+            const LargeIntegerSubtype subtype = adconfig->get_attribute_large_integer_subtype(attribute);
+            if (subtype == LargeIntegerSubtype_Timespan) {
+                if (raw == std::numeric_limits<qlonglong>::min()) {
+                    return QVariant(std::numeric_limits<qlonglong>::max());
+                }
+
+                return QVariant(-raw);
+            }
+
+            return QVariant(raw);
+        }
+        case AttributeType_UTCTime:
+        case AttributeType_GeneralizedTime: {
+            const QDateTime datetime = datetime_string_to_qdatetime(attribute, QString(value), adconfig);
+            if (!datetime.isValid()) {
+                return QVariant();
+            }
+
+            return QVariant(datetime);
+        }
+        default: {
+            return QVariant();
+        }
+    }
+}
+
 QString attribute_display_values(const QString &attribute, const QList<QByteArray> &values, const AdConfig *adconfig) {
     if (values.isEmpty()) {
         return QCoreApplication::translate("attribute_display", "<unset>");
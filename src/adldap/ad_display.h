@@ -29,6 +29,7 @@
 class AdConfig;
 class QString;
 class QByteArray;
+class QVariant;
 template <typename T>
 class QList;
 
@@ -37,4 +38,11 @@ QString attribute_display_values(const QString &attribute, const QList<QByteArra
 QString object_sid_display_value(const QByteArray &sid_bytes);
 bool attribute_value_is_hex_displayed(const QString &attribute);
 
+// Returns value that should be used for sorting instead of
+// display value. Numbers and datetimes are returned as
+// typed values, so that they are ordered by value and not
+// by their formatted strings. Returns an invalid variant
+// for attributes which should be sorted by display value.
+QVariant attribute_sort_value(const QString &attribute, const QByteArray &value, const AdConfig *adconfig);
+
 #endif /* ATTRIBUTE_DISPLAY_H */
@@ -0,0 +1,993 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ad_filter_matcher.h"
+
+#include "ad_config.h"
+#include "ad_defines.h"
+#include "ad_object.h"
+
+#include <algorithm>
+#include <limits>
+
+// NOTE: protects against stack overflow from malformed
+// filters like "(!(!(!(!...". Real filters are much
+// shallower.
+#define MAX_FILTER_DEPTH 100
+
+enum AdFilterNodeType {
+    AdFilterNodeType_And,
+    AdFilterNodeType_Or,
+    AdFilterNodeType_Not,
+    AdFilterNodeType_Equality,
+    AdFilterNodeType_Approx,
+    AdFilterNodeType_GreaterOrEqual,
+    AdFilterNodeType_LessOrEqual,
+    AdFilterNodeType_Present,
+    AdFilterNodeType_Substring,
+    AdFilterNodeType_Extensible,
+};
+
+// How values of an attribute are compared, depends on
+// attribute syntax
+enum CompareType {
+    CompareType_CaseIgnore,
+    CompareType_CaseExact,
+    CompareType_Integer,
+    CompareType_Binary,
+};
+
+struct AdFilterNode {
+    AdFilterNodeType type;
+
+    // For AND, OR and NOT
+    QList<QSharedPointer<AdFilterNode>> children;
+
+    // For items
+    QString attribute;
+    QByteArray value;
+
+    // For substrings, "initial*any_1*any_2*final"
+    QByteArray initial_part;
+    QList<QByteArray> any_list;
+    QByteArray final_part;
+
+    // True if whole assertion value is given as escaped
+    // bytes, like "\01\05\00...". Values of binary
+    // attributes can only be compared locally in this form.
+    bool value_is_escaped_binary = false;
+
+    // For extensible match
+    QString matching_rule;
+    bool dn_attributes = false;
+
+    // False if node can't be evaluated without a server,
+    // like "in chain" matching rule
+    bool is_local = true;
+};
+
+typedef QSharedPointer<AdFilterNode> AdFilterNodePtr;
+
+AdFilterNodePtr parse_filter(const QString &filter, int *pos, const int depth);
+AdFilterNodePtr parse_item(const QStringView &item);
+bool parse_value(const QStringView &raw, QByteArray *out);
+bool attribute_is_valid(const QStringView &attribute);
+void skip_space(const QString &filter, int *pos);
+QString node_to_string(const AdFilterNode &node);
+QString value_to_string(const QByteArray &value);
+bool node_matches(const AdFilterNode &node, const AdObject &object, const AdConfig *adconfig);
+bool node_can_match_locally(const AdFilterNode &node, const QList<QString> &loaded_attributes, const AdConfig *adconfig);
+bool node_value_needs_server(const AdFilterNode &node, const QString &attribute, const AdConfig *adconfig);
+bool value_is_escaped(const QStringView &raw);
+bool attribute_is_time(const QString &attribute, const AdConfig *adconfig);
+bool node_implies(const AdFilterNode &a, const AdFilterNode &b);
+QList<QByteArray> get_values_case_insensitive(const AdObject &object, const QString &attribute, QString *attribute_case_out);
+CompareType get_compare_type(const QString &attribute, const AdConfig *adconfig);
+bool compare_values(const QByteArray &value, const QByteArray &assertion, const CompareType type, int *result_out);
+bool substring_matches(const AdFilterNode &node, const QByteArray &value, const CompareType type);
+bool bitwise_matches(const QByteArray &value, const QByteArray &assertion, const QString &matching_rule);
+
+AdFilterMatcher::AdFilterMatcher()
+: adconfig(nullptr) {
+    // NOTE: empty filter matches everything, same as
+    // empty AND
+    auto node = AdFilterNodePtr::create();
+    node->type = AdFilterNodeType_And;
+
+    root = node;
+}
+
+AdFilterMatcher::AdFilterMatcher(const QString &filter_arg, const AdConfig *adconfig_arg)
+: adconfig(adconfig_arg) {
+    const QString filter = filter_arg.trimmed();
+
+    if (filter.isEmpty()) {
+        auto node = AdFilterNodePtr::create();
+        node->type = AdFilterNodeType_And;
+
+        root = node;
+
+        return;
+    }
+
+    // NOTE: outer parentheses are optional, server
+    // accepts "cn=foo" as well as "(cn=foo)"
+    const QString filter_with_parens = [&]() {
+        if (filter.startsWith('(')) {
+            return filter;
+        } else {
+            return QString("(%1)").arg(filter);
+        }
+    }();
+
+    int pos = 0;
+    const AdFilterNodePtr node = parse_filter(filter_with_parens, &pos, 0);
+
+    skip_space(filter_with_parens, &pos);
+    const bool has_trailing_garbage = (pos != filter_with_parens.size());
+
+    if (node != nullptr && !has_trailing_garbage) {
+        root = node;
+    }
+}
+
+bool AdFilterMatcher::is_valid() const {
+    return (root != nullptr);
+}
+
+bool AdFilterMatcher::matches(const AdObject &object) const {
+    if (root == nullptr) {
+        return false;
+    }
+
+    return node_matches(*root, object, adconfig);
+}
+
+bool AdFilterMatcher::can_match_locally(const QList<QString> &loaded_attributes) const {
+    if (root == nullptr) {
+        return false;
+    }
+
+    return node_can_match_locally(*root, loaded_attributes, adconfig);
+}
+
+bool AdFilterMatcher::is_narrowing_of(const AdFilterMatcher &other) const {
+    if (root == nullptr || other.root == nullptr) {
+        return false;
+    }
+
+    return node_implies(*root, *other.root);
+}
+
+QString AdFilterMatcher::to_string() const {
+    if (root == nullptr) {
+        return QString();
+    }
+
+    return node_to_string(*root);
+}
+
+// filter = "(" filtercomp ")"
+// filtercomp = and / or / not / item
+AdFilterNodePtr parse_filter(const QString &filter, int *pos, const int depth) {
+    if (depth > MAX_FILTER_DEPTH) {
+        return nullptr;
+    }
+
+    skip_space(filter, pos);
+
+    if (*pos >= filter.size() || filter[*pos] != '(') {
+        return nullptr;
+    }
+    (*pos)++;
+
+    skip_space(filter, pos);
+
+    if (*pos >= filter.size()) {
+        return nullptr;
+    }
+
+    const QChar op = filter[*pos];
+
+    AdFilterNodePtr node;
+
+    if (op == '&' || op == '|') {
+        (*pos)++;
+
+        node = AdFilterNodePtr::create();
+        node->type = (op == '&') ? AdFilterNodeType_And : AdFilterNodeType_Or;
+
+        // NOTE: empty AND and OR are allowed (RFC 4526),
+        // they are absolute true and false
+        while (true) {
+            skip_space(filter, pos);
+
+            if (*pos >= filter.size()) {
+                return nullptr;
+            }
+
+            if (filter[*pos] == ')') {
+                break;
+            }
+
+            const AdFilterNodePtr child = parse_filter(filter, pos, depth + 1);
+            if (child == nullptr) {
+                return nullptr;
+            }
+
+            node->children.append(child);
+        }
+    } else if (op == '!') {
+        (*pos)++;
+
+        const AdFilterNodePtr child = parse_filter(filter, pos, depth + 1);
+        if (child == nullptr) {
+            return nullptr;
+        }
+
+        node = AdFilterNodePtr::create();
+        node->type = AdFilterNodeType_Not;
+        node->children.append(child);
+    } else {
+        // NOTE: values can't contain unescaped
+        // parentheses, so item ends at next ")"
+        const int item_end = filter.indexOf(')', *pos);
+        if (item_end == -1) {
+            return nullptr;
+        }
+
+        const QStringView item = QStringView(filter).mid(*pos, item_end - *pos);
+        node = parse_item(item);
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        *pos = item_end;
+    }
+
+    skip_space(filter, pos);
+
+    if (*pos >= filter.size() || filter[*pos] != ')') {
+        return nullptr;
+    }
+    (*pos)++;
+
+    return node;
+}
+
+// item = attr ("=" / "~=" / ">=" / "<=") value
+//      / attr "=*"
+//      / attr "=" [initial] "*" *(any "*") [final]
+//      / [attr] [":dn"] [":" matchingrule] ":=" value
+AdFilterNodePtr parse_item(const QStringView &item) {
+    const int equals_index = item.indexOf('=');
+    if (equals_index < 1) {
+        return nullptr;
+    }
+
+    auto node = AdFilterNodePtr::create();
+
+    const QChar op = item[equals_index - 1];
+    const QStringView value_raw = item.mid(equals_index + 1);
+
+    const QStringView attribute = [&]() {
+        const bool is_two_char_op = (op == '~' || op == '>' || op == '<' || op == ':');
+
+        if (is_two_char_op) {
+            return item.left(equals_index - 1);
+        } else {
+            return item.left(equals_index);
+        }
+    }();
+
+    if (op == ':') {
+        // "attr:dn:rule" => {"attr", "dn", "rule"}
+        const QList<QStringView> part_list = attribute.split(':');
+
+        node->type = AdFilterNodeType_Extensible;
+        node->attribute = part_list[0].toString();
+
+        for (int i = 1; i < part_list.size(); i++) {
+            const QStringView part = part_list[i];
+
+            if (part.compare(u"dn", Qt::CaseInsensitive) == 0 && i == 1) {
+                node->dn_attributes = true;
+            } else if (!part.isEmpty() && node->matching_rule.isEmpty()) {
+                node->matching_rule = part.toString();
+            } else {
+                return nullptr;
+            }
+        }
+
+        const bool has_attribute = !node->attribute.isEmpty();
+        if (!has_attribute && node->matching_rule.isEmpty()) {
+            return nullptr;
+        }
+
+        if (has_attribute && !attribute_is_valid(node->attribute)) {
+            return nullptr;
+        }
+
+        if (!parse_value(value_raw, &node->value)) {
+            return nullptr;
+        }
+
+        node->value_is_escaped_binary = value_is_escaped(value_raw);
+
+        // NOTE: only bitwise matching rules and the
+        // default equality rule are evaluated locally.
+        // Others, like "in chain", need the server.
+        const bool rule_is_local = (node->matching_rule.isEmpty() || node->matching_rule == MATCHING_RULE_BIT_AND_OID || node->matching_rule == MATCHING_RULE_BIT_OR_OID);
+        node->is_local = (has_attribute && !node->dn_attributes && rule_is_local);
+
+        return node;
+    }
+
+    if (!attribute_is_valid(attribute)) {
+        return nullptr;
+    }
+
+    node->attribute = attribute.toString();
+
+    if (op == '~') {
+        node->type = AdFilterNodeType_Approx;
+    } else if (op == '>') {
+        node->type = AdFilterNodeType_GreaterOrEqual;
+    } else if (op == '<') {
+        node->type = AdFilterNodeType_LessOrEqual;
+    } else if (value_raw == u"*") {
+        node->type = AdFilterNodeType_Present;
+
+        return node;
+    } else if (value_raw.contains('*')) {
+        node->type = AdFilterNodeType_Substring;
+
+        // NOTE: escaped asterisks are "\2a", so all
+        // asterisks here are wildcards
+        const QList<QStringView> part_list = value_raw.split('*');
+
+        node->value_is_escaped_binary = std::all_of(part_list.begin(), part_list.end(), [](const QStringView &part) {
+            return (part.isEmpty() || value_is_escaped(part));
+        });
+
+        for (int i = 0; i < part_list.size(); i++) {
+            QByteArray part;
+            if (!parse_value(part_list[i], &part)) {
+                return nullptr;
+            }
+
+            if (i == 0) {
+                node->initial_part = part;
+            } else if (i == part_list.size() - 1) {
+                node->final_part = part;
+            } else if (!part.isEmpty()) {
+                node->any_list.append(part);
+            }
+        }
+
+        return node;
+    } else {
+        node->type = AdFilterNodeType_Equality;
+    }
+
+    if (!parse_value(value_raw, &node->value)) {
+        return nullptr;
+    }
+
+    node->value_is_escaped_binary = value_is_escaped(value_raw);
+
+    // NOTE: server maps "(objectCategory=person)" to the
+    // default object category of the class, which is
+    // not known here
+    const bool is_category_shorthand = (node->attribute.compare(ATTRIBUTE_OBJECT_CATEGORY, Qt::CaseInsensitive) == 0 && !node->value.contains('='));
+    if (is_category_shorthand) {
+        node->is_local = false;
+    }
+
+    return node;
+}
+
+// Unescapes "\XX" sequences. Result is UTF-8.
+bool parse_value(const QStringView &raw, QByteArray *out) {
+    out->clear();
+
+    int run_start = 0;
+
+    for (int i = 0; i < raw.size(); i++) {
+        const QChar c = raw[i];
+
+        if (c == '(' || c == ')' || c == '*') {
+            return false;
+        }
+
+        if (c != '\\') {
+            continue;
+        }
+
+        out->append(raw.mid(run_start, i - run_start).toUtf8());
+
+        if (i + 2 >= raw.size()) {
+            return false;
+        }
+
+        const QStringView hex = raw.mid(i + 1, 2);
+        const bool hex_is_valid = std::all_of(hex.begin(), hex.end(), [](const QChar &hex_char) {
+            const QChar lower = hex_char.toLower();
+
+            return ((lower >= '0' && lower <= '9') || (lower >= 'a' && lower <= 'f'));
+        });
+        if (!hex_is_valid) {
+            return false;
+        }
+
+        const int byte = hex.toInt(nullptr, 16);
+        out->append((char) byte);
+
+        i += 2;
+        run_start = i + 1;
+    }
+
+    out->append(raw.mid(run_start).toUtf8());
+
+    return true;
+}
+
+// Returns true if value consists only of "\XX" sequences
+bool value_is_escaped(const QStringView &raw) {
+    if (raw.isEmpty() || raw.size() % 3 != 0) {
+        return false;
+    }
+
+    for (int i = 0; i < raw.size(); i += 3) {
+        if (raw[i] != '\\') {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// NOTE: attribute descriptions can be a name or an OID
+// and may contain options, like "member;range=0-10"
+bool attribute_is_valid(const QStringView &attribute) {
+    if (attribute.isEmpty()) {
+        return false;
+    }
+
+    for (const QChar c : attribute) {
+        const bool c_is_valid = (c.isLetterOrNumber() || c == '-' || c == '.' || c == ';');
+        if (!c_is_valid) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void skip_space(const QString &filter, int *pos) {
+    while (*pos < filter.size() && filter[*pos].isSpace()) {
+        (*pos)++;
+    }
+}
+
+QString node_to_string(const AdFilterNode &node) {
+    const QString attribute = node.attribute.toLower();
+
+    switch (node.type) {
+        case AdFilterNodeType_And:
+        case AdFilterNodeType_Or:
+        case AdFilterNodeType_Not: {
+            const QString op = [&]() {
+                switch (node.type) {
+                    case AdFilterNodeType_And: return "&";
+                    case AdFilterNodeType_Or: return "|";
+                    default: return "!";
+                }
+            }();
+
+            QString out = "(" + op;
+            for (const AdFilterNodePtr &child : node.children) {
+                out += node_to_string(*child);
+            }
+            out += ")";
+
+            return out;
+        }
+        case AdFilterNodeType_Equality: return QString("(%1=%2)").arg(attribute, value_to_string(node.value));
+        case AdFilterNodeType_Approx: return QString("(%1~=%2)").arg(attribute, value_to_string(node.value));
+        case AdFilterNodeType_GreaterOrEqual: return QString("(%1>=%2)").arg(attribute, value_to_string(node.value));
+        case AdFilterNodeType_LessOrEqual: return QString("(%1<=%2)").arg(attribute, value_to_string(node.value));
+        case AdFilterNodeType_Present: return QString("(%1=*)").arg(attribute);
+        case AdFilterNodeType_Substring: {
+            QString out = QString("(%1=").arg(attribute);
+            out += value_to_string(node.initial_part) + "*";
+            for (const QByteArray &any : node.any_list) {
+                out += value_to_string(any) + "*";
+            }
+            out += value_to_string(node.final_part) + ")";
+
+            return out;
+        }
+        case AdFilterNodeType_Extensible: {
+            QString out = "(" + attribute;
+            if (node.dn_attributes) {
+                out += ":dn";
+            }
+            if (!node.matching_rule.isEmpty()) {
+                out += ":" + node.matching_rule.toLower();
+            }
+            out += ":=" + value_to_string(node.value) + ")";
+
+            return out;
+        }
+    }
+
+    return QString();
+}
+
+// Escapes special characters and bytes that are not
+// printable ASCII
+QString value_to_string(const QByteArray &value) {
+    QString out;
+
+    for (const char c : value) {
+        const unsigned char byte = (unsigned char) c;
+        const bool need_escape = (byte < 0x20 || byte >= 0x7f || c == '*' || c == '(' || c == ')' || c == '\\');
+
+        if (need_escape) {
+            out += QString("\\%1").arg(byte, 2, 16, QChar('0'));
+        } else {
+            out += QChar(c);
+        }
+    }
+
+    return out;
+}
+
+bool node_matches(const AdFilterNode &node, const AdObject &object, const AdConfig *adconfig) {
+    switch (node.type) {
+        case AdFilterNodeType_And: {
+            for (const AdFilterNodePtr &child : node.children) {
+                if (!node_matches(*child, object, adconfig)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+        case AdFilterNodeType_Or: {
+            for (const AdFilterNodePtr &child : node.children) {
+                if (node_matches(*child, object, adconfig)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+        case AdFilterNodeType_Not: {
+            return !node_matches(*node.children[0], object, adconfig);
+        }
+        default: break;
+    }
+
+    if (!node.is_local) {
+        return false;
+    }
+
+    // NOTE: every object has objectClass, even if it
+    // wasn't loaded
+    const bool is_object_class_present = (node.type == AdFilterNodeType_Present && node.attribute.compare(ATTRIBUTE_OBJECT_CLASS, Qt::CaseInsensitive) == 0);
+    if (is_object_class_present) {
+        return true;
+    }
+
+    QString attribute_case;
+    const QList<QByteArray> value_list = get_values_case_insensitive(object, node.attribute, &attribute_case);
+
+    if (node.type == AdFilterNodeType_Present) {
+        return !value_list.isEmpty();
+    }
+
+    if (node_value_needs_server(node, attribute_case, adconfig)) {
+        return false;
+    }
+
+    const CompareType compare_type = get_compare_type(attribute_case, adconfig);
+
+    for (const QByteArray &value : value_list) {
+        const bool value_matches = [&]() {
+            switch (node.type) {
+                case AdFilterNodeType_Equality: {
+                    int result;
+                    const bool ok = compare_values(value, node.value, compare_type, &result);
+
+                    return (ok && result == 0);
+                }
+                case AdFilterNodeType_Approx: {
+                    // NOTE: approximate match is up to the
+                    // server, use case-insensitive equality
+                    const CompareType approx_type = (compare_type == CompareType_CaseExact) ? CompareType_CaseIgnore : compare_type;
+
+                    int result;
+                    const bool ok = compare_values(value, node.value, approx_type, &result);
+
+                    return (ok && result == 0);
+                }
+                case AdFilterNodeType_GreaterOrEqual: {
+                    int result;
+                    const bool ok = compare_values(value, node.value, compare_type, &result);
+
+                    return (ok && result >= 0);
+                }
+                case AdFilterNodeType_LessOrEqual: {
+                    int result;
+                    const bool ok = compare_values(value, node.value, compare_type, &result);
+
+                    return (ok && result <= 0);
+                }
+                case AdFilterNodeType_Substring: {
+                    return substring_matches(node, value, compare_type);
+                }
+                case AdFilterNodeType_Extensible: {
+                    if (node.matching_rule.isEmpty()) {
+                        int result;
+                        const bool ok = compare_values(value, node.value, compare_type, &result);
+
+                        return (ok && result == 0);
+                    } else {
+                        return bitwise_matches(value, node.value, node.matching_rule);
+                    }
+                }
+                default: return false;
+            }
+        }();
+
+        if (value_matches) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool node_can_match_locally(const AdFilterNode &node, const QList<QString> &loaded_attributes, const AdConfig *adconfig) {
+    switch (node.type) {
+        case AdFilterNodeType_And:
+        case AdFilterNodeType_Or:
+        case AdFilterNodeType_Not: {
+            for (const AdFilterNodePtr &child : node.children) {
+                if (!node_can_match_locally(*child, loaded_attributes, adconfig)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+        default: break;
+    }
+
+    if (!node.is_local) {
+        return false;
+    }
+
+    if (node_value_needs_server(node, node.attribute, adconfig)) {
+        return false;
+    }
+
+    if (loaded_attributes.isEmpty()) {
+        return true;
+    }
+
+    const bool is_object_class_present = (node.type == AdFilterNodeType_Present && node.attribute.compare(ATTRIBUTE_OBJECT_CLASS, Qt::CaseInsensitive) == 0);
+    if (is_object_class_present) {
+        return true;
+    }
+
+    // NOTE: "*" requests all attributes
+    for (const QString &attribute : loaded_attributes) {
+        const bool is_loaded = (attribute == "*" || attribute.compare(node.attribute, Qt::CaseInsensitive) == 0);
+
+        if (is_loaded) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Returns true if every object matched by "a" is also
+// matched by "b". Each rule here is sound, but the check
+// as a whole is not complete.
+bool node_implies(const AdFilterNode &a, const AdFilterNode &b) {
+    if (node_to_string(a) == node_to_string(b)) {
+        return true;
+    }
+
+    // a => (b1 & b2 & ...) if a => each bi. Note that
+    // this also covers the empty filter.
+    if (b.type == AdFilterNodeType_And) {
+        for (const AdFilterNodePtr &b_child : b.children) {
+            if (!node_implies(a, *b_child)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // (a1 | a2 | ...) => b if each ai => b
+    if (a.type == AdFilterNodeType_Or) {
+        for (const AdFilterNodePtr &a_child : a.children) {
+            if (!node_implies(*a_child, b)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // (a1 & a2 & ...) => b if any ai => b
+    if (a.type == AdFilterNodeType_And) {
+        for (const AdFilterNodePtr &a_child : a.children) {
+            if (node_implies(*a_child, b)) {
+                return true;
+            }
+        }
+    }
+
+    // a => (b1 | b2 | ...) if a => any bi
+    if (b.type == AdFilterNodeType_Or) {
+        for (const AdFilterNodePtr &b_child : b.children) {
+            if (node_implies(a, *b_child)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// NOTE: attribute names in filters are case-insensitive
+// but object stores them in the case returned by server
+QList<QByteArray> get_values_case_insensitive(const AdObject &object, const QString &attribute, QString *attribute_case_out) {
+    if (object.contains(attribute)) {
+        *attribute_case_out = attribute;
+
+        return object.get_values(attribute);
+    }
+
+    for (const QString &object_attribute : object.attributes()) {
+        if (object_attribute.compare(attribute, Qt::CaseInsensitive) == 0) {
+            *attribute_case_out = object_attribute;
+
+            return object.get_values(object_attribute);
+        }
+    }
+
+    *attribute_case_out = attribute;
+
+    return QList<QByteArray>();
+}
+
+// NOTE: server also accepts some binary values in string
+// form, for example "(objectSid=S-1-5-21-...)". Such values
+// can't be compared to raw values locally.
+bool node_value_needs_server(const AdFilterNode &node, const QString &attribute, const AdConfig *adconfig) {
+    if (node.type == AdFilterNodeType_Present) {
+        return false;
+    }
+
+    // NOTE: same time can be written in multiple forms,
+    // for example "20240101000000Z" and
+    // "20240101000000.0Z", so times can't be compared as
+    // strings
+    if (attribute_is_time(attribute, adconfig)) {
+        return true;
+    }
+
+    const bool is_binary = (get_compare_type(attribute, adconfig) == CompareType_Binary);
+
+    return (is_binary && !node.value_is_escaped_binary);
+}
+
+bool attribute_is_time(const QString &attribute, const AdConfig *adconfig) {
+    // NOTE: these are known to be times even if schema is
+    // not available
+    static const QList<QString> time_attribute_list = {
+        ATTRIBUTE_WHEN_CREATED,
+        ATTRIBUTE_WHEN_CHANGED,
+    };
+    for (const QString &time_attribute : time_attribute_list) {
+        if (attribute.compare(time_attribute, Qt::CaseInsensitive) == 0) {
+            return true;
+        }
+    }
+
+    if (adconfig == nullptr) {
+        return false;
+    }
+
+    const AttributeType type = adconfig->get_attribute_type(attribute);
+
+    return (type == AttributeType_UTCTime || type == AttributeType_GeneralizedTime);
+}
+
+CompareType get_compare_type(const QString &attribute, const AdConfig *adconfig) {
+    // NOTE: these are known to be binary even if schema
+    // is not available
+    static const QList<QString> binary_attribute_list = {
+        ATTRIBUTE_OBJECT_SID,
+        ATTRIBUTE_OBJECT_GUID,
+    };
+    for (const QString &binary_attribute : binary_attribute_list) {
+        if (attribute.compare(binary_attribute, Qt::CaseInsensitive) == 0) {
+            return CompareType_Binary;
+        }
+    }
+
+    if (adconfig == nullptr) {
+        return CompareType_CaseIgnore;
+    }
+
+    const AttributeType type = adconfig->get_attribute_type(attribute);
+
+    switch (type) {
+        case AttributeType_Integer: return CompareType_Integer;
+        case AttributeType_LargeInteger: return CompareType_Integer;
+        case AttributeType_Enumeration: return CompareType_Integer;
+        case AttributeType_StringCase: return CompareType_CaseExact;
+        case AttributeType_IA5: return CompareType_CaseExact;
+        case AttributeType_Printable: return CompareType_CaseExact;
+        case AttributeType_NTSecDesc: return CompareType_Binary;
+        case AttributeType_Octet: return CompareType_Binary;
+        case AttributeType_ReplicaLink: return CompareType_Binary;
+        case AttributeType_Sid: return CompareType_Binary;
+        default: return CompareType_CaseIgnore;
+    }
+}
+
+// Sets result to negative, zero or positive if value is
+// less than, equal to or greater than assertion. Returns
+// false if values are not comparable.
+bool compare_values(const QByteArray &value, const QByteArray &assertion, const CompareType type, int *result_out) {
+    switch (type) {
+        case CompareType_Integer: {
+            bool value_ok;
+            bool assertion_ok;
+            const qlonglong value_int = value.toLongLong(&value_ok);
+            const qlonglong assertion_int = assertion.toLongLong(&assertion_ok);
+
+            if (!value_ok || !assertion_ok) {
+                return false;
+            }
+
+            *result_out = (value_int > assertion_int) - (value_int < assertion_int);
+
+            return true;
+        }
+        case CompareType_Binary: {
+            *result_out = value.compare(assertion);
+
+            return true;
+        }
+        case CompareType_CaseExact:
+        case CompareType_CaseIgnore: {
+            const QString value_string = QString::fromUtf8(value);
+            const QString assertion_string = QString::fromUtf8(assertion);
+
+            // NOTE: if syntax is unknown, binary values
+            // can end up here. Compare them as bytes,
+            // because invalid UTF-8 sequences all decode
+            // to the same replacement character.
+            const bool is_binary = (value_string.contains(QChar::ReplacementCharacter) || assertion_string.contains(QChar::ReplacementCharacter));
+            if (is_binary) {
+                *result_out = value.compare(assertion);
+
+                return true;
+            }
+
+            const Qt::CaseSensitivity cs = (type == CompareType_CaseIgnore) ? Qt::CaseInsensitive : Qt::CaseSensitive;
+            *result_out = value_string.compare(assertion_string, cs);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool substring_matches(const AdFilterNode &node, const QByteArray &value, const CompareType type) {
+    if (type == CompareType_Binary) {
+        if (!value.startsWith(node.initial_part)) {
+            return false;
+        }
+
+        qsizetype pos = node.initial_part.size();
+        for (const QByteArray &any : node.any_list) {
+            const qsizetype any_index = value.indexOf(any, pos);
+            if (any_index == -1) {
+                return false;
+            }
+
+            pos = any_index + any.size();
+        }
+
+        return (value.size() - node.final_part.size() >= pos && value.endsWith(node.final_part));
+    }
+
+    const Qt::CaseSensitivity cs = (type == CompareType_CaseIgnore) ? Qt::CaseInsensitive : Qt::CaseSensitive;
+    const QString value_string = QString::fromUtf8(value);
+    const QString initial_part = QString::fromUtf8(node.initial_part);
+    const QString final_part = QString::fromUtf8(node.final_part);
+
+    if (!value_string.startsWith(initial_part, cs)) {
+        return false;
+    }
+
+    qsizetype pos = initial_part.size();
+    for (const QByteArray &any_bytes : node.any_list) {
+        const QString any = QString::fromUtf8(any_bytes);
+
+        const qsizetype any_index = value_string.indexOf(any, pos, cs);
+        if (any_index == -1) {
+            return false;
+        }
+
+        pos = any_index + any.size();
+    }
+
+    return (value_string.size() - final_part.size() >= pos && value_string.endsWith(final_part, cs));
+}
+
+// NOTE: values of attributes like userAccountControl and
+// groupType are signed 32bit integers, while masks in
+// filters are usually unsigned. Values that fit into 32
+// bits are compared as unsigned 32bit, so that both forms
+// give same results.
+bool bitwise_matches(const QByteArray &value, const QByteArray &assertion, const QString &matching_rule) {
+    bool value_ok;
+    bool assertion_ok;
+    const qlonglong value_int = value.toLongLong(&value_ok);
+    const qlonglong assertion_int = assertion.toLongLong(&assertion_ok);
+
+    if (!value_ok || !assertion_ok) {
+        return false;
+    }
+
+    auto to_bits = [](const qlonglong x) -> quint64 {
+        const bool fits_32bit = (x >= std::numeric_limits<qint32>::min() && x <= (qlonglong) std::numeric_limits<quint32>::max());
+
+        if (fits_32bit) {
+            return (quint32) x;
+        } else {
+            return (quint64) x;
+        }
+    };
+
+    const quint64 bits = to_bits(value_int);
+    const quint64 mask = to_bits(assertion_int);
+
+    if (matching_rule == MATCHING_RULE_BIT_AND_OID) {
+        return ((bits & mask) == mask);
+    } else if (matching_rule == MATCHING_RULE_BIT_OR_OID) {
+        return ((bits & mask) != 0);
+    } else {
+        return false;
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AD_FILTER_MATCHER_H
+#define AD_FILTER_MATCHER_H
+
+/**
+ * LDAP filter (RFC 4515) that is parsed into a tree and
+ * can be evaluated against already loaded objects, without
+ * asking the server. Supports AND, OR, NOT, equality,
+ * approximate, ordering, presence, substring and
+ * extensible match with bitwise matching rules. Values are
+ * compared according to attribute syntax from schema, for
+ * example case-insensitively for unicode strings and as
+ * numbers for integers. If no AdConfig is given, all
+ * values are compared as case-insensitive strings.
+ *
+ * Some filters can't be evaluated locally, for example
+ * ones that use the "in chain" matching rule, contain
+ * SID's in string form or compare times. Check can_match_locally() before
+ * using matches().
+ */
+
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+
+class AdObject;
+class AdConfig;
+struct AdFilterNode;
+
+class AdFilterMatcher {
+
+public:
+    AdFilterMatcher();
+    AdFilterMatcher(const QString &filter, const AdConfig *adconfig = nullptr);
+
+    // False if filter failed to parse. Empty filter is
+    // valid and matches all objects.
+    bool is_valid() const;
+
+    bool matches(const AdObject &object) const;
+
+    // Returns true if filter can be evaluated for objects
+    // that were loaded with given attributes. Empty list
+    // means that all attributes were loaded.
+    bool can_match_locally(const QList<QString> &loaded_attributes) const;
+
+    // Returns true if every object matched by this filter
+    // is also matched by "other". This means that results
+    // of "other" can be narrowed down to results of this
+    // filter locally. Check is conservative, it may return
+    // false for some filters that are narrower.
+    bool is_narrowing_of(const AdFilterMatcher &other) const;
+
+    // Filter in normalized form, attribute names are
+    // lowercased and whitespace is removed
+    QString to_string() const;
+
+private:
+    QSharedPointer<const AdFilterNode> root;
+    const AdConfig *adconfig;
+};
+
+#endif /* AD_FILTER_MATCHER_H */
@@ -22,11 +22,14 @@
 #include "ad_interface_p.h"
 
 #include "ad_config.h"
+#include "ad_connection_pool.h"
 #include "ad_display.h"
 #include "ad_object.h"
+#include "ad_object_cache.h"
 #include "ad_security.h"
 #include "ad_utils.h"
 #include "gplink.h"
+#include "gpt_walker.h"
 #include "samba/dom_sid.h"
 #include "samba/gp_manage.h"
 #include "samba/libsmb_xattr.h"
@@ -51,7 +54,12 @@
 #include <uuid/uuid.h>
 
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutexLocker>
+#include <QRandomGenerator>
 #include <QStringEncoder>
+#include <QThreadPool>
 
 // NOTE: LDAP library char* inputs are non-const in the API
 // but are const for practical purposes so we use forced
@@ -63,6 +71,18 @@
 #define UNUSED(x) x
 #endif
 
+// NOTE: this is the default MaxPageSize of AD. Server
+// caps page size at MaxPageSize anyway.
+#define DEFAULT_PAGE_SIZE 1000
+
+// Max number of values in one group membership modify
+// request. Matches default MaxValRange of AD.
+#define MEMBER_MODIFY_CHUNK_SIZE 1500
+
+// How often cancellable searches check their cancel token
+// while waiting for server
+#define SEARCH_CANCEL_POLL_INTERVAL_MILLIS 100
+
 #define MAX_DN_LENGTH 1024
 #define MAX_PASSWORD_LENGTH 255
 #ifndef UUID_STR_LEN
@@ -82,9 +102,42 @@ enum AceMaskFormat {
     AceMaskFormat_Decimal,
 };
 
-QList<QString> query_server_for_hosts(const char *dname);
+struct DcSrvRecord {
+    QString host;
+    int priority;
+    int weight;
+    int ttl;
+};
+
+struct DcCacheEntry {
+    QList<DcSrvRecord> records;
+    // NOTE: hosts in the order selected from records, so that
+    // weighted random selection is done once per lookup
+    QList<QString> hosts;
+    QElapsedTimer age_timer;
+    qint64 ttl_ms;
+    bool is_refreshing;
+};
+
+// NOTE: AD registers SRV records with a TTL of 600 seconds.
+// Minimum protects against records with 0 TTL.
+#define DC_CACHE_MIN_TTL_SECONDS 30
+#define DC_CACHE_STALE_GRACE_MS (60 * 60 * 1000)
+
+// Process-wide cache of DC SRV lookups, keyed by DNS name
+static QHash<QString, DcCacheEntry> dc_cache;
+static int dc_cache_generation = 0;
+static QMutex dc_cache_mutex;
+
+QList<DcSrvRecord> query_server_for_hosts(const char *dname);
+QList<QString> dc_cache_get_hosts(const QString &dname);
+QList<QString> dc_cache_refresh(const QString &dname);
+bool srv_records_are_equal(const QList<DcSrvRecord> &a, const QList<DcSrvRecord> &b);
+QList<QString> srv_records_to_hosts(const QList<DcSrvRecord> &records);
+QString attribute_range_parse(const QString &attribute_with_range, int *next_start);
 int sasl_interact_gssapi(LDAP *ld, unsigned flags, void *indefaults, void *in);
 QString get_gpt_sd_string(const AdObject &gpc_object, const AceMaskFormat format);
+void invalidate_cached_objects(const QString &dn, const QString &attribute, const QList<QByteArray> &values);
 int create_sd_control(bool get_sacl, int is_critical, LDAPControl **ctrlp, bool set_dacl = false);
 
 AdConfig *AdInterfacePrivate::adconfig = nullptr;
@@ -94,6 +147,7 @@ bool AdInterfacePrivate::s_domain_is_default = true;
 QString AdInterfacePrivate::s_custom_domain = QString();
 void *AdInterfacePrivate::s_sasl_nocanon = LDAP_OPT_ON;
 int AdInterfacePrivate::s_port = 0;
+int AdInterfacePrivate::s_page_size = DEFAULT_PAGE_SIZE;
 CertStrategy AdInterfacePrivate::s_cert_strat = CertStrategy_Never;
 SMBContext AdInterfacePrivate::s_smb_context = SMBContext();
 QMutex AdInterfacePrivate::mutex;
@@ -113,6 +167,8 @@ AdInterface::AdInterface() {
     d = new AdInterfacePrivate(this);
 
     d->is_connected = false;
+    d->is_bound = false;
+    d->pool_generation = 0;
 
     d->ld = NULL;
 
@@ -132,6 +188,19 @@ AdInterface::AdInterface() {
     // Connect via LDAP
     //
 
+    // Reuse a bound handle from the pool if there is one
+    // for current DC. This skips DC discovery and bind.
+    if (!AdInterfacePrivate::s_dc.isEmpty() && ldap_lease(AdInterfacePrivate::s_dc)) {
+        if (!d->s_smb_context.is_valid()) {
+            d->error_message(connect_error_context, tr("Failed to initialize SMB context."));
+            return;
+        }
+
+        d->is_connected = true;
+
+        return;
+    }
+
     d->dc = [&]() {
         const QList<QString> dc_list = get_domain_hosts(d->domain, QString());
         if (dc_list.isEmpty()) {
@@ -181,8 +250,17 @@ void AdInterface::set_log_searches(const bool enabled) {
     AdInterfacePrivate::s_log_searches = enabled;
 }
 
+void AdInterface::set_page_size(const int page_size) {
+    if (page_size > 0) {
+        AdInterfacePrivate::s_page_size = page_size;
+    } else {
+        AdInterfacePrivate::s_page_size = DEFAULT_PAGE_SIZE;
+    }
+}
+
 void AdInterface::set_dc(const QString &dc) {
     AdInterfacePrivate::s_dc = dc;
+    AdConnectionPool::instance()->invalidate();
 }
 
 void AdInterface::set_sasl_nocanon(const bool is_on) {
@@ -193,23 +271,41 @@ void AdInterface::set_sasl_nocanon(const bool is_on) {
             return LDAP_OPT_OFF;
         }
     }();
+    AdConnectionPool::instance()->invalidate();
 }
 
 void AdInterface::set_port(const int port) {
     AdInterfacePrivate::s_port = port;
+    AdConnectionPool::instance()->invalidate();
 }
 
 void AdInterface::set_cert_strategy(const CertStrategy strategy) {
     AdInterfacePrivate::s_cert_strat = strategy;
+    AdConnectionPool::instance()->invalidate();
 }
 
 void AdInterface::set_domain_is_default(const bool is_default) {
     AdInterfacePrivate::s_domain_is_default = is_default;
+    AdConnectionPool::instance()->invalidate();
 }
 
 void AdInterface::set_custom_domain(const QString &domain)
 {
     AdInterfacePrivate::s_custom_domain = domain;
+    AdConnectionPool::instance()->invalidate();
+}
+
+void AdInterface::reset_connections() {
+    AdConnectionPool::instance()->invalidate();
+    GptWalker::instance()->invalidate();
+
+    // NOTE: different credentials may see different
+    // objects and attributes
+    AdObjectCache::instance()->clear();
+}
+
+AdConnectionPoolStats AdInterface::connection_pool_stats() {
+    return AdConnectionPool::instance()->stats();
 }
 
 AdInterfacePrivate::AdInterfacePrivate(AdInterface *q_arg) {
@@ -250,111 +346,103 @@ QString AdInterface::client_user() const {
 
 // Helper f-n for search()
 // NOTE: cookie is starts as NULL. Then after each while
-// loop, it is set to the value returned by
-// ldap_search_ext_s(). At the end cookie is set back to
-// NULL.
+// loop, it is set to the value returned by the server. At
+// the end cookie is set back to NULL.
+//
+// NOTE: search is asynchronous and pipelined. Entries are
+// collected as they arrive. As soon as the server finishes
+// a page, request for the next page is sent and only then
+// entries of current page are decoded. The request for the
+// next page is stored in the cookie and is picked up by the
+// next call, so the server is producing the next page while
+// the caller processes the current one.
 bool AdInterfacePrivate::search_paged_internal(const char *base, const int scope, const char *filter, char **attributes, QHash<QString, AdObject> *results, AdCookie *cookie, const bool get_sacl) {
     int result;
-    LDAPMessage *res = NULL;
-    LDAPControl *page_control = NULL;
-    LDAPControl *sd_control = NULL;
+    LDAPMessage *done_message = NULL;
+    QList<LDAPMessage *> entry_message_list;
     LDAPControl **returned_controls = NULL;
-    struct berval *prev_cookie = cookie->cookie;
     struct berval *new_cookie = NULL;
 
     auto cleanup = [&]() {
-        ldap_msgfree(res);
-        ldap_control_free(page_control);
-        ldap_control_free(sd_control);
+        ldap_msgfree(done_message);
+        for (LDAPMessage *entry_message : entry_message_list) {
+            ldap_msgfree(entry_message);
+        }
         ldap_controls_free(returned_controls);
-        ber_bvfree(prev_cookie);
         ber_bvfree(new_cookie);
     };
 
-    const int is_critical = 1;
-
-    result = create_sd_control(get_sacl, is_critical, &sd_control);
-    if (result != LDAP_SUCCESS) {
-        qDebug() << "Failed to create sd control: " << ldap_err2string(result);
-
-        cleanup();
-        return false;
-    }
-
-    // Create page control
-    const ber_int_t page_size = 100;
-    result = ldap_create_page_control(ld, page_size, prev_cookie, is_critical, &page_control);
-    if (result != LDAP_SUCCESS) {
-        qDebug() << "Failed to create page control: " << ldap_err2string(result);
-
-        cleanup();
-        return false;
-    }
-    LDAPControl *server_controls[3] = {page_control, sd_control, NULL};
+    const int msgid = [&]() {
+        if (cookie->pending_msgid != -1) {
+            const int out = cookie->pending_msgid;
+            cookie->pending_msgid = -1;
 
-    // Perform search
-    const int attrsonly = 0;
-    result = ldap_search_ext_s(ld, base, scope, filter, attributes, attrsonly, server_controls, NULL, NULL, LDAP_NO_LIMIT, &res);
-
-    if ((result != LDAP_SUCCESS) && (result != LDAP_PARTIAL_RESULTS)) {
-        // NOTE: it's not really an error for an object to
-        // not exist. For example, sometimes it's needed to
-        // check whether an object exists. Not sure how to
-        // distinguish this error type from others
-        if (result != LDAP_NO_SUCH_OBJECT) {
-            qDebug() << "Error in paged ldap_search_ext_s: " << ldap_err2string(result);
+            return out;
+        } else {
+            return search_paged_send(base, scope, filter, attributes, cookie->cookie, get_sacl);
         }
+    }();
 
-        cleanup();
+    // NOTE: previous cookie is not needed after request
+    // was sent
+    ber_bvfree(cookie->cookie);
+    cookie->cookie = NULL;
+
+    if (msgid == -1) {
         return false;
     }
 
-    // Collect results for this search
-    for (LDAPMessage *entry = ldap_first_entry(ld, res); entry != NULL; entry = ldap_next_entry(ld, entry)) {
-        char *dn_cstr = ldap_get_dn(ld, entry);
-        const QString dn(dn_cstr);
-        ldap_memfree(dn_cstr);
-
-        QHash<QString, QList<QByteArray>> object_attributes;
-
-        BerElement *berptr;
-        for (char *attr = ldap_first_attribute(ld, entry, &berptr); attr != NULL; attr = ldap_next_attribute(ld, entry, berptr)) {
-            struct berval **values_ldap = ldap_get_values_len(ld, entry, attr);
-
-            const QList<QByteArray> values_bytes = [=]() {
-                QList<QByteArray> out;
+    // NOTE: if search can be cancelled, wait for messages
+    // in short intervals, so that cancel token is checked
+    // while page is being received
+    struct timeval poll_timeout;
+    poll_timeout.tv_sec = 0;
+    poll_timeout.tv_usec = SEARCH_CANCEL_POLL_INTERVAL_MILLIS * 1000;
+    struct timeval *result_timeout = (cookie->cancel_token != NULL) ? &poll_timeout : NULL;
 
-                if (values_ldap != NULL) {
-                    const int values_count = ldap_count_values_len(values_ldap);
-                    for (int i = 0; i < values_count; i++) {
-                        struct berval value_berval = *values_ldap[i];
-                        const QByteArray value_bytes(value_berval.bv_val, value_berval.bv_len);
+    // Collect messages until the end of page
+    while (true) {
+        if (cookie->is_cancelled()) {
+            // NOTE: abandon the request so that server stops
+            // sending entries. Cookie was already dropped, so
+            // search can't continue after this.
+            ldap_abandon_ext(ld, msgid, NULL, NULL);
 
-                        out.append(value_bytes);
-                    }
-                }
+            cleanup();
+            return false;
+        }
 
-                return out;
-            }();
+        LDAPMessage *message = NULL;
+        const int message_type = ldap_result(ld, msgid, LDAP_MSG_ONE, result_timeout, &message);
 
-            const QString attribute(attr);
+        if (message_type == 0 && result_timeout != NULL) {
+            continue;
+        }
 
-            object_attributes[attribute] = values_bytes;
+        if (message_type == -1 || message_type == 0) {
+            qDebug() << "Error in paged ldap_result: " << ldap_err2string(get_ldap_result());
 
-            ldap_value_free_len(values_ldap);
-            ldap_memfree(attr);
+            ldap_msgfree(message);
+            cleanup();
+            return false;
         }
-        ber_free(berptr, 0);
 
-        AdObject object;
-        object.load(dn, object_attributes);
+        if (message_type == LDAP_RES_SEARCH_ENTRY) {
+            entry_message_list.append(message);
+        } else if (message_type == LDAP_RES_SEARCH_RESULT) {
+            done_message = message;
 
-        results->insert(dn, object);
+            break;
+        } else {
+            // NOTE: skip references, referrals are
+            // disabled anyway
+            ldap_msgfree(message);
+        }
     }
 
     // Parse the results to retrieve returned controls
     int errcodep;
-    result = ldap_parse_result(ld, res, &errcodep, NULL, NULL, NULL, &returned_controls, false);
+    result = ldap_parse_result(ld, done_message, &errcodep, NULL, NULL, NULL, &returned_controls, false);
     if (result != LDAP_SUCCESS) {
         qDebug() << "Failed to parse result: " << ldap_err2string(result);
 
@@ -362,6 +450,19 @@ bool AdInterfacePrivate::search_paged_internal(const char *base, const int scope
         return false;
     }
 
+    if ((errcodep != LDAP_SUCCESS) && (errcodep != LDAP_PARTIAL_RESULTS)) {
+        // NOTE: it's not really an error for an object to
+        // not exist. For example, sometimes it's needed to
+        // check whether an object exists. Not sure how to
+        // distinguish this error type from others
+        if (errcodep != LDAP_NO_SUCH_OBJECT) {
+            qDebug() << "Error in paged search: " << ldap_err2string(errcodep);
+        }
+
+        cleanup();
+        return false;
+    }
+
     // Get page response control
     //
     // NOTE: not sure if absence of page response control is
@@ -387,17 +488,243 @@ bool AdInterfacePrivate::search_paged_internal(const char *base, const int scope
         const bool more_pages = (new_cookie->bv_len > 0);
         if (more_pages) {
             cookie->cookie = ber_bvdup(new_cookie);
-        } else {
-            cookie->cookie = NULL;
+
+            // Request next page before decoding current
+            // one. If this fails, next call will send the
+            // request again.
+            cookie->pending_msgid = search_paged_send(base, scope, filter, attributes, cookie->cookie, get_sacl);
+            cookie->ld = ld;
+        }
+    }
+
+    // Decode entries of this page
+    for (LDAPMessage *entry_message : entry_message_list) {
+        for (LDAPMessage *entry = ldap_first_entry(ld, entry_message); entry != NULL; entry = ldap_next_entry(ld, entry)) {
+            load_entry(entry, results);
         }
-    } else {
-        cookie->cookie = NULL;
     }
 
     cleanup();
     return true;
 }
 
+// Sends search request for one page, returns message id
+// or -1 on failure
+int AdInterfacePrivate::search_paged_send(const char *base, const int scope, const char *filter, char **attributes, struct berval *page_cookie, const bool get_sacl) {
+    int result;
+    LDAPControl *page_control = NULL;
+    LDAPControl *sd_control = NULL;
+
+    auto cleanup = [&]() {
+        ldap_control_free(page_control);
+        ldap_control_free(sd_control);
+    };
+
+    const int is_critical = 1;
+
+    result = create_sd_control(get_sacl, is_critical, &sd_control);
+    if (result != LDAP_SUCCESS) {
+        qDebug() << "Failed to create sd control: " << ldap_err2string(result);
+
+        cleanup();
+        return -1;
+    }
+
+    // Create page control
+    const ber_int_t page_size = AdInterfacePrivate::s_page_size;
+    result = ldap_create_page_control(ld, page_size, page_cookie, is_critical, &page_control);
+    if (result != LDAP_SUCCESS) {
+        qDebug() << "Failed to create page control: " << ldap_err2string(result);
+
+        cleanup();
+        return -1;
+    }
+    LDAPControl *server_controls[3] = {page_control, sd_control, NULL};
+
+    // Perform search
+    const int attrsonly = 0;
+    int msgid;
+    result = ldap_search_ext(ld, base, scope, filter, attributes, attrsonly, server_controls, NULL, NULL, LDAP_NO_LIMIT, &msgid);
+    if (result != LDAP_SUCCESS) {
+        qDebug() << "Error in paged ldap_search_ext: " << ldap_err2string(result);
+
+        cleanup();
+        return -1;
+    }
+
+    cleanup();
+    return msgid;
+}
+
+void AdInterfacePrivate::load_entry(LDAPMessage *entry, QHash<QString, AdObject> *results) {
+    char *dn_cstr = ldap_get_dn(ld, entry);
+    const QString dn(dn_cstr);
+    ldap_memfree(dn_cstr);
+
+    QHash<QString, QList<QByteArray>> object_attributes;
+
+    // Attributes that were returned partially, mapped to
+    // start of the remaining range
+    QHash<QString, int> incomplete_range_map;
+
+    BerElement *berptr;
+    for (char *attr = ldap_first_attribute(ld, entry, &berptr); attr != NULL; attr = ldap_next_attribute(ld, entry, berptr)) {
+        struct berval **values_ldap = ldap_get_values_len(ld, entry, attr);
+
+        const QList<QByteArray> values_bytes = [=]() {
+            QList<QByteArray> out;
+
+            if (values_ldap != NULL) {
+                const int values_count = ldap_count_values_len(values_ldap);
+                out.reserve(values_count);
+                for (int i = 0; i < values_count; i++) {
+                    struct berval value_berval = *values_ldap[i];
+                    const QByteArray value_bytes(value_berval.bv_val, value_berval.bv_len);
+
+                    out.append(value_bytes);
+                }
+            }
+
+            return out;
+        }();
+
+        const QString attribute_with_range(attr);
+
+        // NOTE: server returns large multi-valued
+        // attributes in ranges, as "member;range=0-1499".
+        // Save values under plain attribute name and
+        // retrieve remaining ranges later.
+        int next_start;
+        const QString attribute = attribute_range_parse(attribute_with_range, &next_start);
+
+        object_attributes[attribute].append(values_bytes);
+
+        if (next_start != -1) {
+            incomplete_range_map[attribute] = next_start;
+        }
+
+        ldap_value_free_len(values_ldap);
+        ldap_memfree(attr);
+    }
+    ber_free(berptr, 0);
+
+    for (auto it = incomplete_range_map.begin(); it != incomplete_range_map.end(); it++) {
+        const QString &attribute = it.key();
+        int start = it.value();
+
+        QList<QByteArray> &values = object_attributes[attribute];
+
+        while (start != -1) {
+            QList<QByteArray> range_values;
+            const bool range_success = search_attribute_range(dn, attribute, start, &range_values, &start);
+
+            if (!range_success) {
+                qDebug() << "Failed to retrieve range of" << attribute << "for" << dn;
+
+                break;
+            }
+
+            values.append(range_values);
+        }
+    }
+
+    AdObject object;
+    object.load(dn, object_attributes);
+
+    results->insert(dn, object);
+}
+
+bool AdInterfacePrivate::search_attribute_range(const QString &dn, const QString &attribute, const int start, QList<QByteArray> *values, int *next_start, const int range_size) {
+    values->clear();
+    *next_start = -1;
+
+    // NOTE: "*" lets server decide where range ends
+    const QString range_end = [&]() {
+        if (range_size > 0) {
+            return QString::number(start + range_size - 1);
+        } else {
+            return QString("*");
+        }
+    }();
+
+    const QByteArray dn_bytes = dn.toUtf8();
+    QByteArray range_attribute_bytes = QString("%1;range=%2-%3").arg(attribute).arg(start).arg(range_end).toUtf8();
+    char *attributes[2] = {range_attribute_bytes.data(), NULL};
+
+    LDAPMessage *res = NULL;
+    const int attrsonly = 0;
+    const int result = ldap_search_ext_s(ld, dn_bytes.constData(), LDAP_SCOPE_BASE, NULL, attributes, attrsonly, NULL, NULL, NULL, LDAP_NO_LIMIT, &res);
+    if (result != LDAP_SUCCESS) {
+        ldap_msgfree(res);
+
+        return false;
+    }
+
+    LDAPMessage *entry = ldap_first_entry(ld, res);
+    if (entry == NULL) {
+        ldap_msgfree(res);
+
+        return false;
+    }
+
+    BerElement *berptr;
+    for (char *attr = ldap_first_attribute(ld, entry, &berptr); attr != NULL; attr = ldap_next_attribute(ld, entry, berptr)) {
+        int attr_next_start;
+        const QString attr_base = attribute_range_parse(QString(attr), &attr_next_start);
+
+        if (attr_base.compare(attribute, Qt::CaseInsensitive) == 0) {
+            struct berval **values_ldap = ldap_get_values_len(ld, entry, attr);
+
+            if (values_ldap != NULL) {
+                const int values_count = ldap_count_values_len(values_ldap);
+                values->reserve(values_count);
+                for (int i = 0; i < values_count; i++) {
+                    const QByteArray value_bytes(values_ldap[i]->bv_val, values_ldap[i]->bv_len);
+                    values->append(value_bytes);
+                }
+            }
+
+            *next_start = attr_next_start;
+
+            ldap_value_free_len(values_ldap);
+        }
+
+        ldap_memfree(attr);
+    }
+    ber_free(berptr, 0);
+
+    ldap_msgfree(res);
+
+    return true;
+}
+
+// Splits "attribute;range=start-end" into attribute and
+// start of next range. Next start is -1 if this is the last
+// range ("end" is "*") or if there's no range.
+QString attribute_range_parse(const QString &attribute_with_range, int *next_start) {
+    *next_start = -1;
+
+    const int range_index = attribute_with_range.indexOf(";range=", 0, Qt::CaseInsensitive);
+    if (range_index == -1) {
+        return attribute_with_range;
+    }
+
+    const QString attribute = attribute_with_range.left(range_index);
+    const QString range = attribute_with_range.mid(range_index + QString(";range=").length());
+    const QString range_end = range.section('-', 1, 1);
+
+    if (range_end != "*") {
+        bool ok;
+        const int range_end_int = range_end.toInt(&ok);
+
+        if (ok) {
+            *next_start = range_end_int + 1;
+        }
+    }
+
+    return attribute;
+}
+
 QHash<QString, AdObject> AdInterface::search(const QString &base, const SearchScope scope, const QString &filter, const QList<QString> &attributes, const bool get_sacl) {
     AdCookie cookie;
     QHash<QString, AdObject> results;
@@ -496,19 +823,186 @@ bool AdInterface::search_paged(const QString &base, const SearchScope scope, con
     return true;
 }
 
+bool AdInterface::search_attribute_range(const QString &dn, const QString &attribute, const int start, QList<QByteArray> *values, int *next_start, const int range_size) {
+    return d->search_attribute_range(dn, attribute, start, values, next_start, range_size);
+}
+
 AdObject AdInterface::search_object(const QString &dn, const QList<QString> &attributes, const bool get_sacl) {
     const QString base = dn;
     const SearchScope scope = SearchScope_Object;
     const QString filter = QString();
+
+    AdObjectCache *cache = AdObjectCache::instance();
+    const QString cache_key = AdObjectCache::make_key(d->dc, dn, attributes, get_sacl);
+
+    AdObject cached_object;
+    const AdObjectCacheLookup lookup = cache->lookup(cache_key, &cached_object);
+
+    if (lookup == AdObjectCacheLookup_Fresh) {
+        return cached_object;
+    } else if (lookup == AdObjectCacheLookup_Stale) {
+        // NOTE: validate cached object by loading only
+        // uSNChanged, which changes on every modification
+        // of the object
+        const QHash<QString, AdObject> usn_results = search(base, scope, filter, {ATTRIBUTE_USN_CHANGED});
+        const QString usn_changed = usn_results.value(dn).get_string(ATTRIBUTE_USN_CHANGED);
+        const QString cached_usn_changed = cached_object.get_string(ATTRIBUTE_USN_CHANGED);
+
+        if (!usn_changed.isEmpty() && usn_changed == cached_usn_changed) {
+            cache->mark_validated(cache_key);
+
+            return cached_object;
+        }
+    }
+
     const QHash<QString, AdObject> results = search(base, scope, filter, attributes, get_sacl);
 
     if (results.contains(dn)) {
-        return results[dn];
+        const AdObject object = results[dn];
+
+        cache->insert(cache_key, object);
+
+        return object;
     } else {
         return AdObject();
     }
 }
 
+int AdInterface::notification_start(const QString &container, const QList<QString> &attributes) {
+    int result;
+    LDAPControl *notification_control = NULL;
+    LDAPControl *show_deleted_control = NULL;
+
+    auto cleanup = [&]() {
+        ldap_control_free(notification_control);
+        ldap_control_free(show_deleted_control);
+    };
+
+    const int is_critical = 1;
+
+    result = ldap_control_create(LDAP_SERVER_NOTIFICATION_OID, is_critical, NULL, 0, &notification_control);
+    if (result != LDAP_SUCCESS) {
+        qDebug() << "Failed to create notification control: " << ldap_err2string(result);
+
+        cleanup();
+        return -1;
+    }
+
+    // NOTE: without this control, server doesn't notify
+    // about deletions
+    result = ldap_control_create(LDAP_SERVER_SHOW_DELETED_OID, is_critical, NULL, 0, &show_deleted_control);
+    if (result != LDAP_SUCCESS) {
+        qDebug() << "Failed to create show deleted control: " << ldap_err2string(result);
+
+        cleanup();
+        return -1;
+    }
+
+    LDAPControl *server_controls[3] = {notification_control, show_deleted_control, NULL};
+
+    const QByteArray container_bytes = container.toUtf8();
+
+    // Convert attributes list to NULL-terminated array
+    QList<QByteArray> attr_bytearray_list;
+    QList<char *> attributes_array;
+    for (const QString &attribute : attributes) {
+        attr_bytearray_list.append(attribute.toUtf8());
+        attributes_array.append(attr_bytearray_list.last().data());
+    }
+    attributes_array.append(NULL);
+
+    // NOTE: AD only supports base and one level scopes and
+    // this exact filter for notifications
+    const char *filter = "(objectClass=*)";
+    const int attrsonly = 0;
+    int msgid;
+    result = ldap_search_ext(d->ld, container_bytes.constData(), LDAP_SCOPE_ONELEVEL, filter, attributes_array.data(), attrsonly, server_controls, NULL, NULL, LDAP_NO_LIMIT, &msgid);
+    if (result != LDAP_SUCCESS) {
+        qDebug() << "Error in notification ldap_search_ext: " << ldap_err2string(result);
+
+        cleanup();
+        return -1;
+    }
+
+    d->notification_msgid_set.insert(msgid);
+
+    cleanup();
+    return msgid;
+}
+
+void AdInterface::notification_stop(const int notification_id) {
+    if (!d->notification_msgid_set.contains(notification_id)) {
+        return;
+    }
+
+    ldap_abandon_ext(d->ld, notification_id, NULL, NULL);
+
+    d->notification_msgid_set.remove(notification_id);
+}
+
+bool AdInterface::notification_wait(const int timeout_millis, QHash<QString, AdObject> *results) {
+    if (d->notification_msgid_set.isEmpty()) {
+        return true;
+    }
+
+    struct timeval timeout;
+    timeout.tv_sec = timeout_millis / 1000;
+    timeout.tv_usec = (timeout_millis % 1000) * 1000;
+
+    QList<QString> changed_dn_list;
+
+    const bool out = [&]() {
+        while (true) {
+            LDAPMessage *message = NULL;
+            const int message_type = ldap_result(d->ld, LDAP_RES_ANY, LDAP_MSG_ONE, &timeout, &message);
+
+            if (message_type == 0) {
+                return true;
+            }
+
+            if (message_type == -1) {
+                qDebug() << "Error in notification ldap_result: " << ldap_err2string(d->get_ldap_result());
+
+                return false;
+            }
+
+            if (message_type == LDAP_RES_SEARCH_ENTRY) {
+                for (LDAPMessage *entry = ldap_first_entry(d->ld, message); entry != NULL; entry = ldap_next_entry(d->ld, entry)) {
+                    d->load_entry(entry, results);
+                }
+
+                ldap_msgfree(message);
+
+                // NOTE: collect entries that have already
+                // arrived, without waiting for more
+                timeout.tv_sec = 0;
+                timeout.tv_usec = 0;
+
+                continue;
+            }
+
+            // NOTE: notifications don't end on their own, so
+            // a search result means that server stopped the
+            // notification, for example because of admin
+            // limits
+            if (message_type == LDAP_RES_SEARCH_RESULT) {
+                d->notification_msgid_set.remove(ldap_msgid(message));
+                ldap_msgfree(message);
+
+                return false;
+            }
+
+            ldap_msgfree(message);
+        }
+    }();
+
+    // NOTE: objects were changed by someone else, so cached
+    // versions are outdated
+    AdObjectCache::instance()->invalidate(results->keys());
+
+    return out;
+}
+
 bool AdInterface::attribute_replace_values(const QString &dn, const QString &attribute, const QList<QByteArray> &values, const DoStatusMsg do_msg, const bool set_dacl) {
     const AdObject object = search_object(dn, {attribute});
     const QList<QByteArray> old_values = object.get_values(attribute);
@@ -562,6 +1056,8 @@ bool AdInterface::attribute_replace_values(const QString &dn, const QString &att
 
     result = ldap_modify_ext_s(d->ld, cstr(dn), attrs, server_controls, NULL);
 
+    invalidate_cached_objects(dn, attribute, values + old_values);
+
     ldap_control_free(sd_control);
     if (result != LDAP_SUCCESS) {
         const QString context = QString(tr("Failed to change attribute %1 of object %2 from \"%3\" to \"%4\".")).arg(attribute, name, old_values_display, values_display);
@@ -608,6 +1104,8 @@ bool AdInterface::attribute_add_value(const QString &dn, const QString &attribut
     const int result = ldap_modify_ext_s(d->ld, cstr(dn), attrs, NULL, NULL);
     free(data_copy);
 
+    invalidate_cached_objects(dn, attribute, {value});
+
     const QString name = dn_get_name(dn);
     const QString new_display_value = attribute_display_value(attribute, value, d->adconfig);
 
@@ -651,6 +1149,8 @@ bool AdInterface::attribute_delete_value(const QString &dn, const QString &attri
     const int result = ldap_modify_ext_s(d->ld, cstr(dn), attrs, NULL, NULL);
     free(data_copy);
 
+    invalidate_cached_objects(dn, attribute, {value});
+
     if (result == LDAP_SUCCESS) {
         const QString context = QString(tr("Value \"%1\" for attribute %2 of object %3 was deleted.")).arg(value_display, attribute, name);
 
@@ -718,6 +1218,8 @@ bool AdInterface::object_add(const QString &dn, const QHash<QString, QList<QStri
 
     const int result = ldap_add_ext_s(d->ld, cstr(dn), attrs, NULL, NULL);
 
+    AdObjectCache::instance()->invalidate(dn);
+
     ldap_mods_free(attrs, 1);
 
     if (result == LDAP_SUCCESS) {
@@ -787,6 +1289,11 @@ bool AdInterface::object_delete(const QString &dn, const DoStatusMsg do_msg) {
         server_controls[0] = tree_delete_control;
     }
 
+    // NOTE: invalidate whole subtree up front, because
+    // without tree delete control children are deleted
+    // separately below
+    AdObjectCache::instance()->invalidate(dn);
+
     result = ldap_delete_ext_s(d->ld, cstr(dn), server_controls, NULL);
 
     ldap_control_free(tree_delete_control);
@@ -846,6 +1353,8 @@ bool AdInterface::object_move(const QString &dn, const QString &new_container) {
 
     const int result = ldap_rename_s(d->ld, cstr(dn), cstr(rdn), cstr(new_container), 1, NULL, NULL);
 
+    AdObjectCache::instance()->invalidate(dn);
+
     if (result == LDAP_SUCCESS) {
         d->success_message(QString(tr("Object %1 was moved to %2.")).arg(object_name, container_name));
 
@@ -866,6 +1375,8 @@ bool AdInterface::object_rename(const QString &dn, const QString &new_name) {
 
     const int result = ldap_rename_s(d->ld, cstr(dn), cstr(new_rdn), NULL, 1, NULL, NULL);
 
+    AdObjectCache::instance()->invalidate(dn);
+
     if (result == LDAP_SUCCESS) {
         d->success_message(QString(tr("Object %1 was renamed to %2.")).arg(old_name, new_name));
 
@@ -919,6 +1430,98 @@ bool AdInterface::group_remove_member(const QString &group_dn, const QString &us
     }
 }
 
+bool AdInterface::group_add_members(const QString &group_dn, const QList<QString> &member_list) {
+    return d->group_modify_members(group_dn, member_list, true);
+}
+
+bool AdInterface::group_remove_members(const QString &group_dn, const QList<QString> &member_list) {
+    return d->group_modify_members(group_dn, member_list, false);
+}
+
+bool AdInterfacePrivate::group_modify_members(const QString &group_dn, const QList<QString> &member_list, const bool add) {
+    auto modify_one = [&](const QString &member) {
+        if (add) {
+            return q->group_add_member(group_dn, member);
+        } else {
+            return q->group_remove_member(group_dn, member);
+        }
+    };
+
+    // NOTE: use single versions for single member to
+    // keep status messages the same
+    if (member_list.size() == 1) {
+        return modify_one(member_list[0]);
+    }
+
+    const QString group_name = dn_get_name(group_dn);
+    const int mod_op = (add ? LDAP_MOD_ADD : LDAP_MOD_DELETE);
+
+    bool total_success = true;
+
+    for (int i = 0; i < member_list.size(); i += MEMBER_MODIFY_CHUNK_SIZE) {
+        const QList<QString> chunk = member_list.mid(i, MEMBER_MODIFY_CHUNK_SIZE);
+
+        QList<QByteArray> values;
+        for (const QString &member : chunk) {
+            values.append(member.toUtf8());
+        }
+
+        const bool chunk_success = modify_values(group_dn, ATTRIBUTE_MEMBER, values, mod_op);
+
+        if (chunk_success) {
+            const QString count_string = QString::number(chunk.size());
+
+            if (add) {
+                success_message(QString(tr("%1 objects were added to group %2.")).arg(count_string, group_name));
+            } else {
+                success_message(QString(tr("%1 objects were removed from group %2.")).arg(count_string, group_name));
+            }
+        } else {
+            // NOTE: retry one by one, so that valid members
+            // are still applied and failures are reported
+            // for each member separately
+            for (const QString &member : chunk) {
+                const bool success = modify_one(member);
+                if (!success) {
+                    total_success = false;
+                }
+            }
+        }
+    }
+
+    return total_success;
+}
+
+// Adds or deletes multiple values of attribute in one
+// request. Doesn't add status messages.
+bool AdInterfacePrivate::modify_values(const QString &dn, const QString &attribute, const QList<QByteArray> &values, const int mod_op) {
+    QList<struct berval> ber_list(values.size());
+    QList<struct berval *> ber_ptr_list;
+    for (int i = 0; i < values.size(); i++) {
+        ber_list[i].bv_val = (char *) values[i].constData();
+        ber_list[i].bv_len = values[i].size();
+
+        ber_ptr_list.append(&ber_list[i]);
+    }
+    ber_ptr_list.append(NULL);
+
+    const QByteArray dn_bytes = dn.toUtf8();
+    const QByteArray attribute_bytes = attribute.toUtf8();
+
+    LDAPMod attr;
+    attr.mod_op = mod_op | LDAP_MOD_BVALUES;
+    attr.mod_type = (char *) attribute_bytes.constData();
+    attr.mod_bvalues = ber_ptr_list.data();
+
+    LDAPMod *attrs[] = {&attr, NULL};
+
+    const int result = ldap_modify_ext_s(ld, dn_bytes.constData(), attrs, NULL, NULL);
+
+    invalidate_cached_objects(dn, attribute, values);
+
+    return (result == LDAP_SUCCESS);
+}
+
 bool AdInterface::group_set_scope(const QString &dn, GroupScope scope, const DoStatusMsg do_msg) {
     // NOTE: it is not possible to change scope from
     // global<->domainlocal directly, so have to switch to
@@ -1372,69 +1975,22 @@ bool AdInterface::gpo_add(const QString &display_name, QString &dn_out) {
     return true;
 }
 
-QList<QString> AdInterfacePrivate::gpo_get_gpt_contents(const QString &gpt_root_path, bool *ok) {
-    // Collect all contents of the path into a list
-    QList<QString> explore_stack;
-    QList<QString> seen_stack;
-
-    explore_stack.append(gpt_root_path);
-    seen_stack.append(gpt_root_path);
-
-    const QString error_context = QString(tr("Failed to get contents of GPT \"%1\".")).arg(gpt_root_path);
-
-    while (!explore_stack.isEmpty()) {
-        const QString path = explore_stack.takeLast();
-
-        const int dirp = smbc_opendir(cstr(path));
-
-        if (dirp < 0) {
-            *ok = false;
-
-            error_message(error_context, tr("Failed to open dir."));
-
-            return QList<QString>();
-        }
-
-        // NOTE: set errno to 0, so that we know
-        // when readdir() fails because it will
-        // change errno.
-        errno = 0;
-
-        smbc_dirent *child_dirent;
-        while ((child_dirent = smbc_readdir(dirp)) != NULL) {
-            const QString child_name = QString(child_dirent->name);
-
-            const bool is_dot_path = (child_name == "." || child_name == "..");
-            if (is_dot_path) {
-                continue;
-            } else {
-                const QString child_path = path + "/" + child_name;
-
-                seen_stack.append(child_path);
-
-                const bool child_is_dir = smb_path_is_dir(child_path, ok);
-                if (!*ok) {
-                    return QList<QString>();
-                }
-
-                if (child_is_dir) {
-                    explore_stack.append(child_path);
-                }
-            }
-        }
-
-        if (errno != 0) {
-            *ok = false;
+QList<GptEntry> AdInterfacePrivate::gpo_get_gpt_contents(const QString &gpt_root_path, bool *ok) {
+    QString error;
+    const QList<GptEntry> out = GptWalker::instance()->list(gpt_root_path, &error);
 
-            error_message(error_context, tr("Failed to read dir."));
+    if (out.isEmpty()) {
+        *ok = false;
 
-            return QList<QString>();
-        }
+        const QString error_context = QString(tr("Failed to get contents of GPT \"%1\".")).arg(gpt_root_path);
+        error_message(error_context, error);
 
-        smbc_closedir(dirp);
+        return QList<GptEntry>();
     }
 
-    return seen_stack;
+    *ok = true;
+
+    return out;
 }
 
 bool AdInterface::gpo_delete(const QString &dn, bool *deleted_object) {
@@ -1540,6 +2096,11 @@ bool AdInterface::ldap_init() {
 
     int result;
 
+    // NOTE: save pool generation before binding so that
+    // if pool is invalidated while we are binding, this
+    // handle won't be returned to the pool
+    d->pool_generation = AdConnectionPool::instance()->generation();
+
     // NOTE: this doesn't leak memory. False positive.
     result = ldap_initialize(&d->ld, cstr(uri));
     if (result != LDAP_SUCCESS) {
@@ -1612,7 +2173,10 @@ bool AdInterface::ldap_init() {
 
     // Perform bind operation
     unsigned sasl_flags = LDAP_SASL_QUIET;
+    QElapsedTimer bind_timer;
+    bind_timer.start();
     result = ldap_sasl_interactive_bind_s(d->ld, NULL, defaults.mech, NULL, NULL, sasl_flags, sasl_interact_gssapi, &defaults);
+    AdConnectionPool::instance()->add_leased(bind_timer.elapsed(), (result == LDAP_SUCCESS));
     ldap_memfree(defaults.realm);
     ldap_memfree(defaults.authcid);
     ldap_memfree(defaults.authzid);
@@ -1639,15 +2203,54 @@ bool AdInterface::ldap_init() {
         return out;
     }();
 
+    d->is_bound = true;
+
+    return true;
+}
+
+bool AdInterface::ldap_lease(const QString &dc) {
+    d->ld = AdConnectionPool::instance()->acquire(dc, &d->client_user, &d->pool_generation);
+
+    if (d->ld == NULL) {
+        return false;
+    }
+
+    d->dc = dc;
+    d->is_bound = true;
+
     return true;
 }
 
+// NOTE: bound handles are returned to the connection pool
+// instead of being unbound. Pool decides whether to keep
+// them.
 void AdInterface::ldap_free() {
-    if (d->is_connected) {
-        ldap_unbind_ext(d->ld, NULL, NULL);
+    // NOTE: abandon notifications so that pooled handle
+    // doesn't receive their entries later
+    for (const int msgid : d->notification_msgid_set) {
+        ldap_abandon_ext(d->ld, msgid, NULL, NULL);
+    }
+    d->notification_msgid_set.clear();
+
+    if (d->is_bound) {
+        const bool reusable = [&]() {
+            if (!d->is_connected) {
+                return false;
+            }
+
+            const int ldap_result = d->get_ldap_result();
+            const bool connection_lost = (ldap_result == LDAP_SERVER_DOWN || ldap_result == LDAP_CONNECT_ERROR || ldap_result == LDAP_UNAVAILABLE);
+
+            return !connection_lost;
+        }();
+
+        AdConnectionPool::instance()->release(d->ld, d->dc, d->client_user, d->pool_generation, reusable);
     } else {
         ldap_memfree(d->ld);
     }
+
+    d->ld = NULL;
+    d->is_bound = false;
 }
 
 bool AdInterface::gpo_check_perms(const QString &gpo, bool *ok) {
@@ -1661,6 +2264,11 @@ bool AdInterface::gpo_check_perms(const QString &gpo, bool *ok) {
     const QList<QString> attributes = QList<QString>();
     const bool get_sacl = true;
     const AdObject gpc_object = search_object(gpo, attributes, get_sacl);
+
+    return gpo_check_perms(gpc_object, ok);
+}
+
+bool AdInterface::gpo_check_perms(const AdObject &gpc_object, bool *ok) {
     const QString name = gpc_object.get_string(ATTRIBUTE_DISPLAY_NAME);
 
     const QString error_context = QString(tr("Failed to check permissions for GPO \"%1\".")).arg(name);
@@ -1680,50 +2288,21 @@ bool AdInterface::gpo_check_perms(const QString &gpo, bool *ok) {
     const QString gpt_sd = [&]() {
         const QString filesys_path = gpc_object.get_string(ATTRIBUTE_GPC_FILE_SYS_PATH);
         const QString smb_path = filesys_path_to_smb_path(filesys_path);
-        QByteArray smb_path_array = smb_path.toUtf8();
-        const char *smb_path_cstr = smb_path_array;
-
-        // NOTE: the length of gpt sd string doesn't have a
-        // well defined bound, so we have to use an
-        // expanding buffer
-        size_t buffer_size = 1024 * sizeof(char);
-        char *buffer = (char *) malloc(buffer_size);
-
-        while (true) {
-            const int getxattr_result = d->s_smb_context.smbcGetxattr(smb_path_cstr, "system.nt_sec_desc.*", buffer, buffer_size);
-
-            // NOTE: for some reason getxattr() returns positive
-            // non-zero return code on success, even though f-n
-            // description says it "returns 0 on success"
-            const bool success = (getxattr_result >= 0);
 
-            if (success) {
-                break;
-            } else {
-                const bool buffer_is_too_small = (errno == ERANGE);
-
-                if (buffer_is_too_small) {
-                    // Error occured, but it is due to
-                    // insufficient buffer size, so try
-                    // again with bigger buffer
-                    buffer_size = 2 * buffer_size;
-                    buffer = (char *) realloc(buffer, buffer_size);
-                } else {
-                    const QString text = QString(tr("Failed to get GPT security descriptor, %1.")).arg(strerror(errno));
-                    d->error_message(error_context, text);
-
-                    free(buffer);
+        // NOTE: use walker's pooled contexts instead of
+        // the global one, so that perms of multiple GPO's
+        // can be checked in parallel
+        QByteArray sd_bytes;
+        QString error;
+        const bool get_success = GptWalker::instance()->get_xattr(smb_path, "system.nt_sec_desc.*", &sd_bytes, &error);
+        if (!get_success) {
+            const QString text = QString(tr("Failed to get GPT security descriptor, %1")).arg(error);
+            d->error_message(error_context, text);
 
-                    return QString();
-                }
-            }
+            return QString();
         }
 
-        const QString out = QString(buffer);
-
-        free(buffer);
-
-        return out;
+        return QString(sd_bytes);
     }();
 
     //    qDebug() << "--------";
@@ -1792,28 +2371,28 @@ bool AdInterface::gpo_sync_perms(const QString &dn) {
     }
 
     // Get list of GPT contents
-
-    // NOTE: order is important, have to set perms of parent
-    // folders before their contents, otherwise fails to
-    // set! Default gpo_get_gpt_contents() order is good.
     const QString filesys_path = gpc_object.get_string(ATTRIBUTE_GPC_FILE_SYS_PATH);
     const QString smb_path = filesys_path_to_smb_path(filesys_path);
     bool ok = true;
-    const QList<QString> path_list = d->gpo_get_gpt_contents(smb_path, &ok);
-    if (!ok || path_list.isEmpty()) {
+    const QList<GptEntry> entry_list = d->gpo_get_gpt_contents(smb_path, &ok);
+    if (!ok || entry_list.isEmpty()) {
         d->error_message(error_context, QString(tr("Failed to read GPT contents of \"%1\".")).arg(smb_path));
         return false;
     }
 
     // Set descriptor on all GPT contents
-    for (const QString &path : path_list) {
-        const int set_sd_result = smbc_setxattr(cstr(path), "system.nt_sec_desc.*", cstr(gpt_sd_string), strlen(cstr(gpt_sd_string)), 0);
-        if (set_sd_result != 0) {
-            const QString error = QString(tr("Failed to set permissions, %1.")).arg(strerror(errno));
-            d->error_message(error_context, error);
+    //
+    // NOTE: order is important, have to set perms of parent
+    // folders before their contents, otherwise fails to
+    // set! Walker processes entries level by level, so
+    // parents are always done first.
+    QString set_sd_error;
+    const bool set_sd_success = GptWalker::instance()->set_xattr(entry_list, "system.nt_sec_desc.*", gpt_sd_string.toUtf8(), &set_sd_error);
+    if (!set_sd_success) {
+        const QString error = QString(tr("Failed to set permissions, %1")).arg(set_sd_error);
+        d->error_message(error_context, error);
 
-            return false;
-        }
+        return false;
     }
 
     d->success_message(QString(tr("Synced permissions of GPO \"%1\".")).arg(name));
@@ -1947,61 +2526,22 @@ int AdInterfacePrivate::get_ldap_result() const {
 bool AdInterfacePrivate::delete_gpt(const QString &parent_path) {
     bool ok = true;
 
-    QList<QString> path_list = gpo_get_gpt_contents(parent_path, &ok);
+    const QList<GptEntry> entry_list = gpo_get_gpt_contents(parent_path, &ok);
     if (!ok) {
         return false;
     }
 
-    // NOTE: have to reverse so deepest paths are first to
-    // delete correctly
-    std::reverse(path_list.begin(), path_list.end());
-
-    for (const QString &path : path_list) {
-        const bool is_dir = smb_path_is_dir(path, &ok);
-        if (!ok) {
-            return false;
-        }
-
-        if (is_dir) {
-            const int result_rmdir = smbc_rmdir(cstr(path));
-
-            if (result_rmdir != 0) {
-                error_message(QString(tr("Failed to delete GPT folder %1.")).arg(path), strerror(errno));
+    QString error;
+    const bool success = GptWalker::instance()->remove(entry_list, &error);
+    if (!success) {
+        error_message(QString(tr("Failed to delete GPT %1.")).arg(parent_path), error);
 
-                return false;
-            }
-        } else {
-            const int result_unlink = smbc_unlink(cstr(path));
-
-            if (result_unlink != 0) {
-                error_message(QString(tr("Failed to delete GPT file %1.")).arg(path), strerror(errno));
-
-                return false;
-            }
-        }
+        return false;
     }
 
     return true;
 }
 
-bool AdInterfacePrivate::smb_path_is_dir(const QString &path, bool *ok) {
-    struct stat filestat;
-    const int stat_result = smbc_stat(cstr(path), &filestat);
-    if (stat_result != 0) {
-        error_message(QString(tr("Failed to get filestat for \"%1\".")).arg(path), strerror(errno));
-
-        *ok = false;
-
-        return false;
-    } else {
-        *ok = true;
-
-        const bool is_dir = S_ISDIR(filestat.st_mode);
-
-        return is_dir;
-    }
-}
-
 // NOTE: this f-n is analogous to
 // ldap_create_page_control() and others. See pagectl.c
 // in ldap sources for examples. Extracted to contain
@@ -2085,15 +2625,23 @@ QString AdInterface::get_domain() const {
 }
 
 void AdInterface::update_dc() {
-    d->dc = AdInterfacePrivate::s_dc;
-
     // Reinit ldap connection with updated DC
     ldap_free();
     if (!d->s_smb_context.is_valid()) {
         d->s_smb_context = SMBContext();
     }
 
-    d->is_connected = ldap_init() && d->s_smb_context.is_valid();
+    const bool ldap_ok = [&]() {
+        if (ldap_lease(AdInterfacePrivate::s_dc)) {
+            return true;
+        }
+
+        d->dc = AdInterfacePrivate::s_dc;
+
+        return ldap_init();
+    }();
+
+    d->is_connected = ldap_ok && d->s_smb_context.is_valid();
 }
 
 QList<QString> get_domain_hosts(const QString &domain, const QString &site) {
@@ -2101,18 +2649,16 @@ QList<QString> get_domain_hosts(const QString &domain, const QString &site) {
 
     // Query site hosts
     if (!site.isEmpty()) {
-        char dname[1000];
-        snprintf(dname, sizeof(dname), "_ldap._tcp.%s._sites.%s", cstr(site), cstr(domain));
+        const QString dname = QString("_ldap._tcp.%1._sites.%2").arg(site, domain);
 
-        const QList<QString> site_hosts = query_server_for_hosts(dname);
+        const QList<QString> site_hosts = dc_cache_get_hosts(dname);
         hosts.append(site_hosts);
     }
 
     // Query default hosts
-    char dname_default[1000];
-    snprintf(dname_default, sizeof(dname_default), "_ldap._tcp.%s", cstr(domain));
+    const QString dname_default = QString("_ldap._tcp.%1").arg(domain);
 
-    const QList<QString> default_hosts = query_server_for_hosts(dname_default);
+    const QList<QString> default_hosts = dc_cache_get_hosts(dname_default);
     hosts.append(default_hosts);
 
     hosts.removeDuplicates();
@@ -2120,8 +2666,199 @@ QList<QString> get_domain_hosts(const QString &domain, const QString &site) {
     return hosts;
 }
 
+void clear_domain_hosts_cache() {
+    QMutexLocker locker(&dc_cache_mutex);
+
+    dc_cache.clear();
+    dc_cache_generation++;
+}
+
+// NOTE: DC list almost never changes, so DNS answers are
+// cached for the TTL of SRV records. When an entry expires
+// but is still within the grace period, the stale entry is
+// returned immediately and is refreshed in the background,
+// so that connecting doesn't block on DNS. Entries older
+// than that are refreshed synchronously.
+QList<QString> dc_cache_get_hosts(const QString &dname) {
+    QList<QString> hosts;
+    bool found = false;
+    bool need_background_refresh = false;
+
+    {
+        QMutexLocker locker(&dc_cache_mutex);
+
+        if (dc_cache.contains(dname)) {
+            DcCacheEntry &entry = dc_cache[dname];
+            const qint64 age = entry.age_timer.elapsed();
+
+            if (age < entry.ttl_ms) {
+                hosts = entry.hosts;
+                found = true;
+            } else if (age < entry.ttl_ms + DC_CACHE_STALE_GRACE_MS) {
+                hosts = entry.hosts;
+                found = true;
+
+                if (!entry.is_refreshing) {
+                    entry.is_refreshing = true;
+                    need_background_refresh = true;
+                }
+            }
+        }
+    }
+
+    if (need_background_refresh) {
+        QThreadPool::globalInstance()->start([dname]() {
+            dc_cache_refresh(dname);
+        });
+    }
+
+    if (!found) {
+        hosts = dc_cache_refresh(dname);
+    }
+
+    return hosts;
+}
+
+QList<QString> dc_cache_refresh(const QString &dname) {
+    const int generation = [&]() {
+        QMutexLocker locker(&dc_cache_mutex);
+
+        return dc_cache_generation;
+    }();
+
+    // NOTE: not using cstr() because this may be called
+    // from a background thread
+    const QByteArray dname_bytes = dname.toUtf8();
+    const QList<DcSrvRecord> records = query_server_for_hosts(dname_bytes.constData());
+
+    QMutexLocker locker(&dc_cache_mutex);
+
+    // NOTE: if cache was cleared while we were querying,
+    // then this answer may be outdated, so don't save it
+    const bool cache_was_cleared = (generation != dc_cache_generation);
+    if (cache_was_cleared) {
+        return srv_records_to_hosts(records);
+    }
+
+    // NOTE: don't cache failed queries. If there's a
+    // stale entry, keep serving it until grace period
+    // ends.
+    if (records.isEmpty()) {
+        if (dc_cache.contains(dname)) {
+            dc_cache[dname].is_refreshing = false;
+        }
+
+        return QList<QString>();
+    }
+
+    const int ttl = [&]() {
+        int out = records[0].ttl;
+        for (const DcSrvRecord &record : records) {
+            out = qMin(out, record.ttl);
+        }
+
+        out = qMax(out, DC_CACHE_MIN_TTL_SECONDS);
+
+        return out;
+    }();
+
+    // NOTE: if records didn't change, keep previous order
+    // so that the selected DC stays the same for the whole
+    // session instead of changing every time TTL expires
+    const QList<QString> hosts = [&]() {
+        if (dc_cache.contains(dname) && srv_records_are_equal(dc_cache[dname].records, records)) {
+            return dc_cache[dname].hosts;
+        } else {
+            return srv_records_to_hosts(records);
+        }
+    }();
+
+    DcCacheEntry entry;
+    entry.records = records;
+    entry.hosts = hosts;
+    entry.ttl_ms = (qint64) ttl * 1000;
+    entry.is_refreshing = false;
+    entry.age_timer.start();
+
+    dc_cache[dname] = entry;
+
+    return hosts;
+}
+
+// NOTE: ttl is ignored because it decreases in answers
+// from caching resolvers even if records didn't change
+bool srv_records_are_equal(const QList<DcSrvRecord> &a, const QList<DcSrvRecord> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    for (const DcSrvRecord &record_a : a) {
+        bool found_in_b = false;
+        for (const DcSrvRecord &record_b : b) {
+            if (record_a.host == record_b.host && record_a.priority == record_b.priority && record_a.weight == record_b.weight) {
+                found_in_b = true;
+
+                break;
+            }
+        }
+
+        if (!found_in_b) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Orders records as described in RFC 2782. Records are
+// sorted by priority, lowest first. Records with same
+// priority are ordered by weighted random selection, so
+// that clients are distributed between DC's in proportion
+// to their weights.
+QList<QString> srv_records_to_hosts(const QList<DcSrvRecord> &records) {
+    QMap<int, QList<DcSrvRecord>> priority_map;
+    for (const DcSrvRecord &record : records) {
+        priority_map[record.priority].append(record);
+    }
+
+    QList<QString> out;
+
+    for (QList<DcSrvRecord> group : priority_map) {
+        while (!group.isEmpty()) {
+            int weight_sum = 0;
+            for (const DcSrvRecord &record : group) {
+                weight_sum += record.weight;
+            }
+
+            const int selected_i = [&]() {
+                // NOTE: all weights are 0, select in order
+                if (weight_sum == 0) {
+                    return 0;
+                }
+
+                const int random_value = QRandomGenerator::global()->bounded(weight_sum);
+
+                int running_sum = 0;
+                for (int i = 0; i < group.size(); i++) {
+                    running_sum += group[i].weight;
+
+                    if (running_sum > random_value) {
+                        return i;
+                    }
+                }
+
+                return group.size() - 1;
+            }();
+
+            out.append(group.takeAt(selected_i).host);
+        }
+    }
+
+    return out;
+}
+
 /**
- * Perform a query for dname and output hosts
+ * Perform a query for dname and output SRV records
  * dname is a combination of protocols (d->ldap, tcp), domain and site
  * NOTE: this is rewritten from
  * https://github.com/paleg/libadclient/blob/master/adclient.cpp
@@ -2130,7 +2867,7 @@ QList<QString> get_domain_hosts(const QString &domain, const QString &site) {
  * Another example of similar procedure:
  * https://www.gnu.org/software/shishi/coverage/shishi/lib/resolv.c.gcov.html
  */
-QList<QString> query_server_for_hosts(const char *dname) {
+QList<DcSrvRecord> query_server_for_hosts(const char *dname) {
     union dns_msg {
         HEADER header;
         unsigned char buf[NS_MAXMSG];
@@ -2140,7 +2877,7 @@ QList<QString> query_server_for_hosts(const char *dname) {
 
     const bool message_error = (msg_len < sizeof(HEADER));
     if (message_error) {
-        return QList<QString>();
+        return QList<DcSrvRecord>();
     }
 
     const int packet_count = ntohs(msg.header.qdcount);
@@ -2155,15 +2892,15 @@ QList<QString> query_server_for_hosts(const char *dname) {
 
         const bool packet_error = (packet_len < 0);
         if (packet_error) {
-            return QList<QString>();
+            return QList<DcSrvRecord>();
         }
 
         curr = curr + packet_len + QFIXEDSZ;
     }
 
-    QList<QString> hosts;
+    QList<DcSrvRecord> records;
 
-    // Process answers by collecting hosts into list
+    // Process answers by collecting records into list
     for (int i = 0; i < answer_count; i++) {
         // Get server
         char server[NS_MAXDNAME];
@@ -2171,18 +2908,18 @@ QList<QString> query_server_for_hosts(const char *dname) {
 
         const bool server_error = (server_len < 0);
         if (server_error) {
-            return QList<QString>();
+            return QList<DcSrvRecord>();
         }
 
         curr = curr + server_len;
 
         if (curr + RRFIXEDSZ > eom) {
-            return QList<QString>();
+            return QList<DcSrvRecord>();
         }
 
         int record_type;
         int UNUSED(record_class);
-        int UNUSED(ttl);
+        int ttl;
         int record_len;
         GETSHORT(record_type, curr);
         GETSHORT(record_class, curr);
@@ -2191,7 +2928,7 @@ QList<QString> query_server_for_hosts(const char *dname) {
 
         unsigned char *record_end = curr + record_len;
         if (record_end > eom) {
-            return QList<QString>();
+            return QList<DcSrvRecord>();
         }
 
         // Skip non-server records
@@ -2201,8 +2938,8 @@ QList<QString> query_server_for_hosts(const char *dname) {
             continue;
         }
 
-        int UNUSED(priority);
-        int UNUSED(weight);
+        int priority;
+        int weight;
         int UNUSED(port);
         GETSHORT(priority, curr);
         GETSHORT(weight, curr);
@@ -2213,15 +2950,20 @@ QList<QString> query_server_for_hosts(const char *dname) {
         const int host_len = dn_expand(msg.buf, eom, curr, host, sizeof(host));
         const bool host_error = (host_len < 0);
         if (host_error) {
-            return QList<QString>();
+            return QList<DcSrvRecord>();
         }
 
-        hosts.append(QString(host));
+        DcSrvRecord record;
+        record.host = QString(host);
+        record.priority = priority;
+        record.weight = weight;
+        record.ttl = ttl;
+        records.append(record);
 
         curr = record_end;
     }
 
-    return hosts;
+    return records;
 }
 
 /**
@@ -2348,16 +3090,65 @@ QString get_gpt_sd_string(const AdObject &gpc_object, const AceMaskFormat format
     return out;
 }
 
+// Invalidates cached object and, for linked attributes,
+// objects that values point to, because their back links
+// change as well
+void invalidate_cached_objects(const QString &dn, const QString &attribute, const QList<QByteArray> &values) {
+    QList<QString> dn_list = {dn};
+
+    // NOTE: if schema isn't loaded yet, can't tell which
+    // attributes are linked, so invalidate all values.
+    // Values that aren't DN's just won't match any cached
+    // object.
+    const bool is_linked = [&]() {
+        const AdConfig *adconfig = AdInterfacePrivate::adconfig;
+
+        if (adconfig != nullptr) {
+            return adconfig->get_attribute_is_linked(attribute);
+        } else {
+            return true;
+        }
+    }();
+    if (is_linked) {
+        for (const QByteArray &value : values) {
+            dn_list.append(QString::fromUtf8(value));
+        }
+    }
+
+    AdObjectCache::instance()->invalidate(dn_list);
+}
+
 AdCookie::AdCookie() {
     cookie = NULL;
+    pending_msgid = -1;
+    ld = NULL;
+    cancel_token = NULL;
 }
 
 bool AdCookie::more_pages() const {
     return (cookie != NULL);
 }
 
+void AdCookie::set_cancel_token(const std::atomic<bool> *token) {
+    cancel_token = token;
+}
+
+bool AdCookie::is_cancelled() const {
+    if (cancel_token == NULL) {
+        return false;
+    }
+
+    return cancel_token->load();
+}
+
 AdCookie::~AdCookie() {
     ber_bvfree(cookie);
+
+    // NOTE: abandon request for next page if search was
+    // stopped before all pages were retrieved
+    if (pending_msgid != -1 && ld != NULL) {
+        ldap_abandon_ext(ld, pending_msgid, NULL, NULL);
+    }
 }
 
 AdMessage::AdMessage(const QString &text, const AdMessageType &type) {
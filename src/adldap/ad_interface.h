@@ -29,6 +29,7 @@
 #include <QCoreApplication>
 #include <QHash>
 #include <QSet>
+#include <atomic>
 
 #include "ad_defines.h"
 
@@ -38,6 +39,7 @@ class QByteArray;
 class QDateTime;
 class AdObject;
 class AdConfig;
+struct AdConnectionPoolStats;
 template <typename T>
 class QList;
 typedef void TALLOC_CTX;
@@ -63,9 +65,21 @@ public:
 
     bool more_pages() const;
 
+    // Token is checked while waiting for server responses.
+    // Once it's set, page request that is in progress is
+    // abandoned and search_paged() returns false. Token is
+    // owned by caller and may be set from any thread.
+    void set_cancel_token(const std::atomic<bool> *token);
+    bool is_cancelled() const;
+
 private:
     struct berval *cookie;
 
+    // Request for next page that was sent in advance
+    int pending_msgid;
+    struct ldap *ld;
+    const std::atomic<bool> *cancel_token;
+
     friend class AdInterface;
     friend class AdInterfacePrivate;
 };
@@ -101,6 +115,10 @@ public:
 
     static void set_log_searches(const bool enabled);
 
+    // Number of objects requested per page by
+    // search_paged(). Values <= 0 reset to default.
+    static void set_page_size(const int page_size);
+
     static void set_dc(const QString &dc);
     static void set_sasl_nocanon(const bool is_on);
     static void set_port(const int port);
@@ -108,6 +126,12 @@ public:
     static void set_domain_is_default(const bool is_default);
     static void set_custom_domain(const QString &domain);
 
+    // Drops pooled LDAP connections. Call this when
+    // credentials change, so that new AdInterface's bind
+    // with new credentials.
+    static void reset_connections();
+    static AdConnectionPoolStats connection_pool_stats();
+
     bool is_connected() const;
     QList<AdMessage> messages() const;
     bool any_error_messages() const;
@@ -137,10 +161,41 @@ public:
     // at once.
     bool search_paged(const QString &base, const SearchScope scope, const QString &filter, const QList<QString> &attributes, QHash<QString, AdObject> *results, AdCookie *cookie, const bool get_sacl = false);
 
+    // Retrieves values of a large multi-valued attribute
+    // (like "member") incrementally, one range at a time.
+    // Server decides how many values are in one range
+    // (MaxValRange, 1500 by default). "next_start" is set
+    // to start of the next range or -1 if there are no
+    // more values. Start with 0. "range_size" requests a
+    // smaller range, values <= 0 leave it to server. Note
+    // that regular search f-ns retrieve all ranges
+    // automatically, use this when you don't want to load
+    // all values at once.
+    bool search_attribute_range(const QString &dn, const QString &attribute, const int start, QList<QByteArray> *values, int *next_start, const int range_size = 0);
+
     // Simplest search f-n that only searches for attributes
-    // of one object
+    // of one object. Results are cached, see AdObjectCache.
     AdObject search_object(const QString &dn, const QList<QString> &attributes = QList<QString>(), const bool get_sacl = false);
 
+    // Starts a change notification search on container.
+    // Server then sends an entry every time a child of the
+    // container is added, modified, moved in or out, or
+    // deleted. Deleted objects are sent from Deleted
+    // Objects container with isDeleted set. Returns
+    // notification id or -1 on failure. Note that AD allows
+    // only a few notifications per connection (5 by
+    // default) and that notifications don't mix with other
+    // async searches on the same AdInterface.
+    int notification_start(const QString &container, const QList<QString> &attributes);
+    void notification_stop(const int notification_id);
+
+    // Waits for entries of started notifications for at
+    // most "timeout_millis" and adds them to "results".
+    // Returns false if connection failed or server ended
+    // one of the notifications. After that, notifications
+    // should be restarted with a new AdInterface.
+    bool notification_wait(const int timeout_millis, QHash<QString, AdObject> *results);
+
     bool attribute_replace_values(const QString &dn, const QString &attribute, const QList<QByteArray> &values, const DoStatusMsg do_msg = DoStatusMsg_Yes, const bool set_dacl = false);
 
     bool attribute_replace_value(const QString &dn, const QString &attribute, const QByteArray &value, const DoStatusMsg do_msg = DoStatusMsg_Yes, const bool set_dacl = false);
@@ -166,6 +221,16 @@ public:
 
     bool group_add_member(const QString &group_dn, const QString &user_dn);
     bool group_remove_member(const QString &group_dn, const QString &user_dn);
+
+    // Versions of group_add_member() and
+    // group_remove_member() that modify many members in as
+    // few requests as possible. Members are sent in chunks
+    // of up to 1500 values (default MaxValRange). Server
+    // rejects whole chunk if any one member fails, for
+    // example if it's already in the group, in which case
+    // members of that chunk are retried one by one.
+    bool group_add_members(const QString &group_dn, const QList<QString> &member_list);
+    bool group_remove_members(const QString &group_dn, const QList<QString> &member_list);
     bool group_set_scope(const QString &dn, GroupScope scope, const DoStatusMsg do_msg = DoStatusMsg_Yes);
     bool group_set_type(const QString &dn, GroupType type);
 
@@ -180,6 +245,12 @@ public:
     bool gpo_add(const QString &name, QString &dn_out);
     bool gpo_delete(const QString &dn, bool *deleted_object);
     bool gpo_check_perms(const QString &gpo, bool *ok);
+    // Version of gpo_check_perms() for GPC object that was
+    // already loaded with SACL. Doesn't check whether
+    // client is a domain admin, caller should do that.
+    // Safe to use from multiple threads, as long as each
+    // thread has it's own AdInterface.
+    bool gpo_check_perms(const AdObject &gpc_object, bool *ok);
     bool gpo_sync_perms(const QString &gpo);
     bool gpo_get_sysvol_version(const AdObject &gpc_object, int *version);
 
@@ -188,10 +259,18 @@ public:
 private:
     AdInterfacePrivate *d;
 
+    friend class AdWriteQueue;
+
     bool ldap_init();
+    bool ldap_lease(const QString &dc);
     void ldap_free();
 };
 
+// NOTE: results are cached according to TTL of DNS SRV
+// records and are ordered by priority and weight
 QList<QString> get_domain_hosts(const QString &domain, const QString &site);
 
+// Forces next get_domain_hosts() calls to query DNS
+void clear_domain_hosts_cache();
+
 #endif /* AD_INTERFACE_H */
@@ -24,6 +24,7 @@
 #include <QCoreApplication>
 #include <QList>
 #include <QMutex>
+#include <QSet>
 
 #include "samba/smb_context.h"
 
@@ -31,6 +32,9 @@ class AdInterface;
 class AdConfig;
 class QString;
 typedef struct ldap LDAP;
+typedef struct ldapmsg LDAPMessage;
+struct berval;
+struct GptEntry;
 
 class AdInterfacePrivate {
     Q_DECLARE_TR_FUNCTIONS(AdInterfacePrivate)
@@ -43,10 +47,16 @@ public:
 
     LDAP *ld;
     bool is_connected;
+    // NOTE: true if "ld" is bound, either by ldap_init() or
+    // by leasing it from the connection pool
+    bool is_bound;
+    int pool_generation;
     QString domain;
     QString dc;
     QString client_user;
     QList<AdMessage> messages;
+    // Message id's of started change notifications
+    QSet<int> notification_msgid_set;
 
     void success_message(const QString &msg, const DoStatusMsg do_msg = DoStatusMsg_Yes);
     void error_message(const QString &context, const QString &error, const DoStatusMsg do_msg = DoStatusMsg_Yes);
@@ -54,13 +64,17 @@ public:
     QString default_error() const;
     int get_ldap_result() const;
     bool search_paged_internal(const char *base, const int scope, const char *filter, char **attributes, QHash<QString, AdObject> *results, AdCookie *cookie, const bool get_sacl);
+    int search_paged_send(const char *base, const int scope, const char *filter, char **attributes, struct berval *page_cookie, const bool get_sacl);
+    void load_entry(LDAPMessage *entry, QHash<QString, AdObject> *results);
+    bool search_attribute_range(const QString &dn, const QString &attribute, const int start, QList<QByteArray> *values, int *next_start, const int range_size = 0);
+    bool modify_values(const QString &dn, const QString &attribute, const QList<QByteArray> &values, const int mod_op);
+    bool group_modify_members(const QString &group_dn, const QList<QString> &member_list, const bool add);
     bool connect_via_ldap(const char *uri);
     bool delete_gpt(const QString &parent_path);
-    bool smb_path_is_dir(const QString &path, bool *ok);
 
     // Returns GPT contents including the root path, in
     // order of increasing depth, so root path is first
-    QList<QString> gpo_get_gpt_contents(const QString &gpt_root_path, bool *ok);
+    QList<GptEntry> gpo_get_gpt_contents(const QString &gpt_root_path, bool *ok);
 
 private:
     static AdConfig *adconfig;
@@ -68,6 +82,7 @@ private:
     static QString s_dc;
     static void *s_sasl_nocanon;
     static int s_port;
+    static int s_page_size;
     static bool s_domain_is_default;
     static QString s_custom_domain;
     static CertStrategy s_cert_strat;
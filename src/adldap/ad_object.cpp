@@ -32,43 +32,222 @@
 #include <QHash>
 #include <QList>
 #include <QMap>
+#include <QReadWriteLock>
+#include <QSharedData>
 #include <QString>
 #include <algorithm>
 
-AdObject::AdObject() {
+struct AdObjectAttribute {
+    int name_id;
+    // Index of first value in value offset list
+    int value_index;
+    int value_count;
+};
+
+class AdObjectData : public QSharedData {
+public:
+    QString dn;
+
+    // Sorted by name id
+    QList<AdObjectAttribute> attribute_list;
+
+    // All values packed together. Value i occupies
+    // [value_offset_list[i], value_offset_list[i + 1]) of
+    // the buffer, so offset list has one extra element.
+    QByteArray value_buffer;
+    QList<int> value_offset_list;
+};
+
+// NOTE: attribute names are interned process-wide instead
+// of against AdConfig because AdObject's are created
+// before AdConfig is loaded and in search threads. There
+// are only a couple thousand attributes in the schema, so
+// the table stays small. Table is only appended to, so
+// ids stay valid.
+class AdAttributeNameTable {
+public:
+    int get_id(const QString &name) const {
+        QReadLocker locker(&lock);
+
+        return name_to_id_map.value(name, -1);
+    }
+
+    int intern(const QString &name) {
+        {
+            QReadLocker locker(&lock);
+
+            const int id = name_to_id_map.value(name, -1);
+            if (id != -1) {
+                return id;
+            }
+        }
+
+        QWriteLocker locker(&lock);
+
+        // NOTE: check again, could've been added while we
+        // were waiting for write lock
+        const int existing_id = name_to_id_map.value(name, -1);
+        if (existing_id != -1) {
+            return existing_id;
+        }
+
+        const int id = name_list.size();
+        name_list.append(name);
+        name_to_id_map[name] = id;
+
+        return id;
+    }
+
+    QString get_name(const int id) const {
+        QReadLocker locker(&lock);
+
+        return name_list[id];
+    }
+
+private:
+    mutable QReadWriteLock lock;
+    QList<QString> name_list;
+    QHash<QString, int> name_to_id_map;
+};
+
+static AdAttributeNameTable *attribute_name_table() {
+    static AdAttributeNameTable table;
+
+    return &table;
+}
+
+static QSharedDataPointer<AdObjectData> empty_data() {
+    static const QSharedDataPointer<AdObjectData> data(new AdObjectData());
+
+    return data;
 }
 
+AdObject::AdObject()
+: data(empty_data()) {
+}
+
+AdObject::AdObject(const AdObject &other) = default;
+AdObject &AdObject::operator=(const AdObject &other) = default;
+AdObject::~AdObject() = default;
+
 void AdObject::load(const QString &dn_arg, const QHash<QString, QList<QByteArray>> &attributes_data_arg) {
-    dn = dn_arg;
-    attributes_data = attributes_data_arg;
+    AdObjectData *new_data = new AdObjectData();
+    new_data->dn = dn_arg;
+
+    int value_count_total = 0;
+    int buffer_size = 0;
+    for (const QList<QByteArray> &values : attributes_data_arg) {
+        value_count_total += values.size();
+
+        for (const QByteArray &value : values) {
+            buffer_size += value.size();
+        }
+    }
+
+    new_data->attribute_list.reserve(attributes_data_arg.size());
+    new_data->value_offset_list.reserve(value_count_total + 1);
+    new_data->value_buffer.reserve(buffer_size);
+
+    for (auto it = attributes_data_arg.begin(); it != attributes_data_arg.end(); it++) {
+        const QList<QByteArray> &values = it.value();
+
+        AdObjectAttribute attribute;
+        attribute.name_id = attribute_name_table()->intern(it.key());
+        attribute.value_index = new_data->value_offset_list.size();
+        attribute.value_count = values.size();
+
+        for (const QByteArray &value : values) {
+            new_data->value_offset_list.append(new_data->value_buffer.size());
+            new_data->value_buffer.append(value);
+        }
+
+        new_data->attribute_list.append(attribute);
+    }
+
+    new_data->value_offset_list.append(new_data->value_buffer.size());
+
+    std::sort(new_data->attribute_list.begin(), new_data->attribute_list.end(),
+        [](const AdObjectAttribute &a, const AdObjectAttribute &b) {
+            return a.name_id < b.name_id;
+        });
+
+    data = QSharedDataPointer<AdObjectData>(new_data);
 }
 
 QString AdObject::get_dn() const {
-    return dn;
+    return data->dn;
 }
 
 QHash<QString, QList<QByteArray>> AdObject::get_attributes_data() const {
-    return attributes_data;
+    QHash<QString, QList<QByteArray>> out;
+
+    for (const AdObjectAttribute &attribute : data->attribute_list) {
+        const QString name = attribute_name_table()->get_name(attribute.name_id);
+        out[name] = get_values(name);
+    }
+
+    return out;
 }
 
 bool AdObject::is_empty() const {
-    return attributes_data.isEmpty();
+    return data->attribute_list.isEmpty();
 }
 
 bool AdObject::contains(const QString &attribute) const {
-    return attributes_data.contains(attribute);
+    return (find_attribute(attribute) != -1);
 }
 
 QList<QString> AdObject::attributes() const {
-    return attributes_data.keys();
+    QList<QString> out;
+    out.reserve(data->attribute_list.size());
+
+    for (const AdObjectAttribute &attribute : data->attribute_list) {
+        out.append(attribute_name_table()->get_name(attribute.name_id));
+    }
+
+    return out;
 }
 
 QList<QByteArray> AdObject::get_values(const QString &attribute) const {
-    if (contains(attribute)) {
-        return attributes_data[attribute];
-    } else {
+    const int attribute_index = find_attribute(attribute);
+    if (attribute_index == -1) {
         return QList<QByteArray>();
     }
+
+    const AdObjectAttribute &attribute_data = data->attribute_list[attribute_index];
+
+    QList<QByteArray> out;
+    out.reserve(attribute_data.value_count);
+
+    for (int i = attribute_data.value_index; i < attribute_data.value_index + attribute_data.value_count; i++) {
+        const int value_start = data->value_offset_list[i];
+        const int value_end = data->value_offset_list[i + 1];
+        const QByteArray value = QByteArray(data->value_buffer.constData() + value_start, value_end - value_start);
+
+        out.append(value);
+    }
+
+    return out;
+}
+
+int AdObject::find_attribute(const QString &attribute) const {
+    const int name_id = attribute_name_table()->get_id(attribute);
+    if (name_id == -1) {
+        return -1;
+    }
+
+    const QList<AdObjectAttribute> &attribute_list = data->attribute_list;
+
+    auto it = std::lower_bound(attribute_list.begin(), attribute_list.end(), name_id,
+        [](const AdObjectAttribute &a, const int id) {
+            return a.name_id < id;
+        });
+
+    if (it != attribute_list.end() && it->name_id == name_id) {
+        return (int) (it - attribute_list.begin());
+    } else {
+        return -1;
+    }
 }
 
 QByteArray AdObject::get_value(const QString &attribute) const {
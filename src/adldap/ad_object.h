@@ -29,6 +29,11 @@
  * with data once and not updated afterwards so it WILL
  * become out of date after any AD modification. Therefore,
  * do not keep it around for too long.
+ *
+ * Data is stored in a compact form, because searches can
+ * return hundreds of thousands of objects. Attribute names
+ * are interned, all values of an object are packed into
+ * one buffer and copies of an object share data.
  */
 
 #include "ad_defines.h"
@@ -36,10 +41,12 @@
 #include <QByteArray>
 #include <QHash>
 #include <QList>
+#include <QSharedDataPointer>
 #include <QString>
 
 class QDateTime;
 class AdConfig;
+class AdObjectData;
 typedef void TALLOC_CTX;
 struct security_descriptor;
 
@@ -47,6 +54,9 @@ class AdObject {
 
 public:
     AdObject();
+    AdObject(const AdObject &other);
+    AdObject &operator=(const AdObject &other);
+    ~AdObject();
 
     void load(const QString &dn_arg, const QHash<QString, QList<QByteArray>> &attributes_data_arg);
 
@@ -88,8 +98,11 @@ public:
     security_descriptor *get_security_descriptor(TALLOC_CTX *mem_ctx = nullptr) const;
 
 private:
-    QString dn;
-    QHash<QString, QList<QByteArray>> attributes_data;
+    QSharedDataPointer<AdObjectData> data;
+
+    // Returns index of attribute in attribute list of
+    // data or -1 if object doesn't have this attribute
+    int find_attribute(const QString &attribute) const;
 };
 
 #endif /* AD_OBJECT_H */
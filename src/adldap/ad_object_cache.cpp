@@ -0,0 +1,160 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ad_object_cache.h"
+
+#include "ad_defines.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+
+// Entries that were validated within this time are used
+// without asking the server
+#define FRESH_TIME_MILLIS (2 * 1000)
+// Entries older than this are always reloaded
+#define MAX_AGE_MILLIS (60 * 1000)
+// NOTE: when cache is full it's simply dropped. Objects
+// are implicitly shared, so entries are cheap, but cache
+// shouldn't grow without bounds.
+#define MAX_ENTRY_COUNT 2000
+
+AdObjectCache *AdObjectCache::instance() {
+    static AdObjectCache cache;
+
+    return &cache;
+}
+
+AdObjectCache::AdObjectCache()
+: m_generation(0) {
+}
+
+QString AdObjectCache::make_key(const QString &dc, const QString &dn, const QList<QString> &attributes, const bool get_sacl) {
+    QList<QString> sorted_attributes = attributes;
+    std::sort(sorted_attributes.begin(), sorted_attributes.end());
+
+    const QString sacl_string = get_sacl ? "1" : "0";
+
+    return QString("%1\n%2\n%3\n%4").arg(dc, dn.toLower(), sorted_attributes.join(","), sacl_string);
+}
+
+AdObjectCacheLookup AdObjectCache::lookup(const QString &key, AdObject *object_out) const {
+    QMutexLocker locker(&mutex);
+
+    auto it = entry_map.constFind(key);
+    if (it == entry_map.constEnd()) {
+        return AdObjectCacheLookup_Miss;
+    }
+
+    const CacheEntry &entry = it.value();
+
+    if (entry.loaded_timer.hasExpired(MAX_AGE_MILLIS)) {
+        return AdObjectCacheLookup_Miss;
+    }
+
+    *object_out = entry.object;
+
+    if (entry.validated_timer.hasExpired(FRESH_TIME_MILLIS)) {
+        return AdObjectCacheLookup_Stale;
+    } else {
+        return AdObjectCacheLookup_Fresh;
+    }
+}
+
+void AdObjectCache::insert(const QString &key, const AdObject &object) {
+    if (!object.contains(ATTRIBUTE_USN_CHANGED)) {
+        return;
+    }
+
+    QMutexLocker locker(&mutex);
+
+    if (entry_map.size() >= MAX_ENTRY_COUNT) {
+        entry_map.clear();
+    }
+
+    CacheEntry entry;
+    entry.dn = object.get_dn().toLower();
+    entry.object = object;
+    entry.loaded_timer.start();
+    entry.validated_timer.start();
+
+    entry_map.insert(key, entry);
+}
+
+void AdObjectCache::mark_validated(const QString &key) {
+    QMutexLocker locker(&mutex);
+
+    auto it = entry_map.find(key);
+    if (it != entry_map.end()) {
+        it.value().validated_timer.start();
+    }
+}
+
+void AdObjectCache::invalidate(const QString &dn) {
+    invalidate(QList<QString>({dn}));
+}
+
+void AdObjectCache::invalidate(const QList<QString> &dn_list) {
+    if (dn_list.isEmpty()) {
+        return;
+    }
+
+    m_generation++;
+
+    QList<QString> lower_dn_list;
+    QList<QString> suffix_list;
+    for (const QString &dn : dn_list) {
+        const QString lower_dn = dn.toLower();
+
+        lower_dn_list.append(lower_dn);
+        suffix_list.append("," + lower_dn);
+    }
+
+    QMutexLocker locker(&mutex);
+
+    for (auto it = entry_map.begin(); it != entry_map.end();) {
+        const QString &entry_dn = it.value().dn;
+
+        const bool match = [&]() {
+            for (int i = 0; i < lower_dn_list.size(); i++) {
+                if (entry_dn == lower_dn_list[i] || entry_dn.endsWith(suffix_list[i])) {
+                    return true;
+                }
+            }
+
+            return false;
+        }();
+
+        if (match) {
+            it = entry_map.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void AdObjectCache::clear() {
+    QMutexLocker locker(&mutex);
+
+    entry_map.clear();
+    m_generation++;
+}
+
+int AdObjectCache::generation() const {
+    return m_generation;
+}
@@ -0,0 +1,103 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AD_OBJECT_CACHE_H
+#define AD_OBJECT_CACHE_H
+
+/**
+ * Process-wide cache of objects returned by
+ * AdInterface::search_object(). Entries are keyed by DC,
+ * DN, requested attributes and whether SACL was requested.
+ * Only objects that contain uSNChanged are cached, so that
+ * entries can be validated by comparing uSNChanged instead
+ * of reloading the whole object. Writes done through
+ * AdInterface invalidate entries of modified objects.
+ *
+ * NOTE: changes to back links (memberOf, directReports)
+ * don't update uSNChanged of the object, so entries also
+ * expire after a while regardless of validation.
+ */
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+#include "ad_object.h"
+
+enum AdObjectCacheLookup {
+    // Not in cache or expired, object must be loaded
+    AdObjectCacheLookup_Miss,
+    // Object was loaded or validated recently and can be
+    // used as is
+    AdObjectCacheLookup_Fresh,
+    // Object should be validated by comparing uSNChanged
+    AdObjectCacheLookup_Stale,
+};
+
+class AdObjectCache final {
+
+public:
+    static AdObjectCache *instance();
+
+    AdObjectCache(const AdObjectCache &) = delete;
+    AdObjectCache &operator=(const AdObjectCache &) = delete;
+
+    static QString make_key(const QString &dc, const QString &dn, const QList<QString> &attributes, const bool get_sacl);
+
+    AdObjectCacheLookup lookup(const QString &key, AdObject *object_out) const;
+
+    // Object is not cached if it doesn't contain uSNChanged
+    void insert(const QString &key, const AdObject &object);
+
+    // Call when uSNChanged of cached object matched server
+    void mark_validated(const QString &key);
+
+    // Removes entries for given object and all objects
+    // below it
+    void invalidate(const QString &dn);
+    void invalidate(const QList<QString> &dn_list);
+
+    void clear();
+
+    // Incremented every time entries are invalidated or
+    // cache is cleared, which happens on every write done
+    // through AdInterface. Holders of loaded objects can
+    // compare generations to check whether objects may
+    // have changed since they were loaded.
+    int generation() const;
+
+private:
+    struct CacheEntry {
+        QString dn;
+        AdObject object;
+        QElapsedTimer loaded_timer;
+        QElapsedTimer validated_timer;
+    };
+
+    AdObjectCache();
+
+    mutable QMutex mutex;
+    QHash<QString, CacheEntry> entry_map;
+    std::atomic<int> m_generation;
+};
+
+#endif /* AD_OBJECT_CACHE_H */
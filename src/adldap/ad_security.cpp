@@ -31,11 +31,16 @@
 #include "common_task_manager.h"
 
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QMutex>
+
+#include <algorithm>
 
 QByteArray dom_sid_to_bytes(const dom_sid &sid);
 QByteArray dom_sid_string_to_bytes(const dom_sid &sid);
 bool ace_match_without_access_mask(const security_ace &ace, const QByteArray &trustee, const SecurityRight &right, const bool allow, ace_match_flags match_flags);
 bool ace_match(const security_ace &ace, const QByteArray &trustee, const SecurityRight &right, const bool allow);
+SecurityRightState right_state_from_ace_list(const QList<const security_ace *> &ace_list, const QByteArray &trustee, const SecurityRight &right);
 uint32_t ad_security_map_access_mask(const uint32_t access_mask);
 int ace_compare_simplified(const security_ace &ace1, const security_ace &ace2);
 
@@ -213,41 +218,176 @@ QString ad_security_get_well_known_trustee_name(const QByteArray &trustee) {
     return trustee_name_map.value(trustee_string, QString());
 }
 
-QString ad_security_get_trustee_name(AdInterface &ad, const QByteArray &trustee) {
+// NOTE: trustee names are cached for all callers because
+// the same trustees appear in descriptors of most objects.
+// Entries expire so that renames are eventually picked up.
+// When cache is full, least recently used entries are
+// evicted.
+#define TRUSTEE_NAME_CACHE_MAX_SIZE 5000
+#define TRUSTEE_NAME_CACHE_TTL_SECONDS 300
+
+struct TrusteeNameCacheEntry {
+    QString name;
+    QElapsedTimer age_timer;
+    qint64 last_use;
+};
+
+static QMutex trustee_name_cache_mutex;
+static QHash<QString, TrusteeNameCacheEntry> trustee_name_cache;
+static qint64 trustee_name_cache_use_count = 0;
+
+static QString trustee_name_from_object(const AdObject &object);
+static void trustee_name_cache_insert(const QString &trustee_string, const QString &name);
+
+QString ad_security_get_cached_trustee_name(const QByteArray &trustee) {
     const QString trustee_string = object_sid_display_value(trustee);
 
     if (trustee_name_map.contains(trustee_string)) {
         return trustee_name_map[trustee_string];
-    } else {
-        // Try to get name of trustee by finding it's DN
-        const QString filter = filter_CONDITION(Condition_Equals, ATTRIBUTE_OBJECT_SID, trustee_string);
-        const QList<QString> attributes = {
-            ATTRIBUTE_DISPLAY_NAME,
-            ATTRIBUTE_SAM_ACCOUNT_NAME,
-        };
-        const auto trustee_search = ad.search(ad.adconfig()->domain_dn(), SearchScope_All, filter, QList<QString>());
-        if (!trustee_search.isEmpty()) {
-            // NOTE: this is some weird name selection logic
-            // but that's how microsoft does it. Maybe need
-            // to use this somewhere else as well?
-            const QString name = [&]() {
-                const AdObject object = trustee_search.values()[0];
-
-                if (object.contains(ATTRIBUTE_DISPLAY_NAME)) {
-                    return object.get_string(ATTRIBUTE_DISPLAY_NAME);
-                } else if (object.contains(ATTRIBUTE_SAM_ACCOUNT_NAME)) {
-                    return object.get_string(ATTRIBUTE_SAM_ACCOUNT_NAME);
-                } else {
-                    return dn_get_name(object.get_dn());
-                }
-            }();
+    }
+
+    QMutexLocker locker(&trustee_name_cache_mutex);
+
+    auto it = trustee_name_cache.find(trustee_string);
+    if (it == trustee_name_cache.end()) {
+        return QString();
+    }
+
+    const bool expired = it->age_timer.hasExpired(TRUSTEE_NAME_CACHE_TTL_SECONDS * 1000);
+    if (expired) {
+        trustee_name_cache.erase(it);
+
+        return QString();
+    }
+
+    trustee_name_cache_use_count++;
+    it->last_use = trustee_name_cache_use_count;
 
-            return name;
+    return it->name;
+}
+
+QHash<QByteArray, QString> ad_security_get_trustee_name_map(AdInterface &ad, const QList<QByteArray> &trustee_list) {
+    QHash<QByteArray, QString> out;
+
+    // Resolve well-known and cached trustees first
+    QHash<QString, QByteArray> unresolved_map;
+    for (const QByteArray &trustee : trustee_list) {
+        const QString cached_name = ad_security_get_cached_trustee_name(trustee);
+
+        if (!cached_name.isEmpty()) {
+            out[trustee] = cached_name;
         } else {
-            // Return raw sid as last option
-            return trustee_string;
+            const QString trustee_string = object_sid_display_value(trustee);
+            unresolved_map[trustee_string] = trustee;
         }
     }
+
+    // Search for the rest in chunks, one search per chunk
+    const QList<QString> attributes = {
+        ATTRIBUTE_OBJECT_SID,
+        ATTRIBUTE_DISPLAY_NAME,
+        ATTRIBUTE_SAM_ACCOUNT_NAME,
+    };
+
+    const QList<QString> unresolved_string_list = unresolved_map.keys();
+
+    for (int i = 0; i < unresolved_string_list.size(); i += AD_SECURITY_TRUSTEE_SEARCH_CHUNK_SIZE) {
+        const QList<QString> chunk = unresolved_string_list.mid(i, AD_SECURITY_TRUSTEE_SEARCH_CHUNK_SIZE);
+
+        const QString filter = [&]() {
+            QList<QString> subfilter_list;
+            for (const QString &trustee_string : chunk) {
+                const QString subfilter = filter_CONDITION(Condition_Equals, ATTRIBUTE_OBJECT_SID, trustee_string);
+                subfilter_list.append(subfilter);
+            }
+
+            return filter_OR(subfilter_list);
+        }();
+
+        const QHash<QString, AdObject> search_results = ad.search(ad.adconfig()->domain_dn(), SearchScope_All, filter, attributes);
+
+        for (const AdObject &object : search_results) {
+            const QString trustee_string = object_sid_display_value(object.get_value(ATTRIBUTE_OBJECT_SID));
+
+            if (!unresolved_map.contains(trustee_string)) {
+                continue;
+            }
+
+            const QString name = trustee_name_from_object(object);
+            const QByteArray trustee = unresolved_map.take(trustee_string);
+            out[trustee] = name;
+
+            trustee_name_cache_insert(trustee_string, name);
+        }
+    }
+
+    // Return raw sid as last option. Note that these are
+    // not cached so that we retry next time.
+    for (auto it = unresolved_map.begin(); it != unresolved_map.end(); it++) {
+        out[it.value()] = it.key();
+    }
+
+    return out;
+}
+
+QString ad_security_get_trustee_name(AdInterface &ad, const QByteArray &trustee) {
+    const QHash<QByteArray, QString> name_map = ad_security_get_trustee_name_map(ad, {trustee});
+
+    return name_map.value(trustee);
+}
+
+void ad_security_clear_trustee_name_cache() {
+    QMutexLocker locker(&trustee_name_cache_mutex);
+
+    trustee_name_cache.clear();
+}
+
+// NOTE: this is some weird name selection logic
+// but that's how microsoft does it. Maybe need
+// to use this somewhere else as well?
+QString trustee_name_from_object(const AdObject &object) {
+    if (object.contains(ATTRIBUTE_DISPLAY_NAME)) {
+        return object.get_string(ATTRIBUTE_DISPLAY_NAME);
+    } else if (object.contains(ATTRIBUTE_SAM_ACCOUNT_NAME)) {
+        return object.get_string(ATTRIBUTE_SAM_ACCOUNT_NAME);
+    } else {
+        return dn_get_name(object.get_dn());
+    }
+}
+
+void trustee_name_cache_insert(const QString &trustee_string, const QString &name) {
+    QMutexLocker locker(&trustee_name_cache_mutex);
+
+    // Evict least recently used entries. Evict a bit more
+    // than needed so that this doesn't happen on every
+    // insert.
+    if (trustee_name_cache.size() >= TRUSTEE_NAME_CACHE_MAX_SIZE) {
+        QList<qint64> last_use_list;
+        for (const TrusteeNameCacheEntry &entry : trustee_name_cache) {
+            last_use_list.append(entry.last_use);
+        }
+
+        const int evict_count = TRUSTEE_NAME_CACHE_MAX_SIZE / 10;
+        std::nth_element(last_use_list.begin(), last_use_list.begin() + evict_count, last_use_list.end());
+        const qint64 min_last_use = last_use_list[evict_count];
+
+        for (auto it = trustee_name_cache.begin(); it != trustee_name_cache.end();) {
+            if (it->last_use < min_last_use) {
+                it = trustee_name_cache.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+
+    trustee_name_cache_use_count++;
+
+    TrusteeNameCacheEntry entry;
+    entry.name = name;
+    entry.age_timer.start();
+    entry.last_use = trustee_name_cache_use_count;
+
+    trustee_name_cache.insert(trustee_string, entry);
 }
 
 bool ad_security_replace_security_descriptor(AdInterface &ad, const QString &dn, security_descriptor *new_sd) {
@@ -466,6 +606,20 @@ QList<security_ace> security_descriptor_get_dacl(const security_descriptor *sd)
 }
 
 SecurityRightState security_descriptor_get_right_state(const security_descriptor *sd, const QByteArray &trustee, const SecurityRight &right) {
+    // NOTE: iterate over aces directly instead of using
+    // security_descriptor_get_dacl() to avoid copying
+    // whole dacl
+    QList<const security_ace *> ace_list;
+    for (size_t i = 0; i < sd->dacl->num_aces; i++) {
+        ace_list.append(&sd->dacl->aces[i]);
+    }
+
+    const SecurityRightState out = right_state_from_ace_list(ace_list, trustee, right);
+
+    return out;
+}
+
+SecurityRightState right_state_from_ace_list(const QList<const security_ace *> &ace_list, const QByteArray &trustee, const SecurityRight &right) {
     bool out_data[SecurityRightStateInherited_COUNT][SecurityRightStateType_COUNT];
     for (int x = 0; x < SecurityRightStateInherited_COUNT; x++) {
         for (int y = 0; y < SecurityRightStateType_COUNT; y++) {
@@ -473,8 +627,7 @@ SecurityRightState security_descriptor_get_right_state(const security_descriptor
         }
     }
 
-    const QList<security_ace> dacl = security_descriptor_get_dacl(sd);
-    for (const security_ace &ace : dacl) {
+    for (const security_ace *ace : ace_list) {
         // NOTE: if compared ace doesn't
         // have an object it can still
         // match if it's access mask
@@ -487,17 +640,17 @@ SecurityRightState security_descriptor_get_right_state(const security_descriptor
         // "read property" and contains
         // some object)
 
-        const bool match_for_allow = ace_match(ace, trustee, right, true);
+        const bool match_for_allow = ace_match(*ace, trustee, right, true);
 
-        const bool match_for_deny = ace_match(ace, trustee, right, false);
+        const bool match_for_deny = ace_match(*ace, trustee, right, false);
 
         // If there is no match, continue to search corresponding ACEs
         if (!(match_for_allow || match_for_deny)) {
             continue;
         }
 
-        const int state_inherited = bitmask_is_set(ace.flags, SEC_ACE_FLAG_INHERITED_ACE) ? SecurityRightStateInherited_Yes :
-                                                                                            SecurityRightStateInherited_No;
+        const int state_inherited = bitmask_is_set(ace->flags, SEC_ACE_FLAG_INHERITED_ACE) ? SecurityRightStateInherited_Yes :
+                                                                                             SecurityRightStateInherited_No;
         const int state_allowed = match_for_allow ? SecurityRightStateType_Allow : SecurityRightStateType_Deny;
         out_data[state_inherited][state_allowed] = true;
     }
@@ -507,6 +660,128 @@ SecurityRightState security_descriptor_get_right_state(const security_descriptor
     return out;
 }
 
+// ACE's of one trustee. ACE's that have an object type
+// can only match rights with same object type, so they
+// are grouped by object type. ACE's without object type
+// can match any right.
+struct SecurityTrusteeAces {
+    QList<security_ace> no_object_list;
+    QHash<QByteArray, QList<security_ace>> object_map;
+};
+
+class SecurityDescriptorIndexPrivate {
+public:
+    QHash<QByteArray, SecurityTrusteeAces> trustee_map;
+
+    static QByteArray trustee_key(const dom_sid &sid);
+    static void add_ace(SecurityTrusteeAces *trustee_aces, const security_ace &ace);
+};
+
+SecurityDescriptorIndex::SecurityDescriptorIndex() {
+    d = new SecurityDescriptorIndexPrivate();
+}
+
+SecurityDescriptorIndex::~SecurityDescriptorIndex() {
+    delete d;
+}
+
+void SecurityDescriptorIndex::load(const security_descriptor *sd) {
+    d->trustee_map.clear();
+
+    if (sd == nullptr || sd->dacl == nullptr) {
+        return;
+    }
+
+    for (size_t i = 0; i < sd->dacl->num_aces; i++) {
+        const security_ace &ace = sd->dacl->aces[i];
+        const QByteArray key = SecurityDescriptorIndexPrivate::trustee_key(ace.trustee);
+
+        SecurityDescriptorIndexPrivate::add_ace(&d->trustee_map[key], ace);
+    }
+}
+
+void SecurityDescriptorIndex::update_trustee(const security_descriptor *sd, const QByteArray &trustee) {
+    const dom_sid trustee_sid = dom_sid_from_bytes(trustee);
+    const QByteArray key = SecurityDescriptorIndexPrivate::trustee_key(trustee_sid);
+
+    d->trustee_map.remove(key);
+
+    if (sd == nullptr || sd->dacl == nullptr) {
+        return;
+    }
+
+    SecurityTrusteeAces trustee_aces;
+
+    for (size_t i = 0; i < sd->dacl->num_aces; i++) {
+        const security_ace &ace = sd->dacl->aces[i];
+
+        if (dom_sid_compare(&ace.trustee, &trustee_sid) == 0) {
+            SecurityDescriptorIndexPrivate::add_ace(&trustee_aces, ace);
+        }
+    }
+
+    d->trustee_map.insert(key, trustee_aces);
+}
+
+SecurityRightState SecurityDescriptorIndex::get_right_state(const QByteArray &trustee, const SecurityRight &right) const {
+    const QList<SecurityRightState> state_list = get_right_state_list(trustee, {right});
+
+    return state_list[0];
+}
+
+QList<SecurityRightState> SecurityDescriptorIndex::get_right_state_list(const QByteArray &trustee, const QList<SecurityRight> &right_list) const {
+    QList<SecurityRightState> out;
+
+    const dom_sid trustee_sid = dom_sid_from_bytes(trustee);
+    const QByteArray key = SecurityDescriptorIndexPrivate::trustee_key(trustee_sid);
+    const SecurityTrusteeAces trustee_aces = d->trustee_map.value(key);
+
+    QList<const security_ace *> no_object_ace_list;
+    for (const security_ace &ace : trustee_aces.no_object_list) {
+        no_object_ace_list.append(&ace);
+    }
+
+    for (const SecurityRight &right : right_list) {
+        QList<const security_ace *> ace_list = no_object_ace_list;
+
+        auto object_it = trustee_aces.object_map.constFind(right.object_type);
+        if (object_it != trustee_aces.object_map.constEnd()) {
+            for (const security_ace &ace : object_it.value()) {
+                ace_list.append(&ace);
+            }
+        }
+
+        const SecurityRightState state = right_state_from_ace_list(ace_list, trustee, right);
+        out.append(state);
+    }
+
+    return out;
+}
+
+// NOTE: sid bytes may come from different sources, some
+// of which contain garbage after sub auths, so only use
+// meaningful part of sid for the key
+QByteArray SecurityDescriptorIndexPrivate::trustee_key(const dom_sid &sid) {
+    const int num_auths = qBound(0, (int) sid.num_auths, 15);
+    const int meaningful_size = 8 + num_auths * (int) sizeof(uint32_t);
+
+    return QByteArray((const char *) &sid, meaningful_size);
+}
+
+void SecurityDescriptorIndexPrivate::add_ace(SecurityTrusteeAces *trustee_aces, const security_ace &ace) {
+    const bool object_present = ace_types_with_object.contains(ace.type) &&
+            bitmask_is_set(ace.object.object.flags, SEC_ACE_OBJECT_TYPE_PRESENT);
+
+    if (object_present) {
+        const GUID ace_object_type_guid = ace.object.object.type.type;
+        const QByteArray ace_object_type = QByteArray((char *) &ace_object_type_guid, sizeof(GUID));
+
+        trustee_aces->object_map[ace_object_type].append(ace);
+    } else {
+        trustee_aces->no_object_list.append(ace);
+    }
+}
+
 void security_descriptor_print(security_descriptor *sd, AdInterface &ad) {
     const QList<security_ace> dacl = security_descriptor_get_dacl(sd);
 
@@ -976,6 +1251,13 @@ void security_descriptor_remove_right(security_descriptor *sd, AdConfig *adconfi
 }
 
 QList<SecurityRight> ad_security_get_right_list_for_class(AdConfig *adconfig, const QList<QString> &class_list) {
+    const QString cache_key = QString("class;%1").arg(class_list.join(","));
+
+    QList<SecurityRight> cached_list;
+    if (adconfig->get_cached_right_list(cache_key, &cached_list)) {
+        return cached_list;
+    }
+
     const QString obj_class = class_list.last();
 
     QList<SecurityRight> permissionable_attrs_rights;
@@ -988,7 +1270,7 @@ QList<SecurityRight> ad_security_get_right_list_for_class(AdConfig *adconfig, co
     for (const QString &obj_class : adconfig->all_inferiors_list(obj_class)) {
         child_objects_rights.append(creation_deletion_rights_for_class(adconfig, obj_class));
 
-        if (common_task_manager->class_common_task_rights_map.keys().contains(obj_class)) {
+        if (common_task_manager->class_common_task_rights_map.contains(obj_class)) {
             QList<SecurityRight> obj_class_rights = common_task_manager->rights_for_class(obj_class);
             for (const SecurityRight &right : obj_class_rights) {
                 if (!child_objects_rights.contains(right)) {
@@ -1001,6 +1283,8 @@ QList<SecurityRight> ad_security_get_right_list_for_class(AdConfig *adconfig, co
     QList<SecurityRight> out = ad_security_get_common_rights() + ad_security_get_extended_rights_for_class(adconfig, class_list) +
             permissionable_attrs_rights + child_objects_rights + common_task_rights;
 
+    adconfig->cache_right_list(cache_key, out);
+
     return out;
 }
 
@@ -1061,6 +1345,23 @@ QList<SecurityRight> ad_security_get_subordinate_right_list(AdConfig *adconfig,
 
     uint32_t access_mask = right.access_mask;
 
+    // NOTE: subordinates depend only on access mask and
+    // classes, so the matching part is cached. Inherited
+    // object type and flags are then copied from given
+    // right.
+    const QString cache_key = QString("subordinate;%1;%2").arg(QString::number(access_mask), class_list.join(","));
+
+    QList<SecurityRight> match_list;
+    if (adconfig->get_cached_right_list(cache_key, &match_list)) {
+        for (const SecurityRight &match : match_list) {
+            SecurityRight out_right = {match.access_mask, match.object_type,
+                                       right.inherited_object_type, right.flags};
+            out.append(out_right);
+        }
+
+        return out;
+    }
+
     const QList<SecurityRight> right_list_for_target = ad_security_get_right_list_for_class(adconfig, class_list);
 
     for (const SecurityRight &class_right : right_list_for_target) {
@@ -1097,12 +1398,16 @@ QList<SecurityRight> ad_security_get_subordinate_right_list(AdConfig *adconfig,
         }
 
         if (match) {
+            match_list.append({class_right.access_mask, class_right.object_type, QByteArray(), 0});
+
             SecurityRight out_right = {class_right.access_mask, class_right.object_type,
                                        right.inherited_object_type, right.flags};
             out.append(out_right);
         }
     }
 
+    adconfig->cache_right_list(cache_key, match_list);
+
     return out;
 }
 
@@ -29,6 +29,7 @@
 #include "ad_defines.h"
 
 #include <QByteArray>
+#include <QHash>
 #include <QLocale>
 
 class AdInterface;
@@ -84,6 +85,35 @@ struct SecurityRight {
 };
 Q_DECLARE_METATYPE(SecurityRight)
 
+class SecurityDescriptorIndexPrivate;
+
+// Index of descriptor's ACE's by trustee and object type,
+// for checking states of many rights at once. Checking a
+// right only looks at ACE's of the trustee that can match
+// the right's object type, instead of the whole DACL. Index
+// contains copies of ACE's, so it needs to be updated
+// after descriptor is modified. After editing rights of a
+// trustee, it's enough to call update_trustee() for that
+// trustee.
+class SecurityDescriptorIndex final {
+public:
+    SecurityDescriptorIndex();
+    ~SecurityDescriptorIndex();
+
+    SecurityDescriptorIndex(const SecurityDescriptorIndex &) = delete;
+    SecurityDescriptorIndex &operator=(const SecurityDescriptorIndex &) = delete;
+
+    void load(const security_descriptor *sd);
+    void update_trustee(const security_descriptor *sd, const QByteArray &trustee);
+
+    // Same result as security_descriptor_get_right_state()
+    SecurityRightState get_right_state(const QByteArray &trustee, const SecurityRight &right) const;
+    QList<SecurityRightState> get_right_state_list(const QByteArray &trustee, const QList<SecurityRight> &right_list) const;
+
+private:
+    SecurityDescriptorIndexPrivate *d;
+};
+
 extern CommonTaskManager *common_task_manager;
 
 // ace_match_flags struct is used to configure ACE matching, that determines
@@ -99,6 +129,19 @@ struct ace_match_flags {
 
 QString ad_security_get_well_known_trustee_name(const QByteArray &trustee);
 QString ad_security_get_trustee_name(AdInterface &ad, const QByteArray &trustee);
+
+// Resolves names of multiple trustees using one search
+// per AD_SECURITY_TRUSTEE_SEARCH_CHUNK_SIZE trustees.
+// Trustees that couldn't be resolved are mapped to their
+// SID string. Resolved names are cached, so repeated
+// calls for same trustees don't perform any searches.
+#define AD_SECURITY_TRUSTEE_SEARCH_CHUNK_SIZE 50
+QHash<QByteArray, QString> ad_security_get_trustee_name_map(AdInterface &ad, const QList<QByteArray> &trustee_list);
+
+// Returns name of a well-known or a cached trustee without
+// searching. Returns empty string if name is unknown.
+QString ad_security_get_cached_trustee_name(const QByteArray &trustee);
+void ad_security_clear_trustee_name_cache();
 bool ad_security_get_protected_against_deletion(const AdObject &object);
 bool ad_security_set_protected_against_deletion(AdInterface &ad, const QString dn, const bool enabled);
 bool ad_security_get_user_cant_change_pass(const AdObject *object, AdConfig *adconfig);
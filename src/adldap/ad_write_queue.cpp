@@ -0,0 +1,408 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ad_write_queue.h"
+
+#include "ad_config.h"
+#include "ad_interface.h"
+#include "ad_interface_p.h"
+#include "ad_object_cache.h"
+#include "ad_utils.h"
+
+#include <ldap.h>
+
+#include <QDebug>
+#include <QHash>
+
+#include <algorithm>
+
+#define DEFAULT_MAX_IN_FLIGHT 16
+
+// How often cancel token is checked while waiting for
+// responses
+#define CANCEL_POLL_INTERVAL_MILLIS 100
+
+// Request that was sent and is waiting for response
+struct AdWriteRequest {
+    int operation_index;
+    // True if this is a search for current
+    // userAccountControl, which is sent before modifying
+    // account options
+    bool is_read;
+    int uac;
+    bool got_uac;
+};
+
+AdWriteOperation AdWriteOperation::make_delete(const QString &dn) {
+    AdWriteOperation out;
+    out.type = AdWriteOperationType_Delete;
+    out.dn = dn;
+    out.option = AccountOption_Disabled;
+    out.set = false;
+
+    return out;
+}
+
+AdWriteOperation AdWriteOperation::make_move(const QString &dn, const QString &new_container) {
+    AdWriteOperation out = make_delete(dn);
+    out.type = AdWriteOperationType_Move;
+    out.new_container = new_container;
+
+    return out;
+}
+
+AdWriteOperation AdWriteOperation::make_account_option(const QString &dn, const AccountOption option, const bool set) {
+    AdWriteOperation out = make_delete(dn);
+    out.type = AdWriteOperationType_AccountOption;
+    out.option = option;
+    out.set = set;
+
+    return out;
+}
+
+AdWriteQueue::AdWriteQueue(AdInterface &ad_arg)
+: ad(ad_arg),
+  max_in_flight(DEFAULT_MAX_IN_FLIGHT),
+  cancel_token(nullptr) {
+}
+
+void AdWriteQueue::set_max_in_flight(const int max_in_flight_arg) {
+    max_in_flight = qMax(1, max_in_flight_arg);
+}
+
+void AdWriteQueue::set_cancel_token(const std::atomic<bool> *token) {
+    cancel_token = token;
+}
+
+void AdWriteQueue::set_progress_callback(const std::function<void(const int done_count, const int total_count)> &callback) {
+    progress_callback = callback;
+}
+
+QList<bool> AdWriteQueue::run(const QList<AdWriteOperation> &operation_list) {
+    LDAP *ld = ad.d->ld;
+    const int total_count = operation_list.size();
+
+    QList<bool> result_list(total_count, false);
+
+    // Operations that failed in the pipeline and will be
+    // retried synchronously
+    QList<int> retry_list;
+
+    QHash<int, AdWriteRequest> in_flight_map;
+    int next_index = 0;
+    int done_count = 0;
+
+    auto report_progress = [&]() {
+        done_count++;
+
+        if (progress_callback) {
+            progress_callback(done_count, total_count);
+        }
+    };
+
+    struct timeval poll_timeout;
+    poll_timeout.tv_sec = 0;
+    poll_timeout.tv_usec = CANCEL_POLL_INTERVAL_MILLIS * 1000;
+
+    while (next_index < total_count || !in_flight_map.isEmpty()) {
+        if (is_cancelled()) {
+            for (const int msgid : in_flight_map.keys()) {
+                ldap_abandon_ext(ld, msgid, NULL, NULL);
+            }
+
+            // NOTE: abandoned requests may still have been
+            // performed by server
+            for (const AdWriteRequest &request : in_flight_map) {
+                AdObjectCache::instance()->invalidate(operation_list[request.operation_index].dn);
+            }
+
+            return result_list;
+        }
+
+        // Fill the pipeline
+        while (in_flight_map.size() < max_in_flight && next_index < total_count) {
+            const AdWriteOperation &operation = operation_list[next_index];
+            const int msgid = send_request(operation);
+
+            if (msgid != -1) {
+                AdWriteRequest request;
+                request.operation_index = next_index;
+                request.is_read = (operation.type == AdWriteOperationType_AccountOption);
+                request.uac = 0;
+                request.got_uac = false;
+
+                in_flight_map[msgid] = request;
+            } else {
+                retry_list.append(next_index);
+            }
+
+            next_index++;
+        }
+
+        if (in_flight_map.isEmpty()) {
+            continue;
+        }
+
+        LDAPMessage *message = NULL;
+        const int message_type = ldap_result(ld, LDAP_RES_ANY, LDAP_MSG_ONE, &poll_timeout, &message);
+
+        if (message_type == 0) {
+            continue;
+        }
+
+        if (message_type == -1) {
+            qDebug() << "Error in write queue ldap_result: " << ldap_err2string(ad.d->get_ldap_result());
+
+            // NOTE: connection is most likely lost, so
+            // retrying will just report errors for remaining
+            // operations
+            for (const AdWriteRequest &request : in_flight_map) {
+                retry_list.append(request.operation_index);
+            }
+            for (int i = next_index; i < total_count; i++) {
+                retry_list.append(i);
+            }
+            in_flight_map.clear();
+            next_index = total_count;
+
+            break;
+        }
+
+        const int msgid = ldap_msgid(message);
+        if (!in_flight_map.contains(msgid)) {
+            ldap_msgfree(message);
+
+            continue;
+        }
+
+        AdWriteRequest request = in_flight_map[msgid];
+        const AdWriteOperation &operation = operation_list[request.operation_index];
+
+        if (message_type == LDAP_RES_SEARCH_ENTRY) {
+            struct berval **values = ldap_get_values_len(ld, message, ATTRIBUTE_USER_ACCOUNT_CONTROL);
+            if (values != NULL && values[0] != NULL) {
+                const QByteArray uac_bytes(values[0]->bv_val, values[0]->bv_len);
+                in_flight_map[msgid].uac = uac_bytes.toInt();
+                in_flight_map[msgid].got_uac = true;
+            }
+            ldap_value_free_len(values);
+            ldap_msgfree(message);
+
+            continue;
+        }
+
+        int error_code = LDAP_OTHER;
+        const int freeit = 1;
+        const int parse_result = ldap_parse_result(ld, message, &error_code, NULL, NULL, NULL, NULL, freeit);
+        const bool success = (parse_result == LDAP_SUCCESS && error_code == LDAP_SUCCESS);
+
+        in_flight_map.remove(msgid);
+
+        if (request.is_read) {
+            const int write_msgid = (success && request.got_uac) ? send_uac_write(operation, request.uac) : -1;
+
+            if (write_msgid != -1) {
+                request.is_read = false;
+                in_flight_map[write_msgid] = request;
+            } else {
+                retry_list.append(request.operation_index);
+            }
+
+            continue;
+        }
+
+        AdObjectCache::instance()->invalidate(operation.dn);
+
+        if (success) {
+            result_list[request.operation_index] = true;
+            add_success_message(operation);
+
+            report_progress();
+        } else {
+            retry_list.append(request.operation_index);
+        }
+    }
+
+    // NOTE: retried operations are reported as done when
+    // they finish
+    std::sort(retry_list.begin(), retry_list.end());
+
+    for (const int index : retry_list) {
+        if (is_cancelled()) {
+            break;
+        }
+
+        result_list[index] = run_sync(operation_list[index]);
+
+        report_progress();
+    }
+
+    return result_list;
+}
+
+bool AdWriteQueue::is_cancelled() const {
+    if (cancel_token == nullptr) {
+        return false;
+    }
+
+    return cancel_token->load();
+}
+
+// Sends first request of operation. Returns message id or
+// -1 if request failed or operation can't be pipelined.
+int AdWriteQueue::send_request(const AdWriteOperation &operation) {
+    LDAP *ld = ad.d->ld;
+    const QByteArray dn_bytes = operation.dn.toUtf8();
+    int msgid = -1;
+    int result = LDAP_OTHER;
+
+    switch (operation.type) {
+        case AdWriteOperationType_Delete: {
+            // NOTE: use tree delete control same as
+            // AdInterface::object_delete(). If delete fails
+            // for any other reason, it is retried by
+            // object_delete(), which handles the other cases.
+            LDAPControl *tree_delete_control = NULL;
+            LDAPControl *server_controls[2] = {NULL, NULL};
+
+            const bool tree_delete_is_supported = (ad.adconfig() != nullptr && ad.adconfig()->control_is_supported(LDAP_CONTROL_X_TREE_DELETE));
+            if (tree_delete_is_supported) {
+                result = ldap_control_create(LDAP_CONTROL_X_TREE_DELETE, 1, NULL, 0, &tree_delete_control);
+                if (result != LDAP_SUCCESS) {
+                    return -1;
+                }
+
+                server_controls[0] = tree_delete_control;
+            }
+
+            result = ldap_delete_ext(ld, dn_bytes.constData(), server_controls, NULL, &msgid);
+
+            ldap_control_free(tree_delete_control);
+
+            break;
+        }
+        case AdWriteOperationType_Move: {
+            const QString rdn = operation.dn.split(',')[0];
+            const QByteArray rdn_bytes = rdn.toUtf8();
+            const QByteArray new_container_bytes = operation.new_container.toUtf8();
+            const int delete_old_rdn = 1;
+
+            result = ldap_rename(ld, dn_bytes.constData(), rdn_bytes.constData(), new_container_bytes.constData(), delete_old_rdn, NULL, NULL, &msgid);
+
+            break;
+        }
+        case AdWriteOperationType_AccountOption: {
+            // NOTE: these options are not stored in
+            // userAccountControl
+            const bool is_uac_option = (operation.option != AccountOption_CantChangePassword && operation.option != AccountOption_PasswordExpired);
+            if (!is_uac_option) {
+                return -1;
+            }
+
+            char *attributes[] = {(char *) ATTRIBUTE_USER_ACCOUNT_CONTROL, NULL};
+            const int attrsonly = 0;
+
+            result = ldap_search_ext(ld, dn_bytes.constData(), LDAP_SCOPE_BASE, "(objectClass=*)", attributes, attrsonly, NULL, NULL, NULL, LDAP_NO_LIMIT, &msgid);
+
+            break;
+        }
+    }
+
+    if (result != LDAP_SUCCESS) {
+        return -1;
+    }
+
+    return msgid;
+}
+
+int AdWriteQueue::send_uac_write(const AdWriteOperation &operation, const int uac) {
+    const int bit = account_option_bit(operation.option);
+    const int updated_uac = bitmask_set(uac, bit, operation.set);
+
+    const QByteArray dn_bytes = operation.dn.toUtf8();
+    QByteArray value = QByteArray::number(updated_uac);
+
+    struct berval ber_data;
+    ber_data.bv_val = value.data();
+    ber_data.bv_len = value.size();
+
+    struct berval *values[] = {&ber_data, NULL};
+
+    LDAPMod attr;
+    attr.mod_op = LDAP_MOD_REPLACE | LDAP_MOD_BVALUES;
+    attr.mod_type = (char *) ATTRIBUTE_USER_ACCOUNT_CONTROL;
+    attr.mod_bvalues = values;
+
+    LDAPMod *attrs[] = {&attr, NULL};
+
+    int msgid;
+    const int result = ldap_modify_ext(ad.d->ld, dn_bytes.constData(), attrs, NULL, NULL, &msgid);
+    if (result != LDAP_SUCCESS) {
+        return -1;
+    }
+
+    return msgid;
+}
+
+bool AdWriteQueue::run_sync(const AdWriteOperation &operation) {
+    switch (operation.type) {
+        case AdWriteOperationType_Delete: return ad.object_delete(operation.dn);
+        case AdWriteOperationType_Move: return ad.object_move(operation.dn, operation.new_container);
+        case AdWriteOperationType_AccountOption: return ad.user_set_account_option(operation.dn, operation.option, operation.set);
+    }
+
+    return false;
+}
+
+// NOTE: messages must match the ones of synchronous f-ns
+void AdWriteQueue::add_success_message(const AdWriteOperation &operation) {
+    const QString name = dn_get_name(operation.dn);
+
+    const QString message = [&]() {
+        switch (operation.type) {
+            case AdWriteOperationType_Delete: return QString(AdInterface::tr("Object %1 was deleted.")).arg(name);
+            case AdWriteOperationType_Move: {
+                const QString container_name = dn_get_name(operation.new_container);
+
+                return QString(AdInterface::tr("Object %1 was moved to %2.")).arg(name, container_name);
+            }
+            case AdWriteOperationType_AccountOption: {
+                if (operation.option == AccountOption_Disabled) {
+                    if (operation.set) {
+                        return QString(AdInterface::tr("Object %1 has been disabled.")).arg(name);
+                    } else {
+                        return QString(AdInterface::tr("Object %1 has been enabled.")).arg(name);
+                    }
+                } else {
+                    const QString description = account_option_string(operation.option);
+
+                    if (operation.set) {
+                        return QString(AdInterface::tr("Account option \"%1\" was turned ON for object %2.")).arg(description, name);
+                    } else {
+                        return QString(AdInterface::tr("Account option \"%1\" was turned OFF for object %2.")).arg(description, name);
+                    }
+                }
+            }
+        }
+
+        return QString();
+    }();
+
+    ad.d->success_message(message);
+}
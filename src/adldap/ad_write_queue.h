@@ -0,0 +1,99 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AD_WRITE_QUEUE_H
+#define AD_WRITE_QUEUE_H
+
+/**
+ * Performs many write operations using one AdInterface,
+ * keeping multiple requests in flight instead of waiting
+ * for a response to each one before sending the next. Bulk
+ * operations then take roughly one round trip per
+ * "max_in_flight" operations. Status messages are added to
+ * AdInterface, same as for regular f-ns. Operations that
+ * fail or can't be pipelined are retried using the regular
+ * synchronous f-ns of AdInterface, which handle special
+ * cases and report errors.
+ */
+
+#include <QList>
+#include <QString>
+#include <atomic>
+#include <functional>
+
+#include "ad_defines.h"
+
+class AdInterface;
+
+enum AdWriteOperationType {
+    AdWriteOperationType_Delete,
+    AdWriteOperationType_Move,
+    AdWriteOperationType_AccountOption,
+};
+
+struct AdWriteOperation {
+    AdWriteOperationType type;
+    QString dn;
+    // Move
+    QString new_container;
+    // Account option
+    AccountOption option;
+    bool set;
+
+    static AdWriteOperation make_delete(const QString &dn);
+    static AdWriteOperation make_move(const QString &dn, const QString &new_container);
+    static AdWriteOperation make_account_option(const QString &dn, const AccountOption option, const bool set);
+};
+
+class AdWriteQueue final {
+
+public:
+    AdWriteQueue(AdInterface &ad);
+
+    void set_max_in_flight(const int max_in_flight);
+
+    // Token is checked between responses. Once it's set,
+    // requests in flight are abandoned and remaining
+    // operations are not performed. Token is owned by
+    // caller and may be set from any thread.
+    void set_cancel_token(const std::atomic<bool> *token);
+
+    // Called after every finished operation, in the thread
+    // that called run()
+    void set_progress_callback(const std::function<void(const int done_count, const int total_count)> &callback);
+
+    // Returns list of results in the same order as
+    // operations. Operations that were cancelled are
+    // returned as failed.
+    QList<bool> run(const QList<AdWriteOperation> &operation_list);
+
+private:
+    AdInterface &ad;
+    int max_in_flight;
+    const std::atomic<bool> *cancel_token;
+    std::function<void(const int, const int)> progress_callback;
+
+    bool is_cancelled() const;
+    int send_request(const AdWriteOperation &operation);
+    int send_uac_write(const AdWriteOperation &operation, const int uac);
+    bool run_sync(const AdWriteOperation &operation);
+    void add_success_message(const AdWriteOperation &operation);
+};
+
+#endif /* AD_WRITE_QUEUE_H */
@@ -22,13 +22,17 @@
 #define ADLDAP_H
 
 #include "ad_config.h"
+#include "ad_connection_pool.h"
 #include "ad_defines.h"
 #include "ad_display.h"
 #include "ad_filter.h"
+#include "ad_filter_matcher.h"
 #include "ad_interface.h"
 #include "ad_object.h"
+#include "ad_object_cache.h"
 #include "ad_security.h"
 #include "ad_utils.h"
+#include "ad_write_queue.h"
 #include "gplink.h"
 
 #endif /* ADLDAP_H */
@@ -13,51 +13,72 @@ Gplink::Gplink(const Gplink &other) : gpo_list(other.gpo_list), options(other.op
 
 }
 
-Gplink::Gplink(const QString &gplink_string) {
-    if (gplink_string.isEmpty()) {
-        return;
-    }
+Gplink::Gplink(const QString &gplink_string)
+: Gplink(QStringView(gplink_string)) {
+}
 
-    // "[gpo_1;option_1][gpo_2;option_2][gpo_3;option_3]..."
-    // =>
-    // {"gpo_1;option_1", "gpo_2;option_2", "gpo_3;option_3"}
-    QString gplink_string_without_brackets = gplink_string;
-    gplink_string_without_brackets.replace("[", "");
-    const QList<QString> gplink_string_split = gplink_string_without_brackets.split(']');
+// NOTE: parsing is done in one pass over views of the
+// original string, so that the only allocations are for
+// stored GPO dn's. Input is expected to be in the form
+// "[LDAP://gpo_1;option_1][LDAP://gpo_2;option_2]...".
+// Malformed parts are skipped.
+Gplink::Gplink(QStringView gplink_string) {
+    const QStringView ldap_prefix = u"" LDAP_PREFIX;
+
+    qsizetype part_start = 0;
+
+    while (part_start < gplink_string.size()) {
+        qsizetype part_end = gplink_string.indexOf(u']', part_start);
+        if (part_end == -1) {
+            part_end = gplink_string.size();
+        }
+
+        QStringView part = gplink_string.mid(part_start, part_end - part_start);
+        part_start = part_end + 1;
+
+        // NOTE: brackets are ignored wherever they are.
+        // Normally there's only one at the start of each
+        // part, so only copy for the unusual case.
+        QString part_without_brackets;
+        while (part.startsWith(u'[')) {
+            part = part.mid(1);
+        }
+        if (part.contains(u'[')) {
+            part_without_brackets = part.toString();
+            part_without_brackets.remove(u'[');
+            part = part_without_brackets;
+        }
 
-    for (auto part : gplink_string_split) {
         if (part.isEmpty()) {
             continue;
         }
 
-        // "gpo;option"
-        // =>
-        // gpo and option
-        const QList<QString> part_split = part.split(';');
-
-        if (part_split.size() != 2) {
+        // "gpo;option" => gpo and option
+        const qsizetype separator_index = part.indexOf(u';');
+        const bool has_one_separator = (separator_index != -1 && part.indexOf(u';', separator_index + 1) == -1);
+        if (!has_one_separator) {
             continue;
         }
 
         // "LDAP://cn={UUID},cn=something,DC=a,DC=b"
         // =>
         // "cn={uuid},cn=something,dc=a,dc=b"
+        const QStringView gpo_view = part.left(separator_index);
+        const qsizetype prefix_count = gpo_view.count(ldap_prefix);
         const QString gpo = [&]() {
-            QString out;
-
-            out = part_split[0];
-            out.remove(LDAP_PREFIX);
-            out = out.toLower();
-
-            return out;
+            if (prefix_count == 0) {
+                return gpo_view.toString().toLower();
+            } else if (prefix_count == 1 && gpo_view.startsWith(ldap_prefix)) {
+                return gpo_view.mid(ldap_prefix.size()).toString().toLower();
+            } else {
+                QString out = gpo_view.toString();
+                out.remove(LDAP_PREFIX);
+
+                return out.toLower();
+            }
         }();
 
-        const int option = [&]() {
-            const QString option_string = part_split[1];
-            const int option_int = option_string.toInt();
-
-            return option_int;
-        }();
+        const int option = part.mid(separator_index + 1).toInt();
 
         gpo_list.prepend(gpo);
         options[gpo] = option;
@@ -75,76 +96,89 @@ Gplink &Gplink::operator=(const Gplink &other) {
 }
 
 // Transform into gplink format. Have to uppercase some
-// parts of the output.
+// parts of the output: "dc" attributes and value of the
+// first rdn (uuid). Output is built in one pass, without
+// splitting dn's into intermediate strings.
 QString Gplink::to_string() const {
-    QList<QString> part_list;
+    const QStringView ldap_prefix = u"" LDAP_PREFIX;
+
+    qsizetype out_size = 0;
+    for (const QString &gpo : gpo_list) {
+        // "[" + prefix + gpo + ";" + option + "]"
+        out_size += gpo.size() + ldap_prefix.size() + 4;
+    }
+
+    QString out;
+    out.reserve(out_size);
 
     QList<QString>::const_reverse_iterator i;
     for (i = gpo_list.rbegin(); i != gpo_list.rend(); ++i) {
-        // Convert gpo dn from lower case to gplink case
-        // format
-        const QString gpo_case = [&]() {
-            const QList<QString> rdn_list = i->split(",");
+        const QStringView gpo = *i;
+
+        out.append(u'[');
+        out.append(ldap_prefix);
 
-            QList<QString> rdn_list_case;
+        const qsizetype first_rdn_end = gpo.indexOf(u',');
+        const QStringView first_rdn = (first_rdn_end != -1) ? gpo.left(first_rdn_end) : gpo;
 
-            for (const QString &rdn : rdn_list) {
-                const QString rdn_case = [&]() {
-                    const QList<QString> attribute_value = rdn.split("=");
+        qsizetype rdn_start = 0;
+        while (true) {
+            qsizetype rdn_end = gpo.indexOf(u',', rdn_start);
+            const bool is_last_rdn = (rdn_end == -1);
+            if (is_last_rdn) {
+                rdn_end = gpo.size();
+            }
+
+            const QStringView rdn = gpo.mid(rdn_start, rdn_end - rdn_start);
+            const qsizetype equals_index = rdn.indexOf(u'=');
+            const bool rdn_is_malformed = (equals_index == -1 || rdn.indexOf(u'=', equals_index + 1) != -1);
+
+            if (rdn_is_malformed) {
+                // Do no processing if data is malformed
+                out.append(rdn);
+            } else {
+                const QStringView attribute = rdn.left(equals_index);
+                const QStringView value = rdn.mid(equals_index + 1);
+
+                // "DC" attribute is upper-cased
+                if (attribute == u"dc") {
+                    out.append(u"DC");
+                } else {
+                    out.append(attribute);
+                }
 
-                    // Do no processing if data is malformed
-                    if (attribute_value.size() != 2) {
-                        return rdn;
+                out.append(u'=');
+
+                // uuid (the first rdn) is upper-cased
+                if (rdn == first_rdn) {
+                    for (const QChar c : value) {
+                        out.append(c.toUpper());
                     }
+                } else {
+                    out.append(value);
+                }
+            }
 
-                    const QString attribute = attribute_value[0];
-                    const QString value = attribute_value[1];
-
-                    const QString attribute_case = [&]() {
-                        // "DC" attribute is upper-cased
-                        if (attribute == "dc") {
-                            return attribute.toUpper();
-                        } else {
-                            return attribute;
-                        }
-                    }();
-
-                    const QString value_case = [&]() {
-                        // uuid (the first rdn) is upper-cased
-                        if (rdn_list.indexOf(rdn) == 0) {
-                            return value.toUpper();
-                        } else {
-                            return value;
-                        }
-                    }();
-
-                    const QList<QString> attribute_value_case = {
-                        attribute_case,
-                        value_case,
-                    };
-
-                    const QString out = attribute_value_case.join("=");
-
-                    return out;
-                }();
-
-                rdn_list_case.append(rdn_case);
+            if (is_last_rdn) {
+                break;
             }
 
-            const QString out = rdn_list_case.join(",");
+            out.append(u',');
+            rdn_start = rdn_end + 1;
+        }
 
-            return out;
-        }();
-        const int option = options[*i];
-        const QString option_string = QString::number(option);
+        out.append(u';');
 
-        const QString part = QString("[%1%2;%3]").arg(LDAP_PREFIX, gpo_case, option_string);
+        const int option = options[*i];
+        if (option >= 0 && option <= 9) {
+            out.append(QChar(u'0' + option));
+        } else {
+            out.append(QString::number(option));
+        }
 
-        part_list.append(part);
+        out.append(u']');
     }
 
-    const QString out = part_list.join("");
-
     return out;
 }
 
@@ -156,45 +190,60 @@ bool Gplink::contains(const QString &gpo_case) const {
 
 QList<QString> Gplink::get_gpo_list() const {
     QList<QString> gpo_list_case;
+    gpo_list_case.reserve(gpo_list.size());
 
-    for (auto gpo : gpo_list) {
-        const QString gpo_case = [&]() {
-            QList<QString> rdn_list = gpo.split(",");
+    for (const QString &gpo : gpo_list) {
+        QString gpo_case;
+        gpo_case.reserve(gpo.size());
 
-            const bool rdn_list_is_malformed = rdn_list.isEmpty();
-            if (rdn_list_is_malformed) {
-                return gpo;
-            }
+        qsizetype rdn_start = 0;
+        bool is_first_rdn = true;
 
-            const QString guid_rdn = rdn_list[0];
-            rdn_list[0] = guid_rdn.toUpper();
+        while (true) {
+            qsizetype rdn_end = gpo.indexOf(u',', rdn_start);
+            const bool is_last_rdn = (rdn_end == -1);
+            if (is_last_rdn) {
+                rdn_end = gpo.size();
+            }
 
-            for (int i = 1; i < rdn_list.size(); i++) {
-                const QString rdn = rdn_list[i];
-                QList<QString> rdn_split = rdn.split("=");
+            const QStringView rdn = QStringView(gpo).mid(rdn_start, rdn_end - rdn_start);
+            const qsizetype equals_index = rdn.indexOf(u'=');
+            const bool rdn_is_malformed = (equals_index == -1 || rdn.indexOf(u'=', equals_index + 1) != -1);
 
-                const bool rdn_is_malformed = (rdn_split.size() != 2);
-                if (rdn_is_malformed) {
-                    continue;
+            if (is_first_rdn) {
+                // Uppercase guid rdn
+                for (const QChar c : rdn) {
+                    gpo_case.append(c.toUpper());
                 }
-
+            } else if (rdn_is_malformed) {
+                gpo_case.append(rdn);
+            } else {
                 // Uppercase all rdn left halves
-                rdn_split[0] = rdn_split[0].toUpper();
+                for (const QChar c : rdn.left(equals_index)) {
+                    gpo_case.append(c.toUpper());
+                }
+
+                gpo_case.append(u'=');
 
                 // Modify some right halves
-                if (rdn_split[1] == "system") {
-                    rdn_split[1] = "System";
-                } else if (rdn_split[1] == "policies") {
-                    rdn_split[1] = "Policies";
+                const QStringView value = rdn.mid(equals_index + 1);
+                if (value == u"system") {
+                    gpo_case.append(u"System");
+                } else if (value == u"policies") {
+                    gpo_case.append(u"Policies");
+                } else {
+                    gpo_case.append(value);
                 }
-
-                rdn_list[i] = rdn_split.join("=");
             }
 
-            const QString out = rdn_list.join(",");
+            if (is_last_rdn) {
+                break;
+            }
 
-            return out;
-        }();
+            gpo_case.append(u',');
+            rdn_start = rdn_end + 1;
+            is_first_rdn = false;
+        }
 
         gpo_list_case.append(gpo_case);
     }
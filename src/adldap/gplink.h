@@ -44,6 +44,7 @@ public:
     Gplink();
     Gplink(const Gplink &other);
     Gplink(const QString &gplink_string);
+    Gplink(QStringView gplink_string);
 
     Gplink &operator=(const Gplink &other);
 
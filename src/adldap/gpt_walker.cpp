@@ -0,0 +1,399 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gpt_walker.h"
+
+#include "samba/smb_context.h"
+
+#include <libsmbclient.h>
+
+#include <QMutexLocker>
+#include <QSemaphore>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+// NOTE: each worker keeps it's own connection to the DC, so
+// keep this small
+#define DEFAULT_WORKER_COUNT 8
+
+GptWalker *GptWalker::instance() {
+    static GptWalker walker;
+
+    return &walker;
+}
+
+GptWalker::GptWalker() {
+    pool.setMaxThreadCount(DEFAULT_WORKER_COUNT);
+}
+
+GptWalker::~GptWalker() {
+    pool.waitForDone();
+
+    invalidate();
+}
+
+QList<GptEntry> GptWalker::list(const QString &root_path, QString *error_out) {
+    QList<GptEntry> out;
+    out.append({root_path, true, 0});
+
+    QList<QString> level_dir_list = {root_path};
+    int depth = 0;
+
+    while (!level_dir_list.isEmpty()) {
+        depth++;
+
+        // NOTE: each worker writes only to it's own
+        // element, so use vector to avoid implicit sharing
+        std::vector<QList<GptEntry>> children_list(level_dir_list.size());
+
+        auto list_dir = [&](SMBContext *context, const int index) -> QString {
+            const QString &path = level_dir_list.at(index);
+            const QByteArray path_bytes = path.toUtf8();
+
+            SMBCFILE *dir = context->smbcOpendir(path_bytes.constData());
+            if (dir == nullptr) {
+                return QString(tr("Failed to open dir \"%1\", %2.")).arg(path, strerror(errno));
+            }
+
+            // NOTE: set errno to 0, so that we know
+            // when readdir() fails because it will
+            // change errno.
+            errno = 0;
+
+            QList<GptEntry> &children = children_list[index];
+
+            smbc_dirent *child_dirent;
+            while ((child_dirent = context->smbcReaddir(dir)) != nullptr) {
+                const QString child_name = QString::fromUtf8(child_dirent->name);
+
+                const bool is_dot_path = (child_name == "." || child_name == "..");
+                if (is_dot_path) {
+                    continue;
+                }
+
+                const QString child_path = path + "/" + child_name;
+                const bool child_is_dir = (child_dirent->smbc_type == SMBC_DIR);
+
+                children.append({child_path, child_is_dir, depth});
+            }
+
+            const int readdir_errno = errno;
+
+            context->smbcClosedir(dir);
+
+            if (readdir_errno != 0) {
+                return QString(tr("Failed to read dir \"%1\", %2.")).arg(path, strerror(readdir_errno));
+            }
+
+            return QString();
+        };
+
+        const bool success = run_parallel(level_dir_list.size(), list_dir, error_out);
+        if (!success) {
+            return QList<GptEntry>();
+        }
+
+        QList<QString> next_level_dir_list;
+
+        for (const QList<GptEntry> &children : children_list) {
+            for (const GptEntry &child : children) {
+                out.append(child);
+
+                if (child.is_dir) {
+                    next_level_dir_list.append(child.path);
+                }
+            }
+        }
+
+        level_dir_list = next_level_dir_list;
+    }
+
+    return out;
+}
+
+bool GptWalker::set_xattr(const QList<GptEntry> &entry_list, const QString &name, const QByteArray &value, QString *error_out) {
+    const QByteArray name_bytes = name.toUtf8();
+
+    auto set_entry_xattr = [&](SMBContext *context, const GptEntry &entry) -> QString {
+        const QByteArray path_bytes = entry.path.toUtf8();
+
+        const int result = context->smbcSetxattr(path_bytes.constData(), name_bytes.constData(), value.constData(), value.size(), 0);
+        if (result != 0) {
+            return QString(tr("Failed to set attribute of \"%1\", %2.")).arg(entry.path, strerror(errno));
+        }
+
+        return QString();
+    };
+
+    // NOTE: parents have to be processed before children,
+    // so go from lowest depth to highest
+    QList<int> depth_list;
+    for (const GptEntry &entry : entry_list) {
+        if (!depth_list.contains(entry.depth)) {
+            depth_list.append(entry.depth);
+        }
+    }
+    std::sort(depth_list.begin(), depth_list.end());
+
+    return run_by_depth(entry_list, depth_list, set_entry_xattr, error_out);
+}
+
+bool GptWalker::remove(const QList<GptEntry> &entry_list, QString *error_out) {
+    // Delete all files at once, they don't depend on each
+    // other
+    QList<GptEntry> file_list;
+    for (const GptEntry &entry : entry_list) {
+        if (!entry.is_dir) {
+            file_list.append(entry);
+        }
+    }
+
+    auto unlink_file = [&](SMBContext *context, const int index) -> QString {
+        const GptEntry &entry = file_list.at(index);
+        const QByteArray path_bytes = entry.path.toUtf8();
+
+        const int result = context->smbcUnlink(path_bytes.constData());
+        if (result != 0) {
+            return QString(tr("Failed to delete GPT file %1, %2.")).arg(entry.path, strerror(errno));
+        }
+
+        return QString();
+    };
+
+    const bool files_success = run_parallel(file_list.size(), unlink_file, error_out);
+    if (!files_success) {
+        return false;
+    }
+
+    // Then delete folders, deepest first, since folders
+    // have to be empty to be deleted
+    QList<GptEntry> dir_list;
+    QList<int> depth_list;
+    for (const GptEntry &entry : entry_list) {
+        if (entry.is_dir) {
+            dir_list.append(entry);
+
+            if (!depth_list.contains(entry.depth)) {
+                depth_list.append(entry.depth);
+            }
+        }
+    }
+    std::sort(depth_list.begin(), depth_list.end(), std::greater<int>());
+
+    auto rmdir_dir = [&](SMBContext *context, const GptEntry &entry) -> QString {
+        const QByteArray path_bytes = entry.path.toUtf8();
+
+        const int result = context->smbcRmdir(path_bytes.constData());
+        if (result != 0) {
+            return QString(tr("Failed to delete GPT folder %1, %2.")).arg(entry.path, strerror(errno));
+        }
+
+        return QString();
+    };
+
+    return run_by_depth(dir_list, depth_list, rmdir_dir, error_out);
+}
+
+bool GptWalker::get_xattr(const QString &path, const QString &name, QByteArray *value_out, QString *error_out) {
+    SMBContext *context = acquire_context();
+    if (context == nullptr) {
+        *error_out = tr("Failed to initialize SMB context.");
+
+        return false;
+    }
+
+    const QByteArray path_bytes = path.toUtf8();
+    const QByteArray name_bytes = name.toUtf8();
+
+    // NOTE: the length of value doesn't have a well
+    // defined bound, so we have to use an expanding buffer
+    QByteArray buffer(1024, '\0');
+
+    while (true) {
+        const int result = context->smbcGetxattr(path_bytes.constData(), name_bytes.constData(), buffer.data(), buffer.size());
+
+        // NOTE: for some reason getxattr() returns positive
+        // non-zero return code on success, even though f-n
+        // description says it "returns 0 on success"
+        if (result >= 0) {
+            break;
+        }
+
+        const bool buffer_is_too_small = (errno == ERANGE);
+        if (!buffer_is_too_small) {
+            *error_out = QString(tr("Failed to get attribute of \"%1\", %2.")).arg(path, strerror(errno));
+
+            release_context(context);
+
+            return false;
+        }
+
+        buffer.resize(2 * buffer.size());
+    }
+
+    release_context(context);
+
+    // NOTE: value is a null-terminated string
+    *value_out = QByteArray(buffer.constData());
+
+    return true;
+}
+
+void GptWalker::invalidate() {
+    QMutexLocker locker(&context_mutex);
+
+    qDeleteAll(idle_context_list);
+    idle_context_list.clear();
+}
+
+int GptWalker::worker_count() const {
+    return pool.maxThreadCount();
+}
+
+void GptWalker::set_worker_count(const int count) {
+    if (count > 0) {
+        pool.setMaxThreadCount(count);
+    } else {
+        pool.setMaxThreadCount(DEFAULT_WORKER_COUNT);
+    }
+}
+
+bool GptWalker::run_parallel(const int count, const std::function<QString(SMBContext *context, const int index)> &task, QString *error_out) {
+    if (count == 0) {
+        return true;
+    }
+
+    std::atomic<int> next_index(0);
+    std::atomic<bool> failed(false);
+    QMutex error_mutex;
+    QString error;
+    QSemaphore done_semaphore;
+
+    auto set_error = [&](const QString &new_error) {
+        QMutexLocker locker(&error_mutex);
+
+        // NOTE: only keep first error, others are often
+        // caused by it
+        if (error.isEmpty()) {
+            error = new_error;
+        }
+
+        failed = true;
+    };
+
+    // NOTE: workers take indexes from a shared counter
+    // instead of getting fixed ranges, so that one slow
+    // folder doesn't hold up the rest
+    const int runner_count = std::min(count, pool.maxThreadCount());
+
+    for (int i = 0; i < runner_count; i++) {
+        pool.start([&]() {
+            SMBContext *context = acquire_context();
+
+            if (context != nullptr) {
+                while (!failed) {
+                    const int index = next_index++;
+                    if (index >= count) {
+                        break;
+                    }
+
+                    const QString task_error = task(context, index);
+                    if (!task_error.isEmpty()) {
+                        set_error(task_error);
+                    }
+                }
+
+                release_context(context);
+            } else {
+                set_error(tr("Failed to initialize SMB context."));
+            }
+
+            done_semaphore.release();
+        });
+    }
+
+    done_semaphore.acquire(runner_count);
+
+    if (failed && error_out != nullptr) {
+        *error_out = error;
+    }
+
+    return !failed;
+}
+
+bool GptWalker::run_by_depth(const QList<GptEntry> &entry_list, const QList<int> &depth_list, const std::function<QString(SMBContext *context, const GptEntry &entry)> &task, QString *error_out) {
+    for (const int depth : depth_list) {
+        QList<GptEntry> level_list;
+        for (const GptEntry &entry : entry_list) {
+            if (entry.depth == depth) {
+                level_list.append(entry);
+            }
+        }
+
+        auto level_task = [&](SMBContext *context, const int index) {
+            return task(context, level_list.at(index));
+        };
+
+        const bool success = run_parallel(level_list.size(), level_task, error_out);
+        if (!success) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+SMBContext *GptWalker::acquire_context() {
+    {
+        QMutexLocker locker(&context_mutex);
+
+        if (!idle_context_list.isEmpty()) {
+            return idle_context_list.takeLast();
+        }
+    }
+
+    // NOTE: create new context outside of lock, since it
+    // may take a while. Don't make it current, global
+    // context is used by AdInterface.
+    SMBContext *context = new SMBContext(false);
+
+    if (!context->is_valid()) {
+        delete context;
+
+        return nullptr;
+    }
+
+    return context;
+}
+
+void GptWalker::release_context(SMBContext *context) {
+    QMutexLocker locker(&context_mutex);
+
+    // NOTE: pool size may have been lowered, free extra
+    // contexts instead of keeping them
+    if (idle_context_list.size() >= pool.maxThreadCount()) {
+        delete context;
+    } else {
+        idle_context_list.append(context);
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GPT_WALKER_H
+#define GPT_WALKER_H
+
+/**
+ * Walks and modifies GPT (policy folder in sysvol)
+ * contents in parallel. Work is spread over a bounded pool
+ * of worker threads, each with it's own SMB context, since
+ * one SMB context can't be used by multiple threads at the
+ * same time. Contexts are kept between walks, so that
+ * workers don't have to reconnect every time.
+ *
+ * Directories are walked level by level and entry types
+ * are taken from directory listing, so there's no need to
+ * stat every entry. Operations that depend on parent
+ * folders being processed first, like setting permissions,
+ * are also done level by level.
+ */
+
+#include <QCoreApplication>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+
+#include <functional>
+
+class SMBContext;
+
+struct GptEntry {
+    QString path;
+    bool is_dir;
+    // Depth relative to the root path, root is at 0
+    int depth;
+};
+
+class GptWalker final {
+    Q_DECLARE_TR_FUNCTIONS(GptWalker)
+
+public:
+    static GptWalker *instance();
+
+    ~GptWalker();
+
+    GptWalker(const GptWalker &) = delete;
+    GptWalker &operator=(const GptWalker &) = delete;
+
+    // Returns all contents of the path, including the path
+    // itself, in order of increasing depth, so that parents
+    // always come before their children. Returns empty
+    // list on failure.
+    QList<GptEntry> list(const QString &root_path, QString *error_out);
+
+    // Sets extended attribute on all entries. Entries of
+    // one depth are processed only after all entries of
+    // lower depth are done. "entry_list" must be ordered
+    // by depth, like the output of list().
+    bool set_xattr(const QList<GptEntry> &entry_list, const QString &name, const QByteArray &value, QString *error_out);
+
+    // Deletes all entries. Files are deleted first, then
+    // folders, starting from deepest ones.
+    bool remove(const QList<GptEntry> &entry_list, QString *error_out);
+
+    // Gets extended attribute of one path. Uses a context
+    // from the pool, so may be called from multiple
+    // threads at the same time.
+    bool get_xattr(const QString &path, const QString &name, QByteArray *value_out, QString *error_out);
+
+    // Frees all idle SMB contexts. Should be called when
+    // credentials change.
+    void invalidate();
+
+    int worker_count() const;
+    void set_worker_count(const int count);
+
+private:
+    GptWalker();
+
+    QThreadPool pool;
+    QMutex context_mutex;
+    QList<SMBContext *> idle_context_list;
+
+    // Calls "task" for every index in [0, count) from pool
+    // workers and waits until all calls are done. Task
+    // returns an error string or empty string on success.
+    // Stops at first error.
+    bool run_parallel(const int count, const std::function<QString(SMBContext *context, const int index)> &task, QString *error_out);
+
+    // Runs "task" for entries of "entry_list" at each
+    // depth, in the order given by "depth_list"
+    bool run_by_depth(const QList<GptEntry> &entry_list, const QList<int> &depth_list, const std::function<QString(SMBContext *context, const GptEntry &entry)> &task, QString *error_out);
+
+    SMBContext *acquire_context();
+    void release_context(SMBContext *context);
+};
+
+#endif /* GPT_WALKER_H */
@@ -18,6 +18,7 @@
  */
 
 #include "krb5client.h"
+#include "ad_connection_pool.h"
 #include <krb5.h>
 #include <stdexcept>
 #include <QCoreApplication>
@@ -179,6 +180,10 @@ void Krb5Client::Krb5ClientImpl::kinit(const QString &principal, const QString &
     cleanup(nullptr, &creds, princ, nullptr);
 
     curr_principal = principal;
+
+    // Pooled connections are bound with previous
+    // credentials
+    AdConnectionPool::instance()->invalidate();
 }
 
 void Krb5Client::Krb5ClientImpl::load_caches() {
@@ -427,6 +432,8 @@ void Krb5Client::set_current_principal(const QString &principal) {
     }
 
     impl->curr_principal = principal;
+
+    AdConnectionPool::instance()->invalidate();
 }
 
 void Krb5Client::refresh_tgt(const QString &principal) {
@@ -514,6 +521,8 @@ void Krb5Client::logout(bool delete_creds) {
     }
 
     impl->curr_principal = QString();
+
+    AdConnectionPool::instance()->invalidate();
 }
 
 void Krb5Client::update_temp_caches(const QStringList &remembered_principals) {
@@ -21,8 +21,8 @@
 
 #include <libsmbclient.h>
 
-SMBContext::SMBContext() : smb_ctx_ptr(createContext(), freeContext) {
-    if (is_valid()) {
+SMBContext::SMBContext(const bool make_current) : smb_ctx_ptr(createContext(), freeContext) {
+    if (is_valid() && make_current) {
         smbc_set_context(smb_ctx_ptr.get());
     }
 }
@@ -35,7 +35,43 @@ int SMBContext::smbcGetxattr(const char *fname, const char *name, const void *va
     return smbc_getFunctionGetxattr(smb_ctx_ptr.get())(smb_ctx_ptr.get(), fname, name, value, size);
 }
 
+int SMBContext::smbcSetxattr(const char *fname, const char *name, const void *value, size_t size, int flags) {
+    return smbc_getFunctionSetxattr(smb_ctx_ptr.get())(smb_ctx_ptr.get(), fname, name, value, size, flags);
+}
+
+SMBCFILE *SMBContext::smbcOpendir(const char *fname) {
+    return smbc_getFunctionOpendir(smb_ctx_ptr.get())(smb_ctx_ptr.get(), fname);
+}
+
+struct smbc_dirent *SMBContext::smbcReaddir(SMBCFILE *dir) {
+    return smbc_getFunctionReaddir(smb_ctx_ptr.get())(smb_ctx_ptr.get(), dir);
+}
+
+int SMBContext::smbcClosedir(SMBCFILE *dir) {
+    return smbc_getFunctionClosedir(smb_ctx_ptr.get())(smb_ctx_ptr.get(), dir);
+}
+
+int SMBContext::smbcUnlink(const char *fname) {
+    return smbc_getFunctionUnlink(smb_ctx_ptr.get())(smb_ctx_ptr.get(), fname);
+}
+
+int SMBContext::smbcRmdir(const char *fname) {
+    return smbc_getFunctionRmdir(smb_ctx_ptr.get())(smb_ctx_ptr.get(), fname);
+}
+
 SMBCCTX *SMBContext::createContext() {
+    // NOTE: libsmbclient needs to be told to use locks
+    // before any context is created, because contexts are
+    // used from multiple threads. This is done here and
+    // not at startup because the shared context of
+    // AdInterface is created during static initialization.
+    static const bool thread_init_done = []() {
+        smbc_thread_posix();
+
+        return true;
+    }();
+    (void) thread_init_done;
+
     SMBCCTX* newContext = smbc_new_context();
 
     if (newContext) {
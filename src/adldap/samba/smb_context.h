@@ -23,13 +23,19 @@
 #include <memory>
 
 typedef struct _SMBCCTX SMBCCTX;
+typedef struct _SMBCFILE SMBCFILE;
+struct smbc_dirent;
 
 const int SMB_FREE_EVEN_IF_BUSY = 1;
 const int SMB_DEBUG_LEVEL = 5;
 
 class SMBContext {
 public:
-    SMBContext();
+    // NOTE: libsmbclient's smbc_*() f-ns use one global
+    // context. Pass "make_current" = false to create a
+    // separate context which is only used through member
+    // f-ns, for example by worker threads.
+    explicit SMBContext(const bool make_current = true);
     ~SMBContext() = default;
 
     SMBContext(const SMBContext&) = delete;
@@ -41,6 +47,12 @@ public:
     bool is_valid() const;
 
     int smbcGetxattr(const char *fname, const char *name, const void *value, size_t size);
+    int smbcSetxattr(const char *fname, const char *name, const void *value, size_t size, int flags);
+    SMBCFILE *smbcOpendir(const char *fname);
+    struct smbc_dirent *smbcReaddir(SMBCFILE *dir);
+    int smbcClosedir(SMBCFILE *dir);
+    int smbcUnlink(const char *fname);
+    int smbcRmdir(const char *fname);
 
 private:
     SMBCCTX* createContext();
@@ -30,6 +30,7 @@
 #include "core/fsmo.h"
 #include "core/globals.h"
 #include "gplink.h"
+#include "ui/dialog/gpo_perms_audit.h"
 #include "ui/status.h"
 #include "utils.h"
 #include "fsmo/fsmo_utils.h"
@@ -45,10 +46,14 @@ AllPoliciesFolderImpl::AllPoliciesFolderImpl(ConsoleWidget *console_arg)
     set_results_view(new ResultsView(console_arg));
 
     create_policy_action = new QAction(tr("Create policy"), this);
+    audit_permissions_action = new QAction(tr("Audit permissions..."), this);
 
     connect(
         create_policy_action, &QAction::triggered,
         this, &AllPoliciesFolderImpl::create_policy);
+    connect(
+        audit_permissions_action, &QAction::triggered,
+        this, &AllPoliciesFolderImpl::audit_permissions);
 }
 
 void AllPoliciesFolderImpl::fetch(const QModelIndex &index) {
@@ -77,6 +82,7 @@ QList<QAction *> AllPoliciesFolderImpl::get_all_custom_actions() const {
     QList<QAction *> out;
 
     out.append(create_policy_action);
+    out.append(audit_permissions_action);
 
     return out;
 }
@@ -88,6 +94,7 @@ QSet<QAction *> AllPoliciesFolderImpl::get_custom_actions(const QModelIndex &ind
     QSet<QAction *> out;
 
     out.insert(create_policy_action);
+    out.insert(audit_permissions_action);
 
     return out;
 }
@@ -158,6 +165,11 @@ void AllPoliciesFolderImpl::create_policy() {
         });
 }
 
+void AllPoliciesFolderImpl::audit_permissions() {
+    auto dialog = new GpoPermsAuditDialog(console);
+    dialog->open();
+}
+
 QModelIndex get_all_policies_folder_index(ConsoleWidget *console) {
     const QModelIndex policy_tree_root = get_policy_tree_root(console);
     const QModelIndex out = console->search_item(policy_tree_root, {ItemType_AllPoliciesFolder});
@@ -186,6 +198,9 @@ void AllPoliciesFolderImpl::retranslate_ui() {
     if (create_policy_action != nullptr) {
         create_policy_action->setText(tr("Create policy"));
     }
+    if (audit_permissions_action != nullptr) {
+        audit_permissions_action->setText(tr("Audit permissions..."));
+    }
 }
 
 bool AllPoliciesFolderImpl::event(QEvent *event) {
@@ -54,8 +54,10 @@ public:
 
 private:
     QAction *create_policy_action;
+    QAction *audit_permissions_action;
 
     void create_policy();
+    void audit_permissions();
 };
 
 QModelIndex get_all_policies_folder_index(ConsoleWidget *console);
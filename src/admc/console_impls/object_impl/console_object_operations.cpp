@@ -21,13 +21,16 @@
 
 #include <QMessageBox>
 #include <QModelIndex>
+#include <QPointer>
 #include <QStandardItem>
 
 #include "ad_object.h"
+#include "ad_write_queue.h"
 #include "console_impls/find_object_impl.h"
 #include "console_impls/item_type.h"
 #include "console_impls/object_impl/console_object_operations.h"
 #include "console_impls/object_impl/object_impl.h"
+#include "console_impls/object_impl/object_results_model.h"
 #include "console_impls/object_impl/server_dn_attrs_updater.h"
 #include "console_impls/object_impl/site_dn_attrs_updater.h"
 #include "console_impls/policy_ou_impl.h"
@@ -61,6 +64,14 @@
 #include "ui/status.h"
 #include "utils.h"
 
+// Searches of console objects that are running or paused,
+// waiting for more results to be requested. Keyed by
+// search thread id.
+QHash<int, QPointer<SearchThread>> console_search_thread_map;
+
+SearchThread *get_item_search_thread(const QModelIndex &index);
+void set_item_fetching(QStandardItem *item, const bool fetching);
+
 void ConsoleObjectTreeOperations::console_object_move_and_rename(const QList<ConsoleWidget *> &console_list,
                                                       AdInterface &ad,
                                                       const QHash<QString, QString> &old_to_new_dn_map_arg,
@@ -231,6 +242,83 @@ void ConsoleObjectTreeOperations::console_object_delete_dn_list(ConsoleWidget *c
             console->delete_item(index);
         }
     }
+
+    // NOTE: results of containers are not under tree
+    // root in console, they are in results model
+    ObjectResultsModel *results_model = ObjectResultsModel::get(console);
+    if (results_model != nullptr && type == ItemType_Object) {
+        results_model->remove_dn_list(dn_list);
+    }
+}
+
+void ConsoleObjectTreeOperations::console_object_apply_changes(ConsoleWidget *console, const QList<AdObject> &object_list, const bool add_new_objects) {
+    const QModelIndex object_root = get_domain_object_tree_root(console);
+    if (!object_root.isValid()) {
+        return;
+    }
+
+    ObjectResultsModel *results_model = ObjectResultsModel::get(console);
+
+    for (const AdObject &object : object_list) {
+        const QString guid = object.get_value(ATTRIBUTE_OBJECT_GUID).toHex();
+        if (guid.isEmpty()) {
+            continue;
+        }
+
+        // NOTE: item's DN may be outdated if object was
+        // moved or renamed, so find item by GUID. Objects
+        // that are not containers have no items in
+        // console, so look for them in results model.
+        const QModelIndex old_index = console->search_item(object_root, ObjectRole_GUID, guid, {ItemType_Object});
+        QString old_dn = old_index.data(ObjectRole_DN).toString();
+        if (old_dn.isEmpty() && results_model != nullptr) {
+            old_dn = results_model->find_dn_by_guid(guid);
+        }
+        const bool is_in_tree = !old_dn.isEmpty();
+        const QString new_dn = object.get_dn();
+
+        const bool is_deleted = object.get_bool(ATTRIBUTE_IS_DELETED);
+        if (is_deleted) {
+            if (is_in_tree) {
+                console_object_delete_dn_list(console, {old_dn}, object_root, ItemType_Object, ObjectRole_DN);
+            }
+
+            continue;
+        }
+
+        // Modified. Reload rows in all trees, including
+        // query and find trees.
+        if (is_in_tree && old_dn == new_dn) {
+            const QList<QModelIndex> index_list = console->search_items(QModelIndex(), ObjectRole_DN, new_dn, {ItemType_Object});
+            for (const QModelIndex &index : index_list) {
+                const QList<QStandardItem *> row = console->get_row(index);
+                console_object_load(row, object);
+            }
+
+            if (results_model != nullptr) {
+                results_model->update_objects({object});
+            }
+
+            continue;
+        }
+
+        if (!is_in_tree && !add_new_objects) {
+            continue;
+        }
+
+        // Added, moved or renamed. Same as in
+        // console_object_move_and_rename(), add new item
+        // before deleting the old one. If new parent
+        // isn't in the tree or wasn't fetched, object is
+        // only removed from it's old place.
+        const QString new_parent_dn = dn_get_parent(new_dn);
+        const QModelIndex new_parent_index = console->search_item(object_root, ObjectRole_DN, new_parent_dn, {ItemType_Object});
+        add_objects_to_console(console, {object}, new_parent_index);
+
+        if (is_in_tree) {
+            console_object_delete_dn_list(console, {old_dn}, object_root, ItemType_Object, ObjectRole_DN);
+        }
+    }
 }
 
 void ConsoleObjectTreeOperations::add_objects_to_console(ConsoleWidget *console, const QList<AdObject> &object_list, const QModelIndex &parent) {
@@ -246,23 +334,37 @@ void ConsoleObjectTreeOperations::add_objects_to_console(ConsoleWidget *console,
         return;
     }
 
+    // NOTE: "containers" referenced here don't mean
+    // objects with "container" object class.
+    // Instead it means all the objects that can
+    // have children(some of which are not
+    // "container" class).
+    const QList<QString> filter_containers =
+        g_adconfig->get_filter_containers();
+    const QList<QString> site_related_classes =
+        g_adconfig->get_site_related_classes();
+    const bool show_non_containers_ON =
+        settings_get_bool(SETTING_show_non_containers_in_console_tree);
+
+    // NOTE: if console has a results model, all objects
+    // are displayed in results from it and console only
+    // gets scope items
+    ObjectResultsModel *results_model = ObjectResultsModel::get(console);
+
+    // NOTE: load rows before adding them to console and
+    // then add all of them at once. Adding and loading
+    // rows one by one is very slow for large containers.
+    QList<QList<QStandardItem *>> row_list;
+    QList<QStandardItem *> site_item_list;
+
     for (const AdObject &object : object_list) {
         if (object.is_empty())
             continue;
-        // NOTE: "containers" referenced here don't mean
-        // objects with "container" object class.
-        // Instead it means all the objects that can
-        // have children(some of which are not
-        // "container" class).
         const QString object_class = object.get_string(ATTRIBUTE_OBJECT_CLASS);
-        const QList<QString> filter_containers =
-            g_adconfig->get_filter_containers();
         const bool is_container =
             filter_containers.contains(object_class);
-        const bool show_non_containers_ON =
-            settings_get_bool(SETTING_show_non_containers_in_console_tree);
         const bool is_site_related =
-            g_adconfig->get_site_related_classes().contains(object_class);
+            site_related_classes.contains(object_class);
 
         const bool should_be_in_scope =
             (is_container ||
@@ -272,16 +374,30 @@ void ConsoleObjectTreeOperations::add_objects_to_console(ConsoleWidget *console,
 
         QList<QStandardItem *> row;
         if (should_be_in_scope) {
-            row = console->add_scope_item(ItemType_Object, parent);
+            row = console->make_scope_row(ItemType_Object, parent);
+        } else if (results_model == nullptr) {
+            row = console->make_results_row(ItemType_Object, parent);
         } else {
-            row = console->add_results_item(ItemType_Object, parent);
+            continue;
         }
 
-        if (object.get_string(ATTRIBUTE_OBJECT_CLASS) == CLASS_SITE) {
-            console->set_item_sort_index(row[0]->index(), 1);
+        console_object_load(row, object);
+
+        row_list.append(row);
+
+        if (object_class == CLASS_SITE) {
+            site_item_list.append(row[0]);
         }
+    }
 
-        console_object_load(row, object);
+    console->add_rows(parent, row_list);
+
+    for (QStandardItem *site_item : site_item_list) {
+        console->set_item_sort_index(site_item->index(), 1);
+    }
+
+    if (results_model != nullptr) {
+        results_model->add_objects(parent, object_list);
     }
 }
 
@@ -297,39 +413,23 @@ void ConsoleObjectTreeOperations::add_objects_to_console_from_dn_list(ConsoleWid
 
 void ConsoleObjectTreeOperations::console_object_load(const QList<QStandardItem *> row, const AdObject &object) {
     // Load attribute columns
-    for (int i = 0; i < g_adconfig->get_columns().count(); i++) {
-        if (g_adconfig->get_columns().count() > row.size()) {
+    const QList<QString> columns = g_adconfig->get_columns();
+    for (int i = 0; i < columns.count(); i++) {
+        if (columns.count() > row.size()) {
             break;
         }
 
-        const QString attribute = g_adconfig->get_columns()[i];
+        const QString attribute = columns[i];
+
+        // NOTE: set sort key even if value has none, to
+        // clear key left from previous load of this row
+        row[i]->setData(console_object_sort_value(object, attribute), ConsoleRole_SortKey);
 
         if (!object.contains(attribute)) {
             continue;
         }
 
-        QString display_value;
-        if (attribute == ATTRIBUTE_OBJECT_CLASS) {
-            const QString object_class = object.get_string(attribute);
-
-            if (object_class == CLASS_GROUP) {
-                const GroupScope scope = object.get_group_scope();
-                const QString scope_string = group_scope_string(scope);
-
-                const GroupType type = object.get_group_type();
-                const QString type_string = group_type_string_adjective(type);
-
-                display_value =
-                    QString("%1 - %2").arg(type_string, scope_string);
-            } else {
-                display_value =
-                    g_adconfig->get_class_display_name(object_class);
-            }
-        } else {
-            const QByteArray value = object.get_value(attribute);
-            display_value =
-                attribute_display_value(attribute, value, g_adconfig);
-        }
+        const QString display_value = console_object_display_value(object, attribute);
         row[i]->setText(display_value);
     }
 
@@ -342,9 +442,44 @@ void ConsoleObjectTreeOperations::console_object_load(const QList<QStandardItem
     }
 }
 
+QString ConsoleObjectTreeOperations::console_object_display_value(const AdObject &object, const QString &attribute) {
+    if (attribute == ATTRIBUTE_OBJECT_CLASS) {
+        const QString object_class = object.get_string(attribute);
+
+        if (object_class == CLASS_GROUP) {
+            const GroupScope scope = object.get_group_scope();
+            const QString scope_string = group_scope_string(scope);
+
+            const GroupType type = object.get_group_type();
+            const QString type_string = group_type_string_adjective(type);
+
+            return QString("%1 - %2").arg(type_string, scope_string);
+        } else {
+            return g_adconfig->get_class_display_name(object_class);
+        }
+    } else {
+        const QByteArray value = object.get_value(attribute);
+
+        return attribute_display_value(attribute, value, g_adconfig);
+    }
+}
+
+QVariant ConsoleObjectTreeOperations::console_object_sort_value(const AdObject &object, const QString &attribute) {
+    if (attribute == ATTRIBUTE_OBJECT_CLASS || !object.contains(attribute)) {
+        return QVariant();
+    }
+
+    const QByteArray value = object.get_value(attribute);
+
+    return attribute_sort_value(attribute, value, g_adconfig);
+}
+
 void ConsoleObjectTreeOperations::console_object_item_data_load(QStandardItem *item, const AdObject &object) {
     item->setData(object.get_dn(), ObjectRole_DN);
 
+    const QString guid = object.get_value(ATTRIBUTE_OBJECT_GUID).toHex();
+    item->setData(guid, ObjectRole_GUID);
+
     const QList<QString> object_classes = object.get_strings(ATTRIBUTE_OBJECT_CLASS);
     item->setData(QVariant(object_classes), ObjectRole_ObjectClasses);
 
@@ -367,30 +502,27 @@ void ConsoleObjectTreeOperations::console_object_item_data_load(QStandardItem *i
 }
 
 void ConsoleObjectTreeOperations::console_object_item_load_icon(QStandardItem *item, bool disabled) {
-    auto set_item_icon = [item, disabled](const ItemIcon &disabled_icon,
-                                          const ItemIcon &enabled_icon) {
-        ItemIcon item_icon = disabled ? disabled_icon : enabled_icon;
-        item->setIcon(g_icon_manager->item_icon(item_icon));
-    };
-    auto set_category_icon = [item](auto &icon) {
-        item->setIcon(g_icon_manager->category_icon(icon));
-    };
-    const QString category = dn_get_name(item->data(ObjectRole_ObjectCategory).toString());
-
     if (item->data(ConsoleRole_Type).toInt() == ItemType_QueryItem) {
-        set_category_icon(ADMC_CATEGORY_QUERY_ITEM);
-    }
-    else if (category == OBJECT_CATEGORY_PERSON) {
-        set_item_icon(ItemIcon_Person_Blocked, ItemIcon_Person);
-    }
-    else if (category == OBJECT_CATEGORY_COMPUTER) {
-        set_item_icon(ItemIcon_Computer_Blocked, ItemIcon_Computer);
-    }
-    else if (category == OBJECT_CATEGORY_GROUP) {
-        item->setIcon(g_icon_manager->item_icon(ItemIcon_Group));
+        item->setIcon(g_icon_manager->category_icon(ADMC_CATEGORY_QUERY_ITEM));
+
+        return;
     }
-    else {
-        set_category_icon(category);
+
+    const QString object_category = item->data(ObjectRole_ObjectCategory).toString();
+    item->setIcon(console_object_icon(object_category, disabled));
+}
+
+QIcon ConsoleObjectTreeOperations::console_object_icon(const QString &object_category, const bool disabled) {
+    const QString category = dn_get_name(object_category);
+
+    if (category == OBJECT_CATEGORY_PERSON) {
+        return g_icon_manager->item_icon(disabled ? ItemIcon_Person_Blocked : ItemIcon_Person);
+    } else if (category == OBJECT_CATEGORY_COMPUTER) {
+        return g_icon_manager->item_icon(disabled ? ItemIcon_Computer_Blocked : ItemIcon_Computer);
+    } else if (category == OBJECT_CATEGORY_GROUP) {
+        return g_icon_manager->item_icon(ItemIcon_Group);
+    } else {
+        return g_icon_manager->category_icon(category);
     }
 }
 
@@ -406,16 +538,25 @@ void ConsoleObjectTreeOperations::console_object_search(ConsoleWidget *console,
 
     QStandardItem *item = console->get_item(index);
 
-    // Set icon to indicate that item is in "search" state
-    item->setIcon(g_icon_manager->item_icon(ItemIcon_Search_Indicator));
+    set_item_fetching(item, true);
 
-    // NOTE: need to set this role to disable actions during
-    // fetch
-    item->setData(true, ObjectRole_Fetching);
-    item->setDragEnabled(false);
+    // NOTE: stop previous search for this item, in case
+    // it's paused waiting for fetch more
+    SearchThread *prev_search_thread = get_item_search_thread(index);
+    if (prev_search_thread != nullptr) {
+        prev_search_thread->stop();
+    }
 
     auto search_thread = new SearchThread(base, scope, filter, attributes);
 
+    // NOTE: children search is loaded in chunks as results
+    // are scrolled, so that containers with more objects
+    // than display limit can still be browsed
+    const bool fetch_more_enabled = (scope == SearchScope_Children);
+    search_thread->set_fetch_more_enabled(fetch_more_enabled);
+
+    console_search_thread_map.insert(search_thread->get_id(), search_thread);
+
     // NOTE: change item's search thread, this will be used
     // later to handle situations where a thread is started
     // while another is running
@@ -459,10 +600,65 @@ void ConsoleObjectTreeOperations::console_object_search(ConsoleWidget *console,
             ConsoleObjectTreeOperations::add_objects_to_console(console, results.values(), persistent_index);
         },
         Qt::QueuedConnection);
+    QObject::connect(
+        search_thread, &SearchThread::progress,
+        console, &search_thread_display_progress,
+        Qt::QueuedConnection);
+    QObject::connect(
+        search_thread, &SearchThread::paused,
+        console,
+        [=]() {
+            if (!persistent_index.isValid()) {
+                search_thread->stop();
+
+                return;
+            }
+
+            QStandardItem *item_now = console->get_item(persistent_index);
+
+            const bool thread_id_match = search_id_matches(item_now, search_thread);
+            if (!thread_id_match) {
+                search_thread->stop();
+
+                return;
+            }
+
+            // NOTE: item is usable while search is paused
+            set_item_fetching(item_now, false);
+
+            search_thread_clear_progress();
+        },
+        Qt::QueuedConnection);
+    QObject::connect(
+        console, &QObject::destroyed,
+        search_thread, &SearchThread::stop,
+        Qt::DirectConnection);
+
+    // NOTE: paused search doesn't emit anything until it's
+    // resumed, so results/paused slots can't notice that
+    // item went away. Stop search when item or one of it's
+    // parents is removed, so that it's connection is freed
+    // right away instead of after pause timeout.
+    QObject::connect(
+        persistent_index.model(), &QAbstractItemModel::rowsAboutToBeRemoved,
+        search_thread,
+        [=](const QModelIndex &parent, int first, int last) {
+            for (QModelIndex current = persistent_index; current.isValid(); current = current.parent()) {
+                const bool is_removed = (current.parent() == parent && current.row() >= first && current.row() <= last);
+
+                if (is_removed) {
+                    search_thread->stop();
+
+                    return;
+                }
+            }
+        });
     QObject::connect(
         search_thread, &SearchThread::finished,
         console,
         [=]() {
+            search_thread_clear_progress();
+
             if (!persistent_index.isValid()) {
                 return;
             }
@@ -480,11 +676,20 @@ void ConsoleObjectTreeOperations::console_object_search(ConsoleWidget *console,
                 return;
             }
 
-            const bool is_disabled = item_now->data(ObjectRole_AccountDisabled).toBool();
-            console_object_item_load_icon(item_now, is_disabled);
+            set_item_fetching(item_now, false);
+        },
+        Qt::QueuedConnection);
 
-            item_now->setData(false, ObjectRole_Fetching);
-            item_now->setDragEnabled(true);
+    // NOTE: thread is deleted in a separate connection
+    // with thread as context, so that it's deleted even if
+    // console was destroyed before thread finished. This
+    // connection is made after the one above, so it runs
+    // after it.
+    QObject::connect(
+        search_thread, &SearchThread::finished,
+        search_thread,
+        [search_thread]() {
+            console_search_thread_map.remove(search_thread->get_id());
 
             search_thread->deleteLater();
         },
@@ -493,6 +698,29 @@ void ConsoleObjectTreeOperations::console_object_search(ConsoleWidget *console,
     search_thread->start();
 }
 
+bool ConsoleObjectTreeOperations::console_object_can_fetch_more(const QModelIndex &index) {
+    SearchThread *search_thread = get_item_search_thread(index);
+    if (search_thread == nullptr) {
+        return false;
+    }
+
+    const bool out = search_thread->can_fetch_more();
+
+    return out;
+}
+
+void ConsoleObjectTreeOperations::console_object_fetch_more(ConsoleWidget *console, const QModelIndex &index) {
+    SearchThread *search_thread = get_item_search_thread(index);
+    if (search_thread == nullptr || !search_thread->can_fetch_more()) {
+        return;
+    }
+
+    QStandardItem *item = console->get_item(index);
+    set_item_fetching(item, true);
+
+    search_thread->fetch_more();
+}
+
 QList<QString> ConsoleObjectTreeOperations::object_impl_column_labels() {
     QList<QString> out;
 
@@ -536,6 +764,10 @@ QList<QString> ConsoleObjectTreeOperations::console_object_search_attributes() {
     // NOTE: needed to know gpo status
     attributes += ATTRIBUTE_FLAGS;
 
+    // NOTE: needed to find items of objects that were
+    // moved or renamed outside of this app
+    attributes += ATTRIBUTE_OBJECT_GUID;
+
     return attributes;
 }
 
@@ -567,8 +799,15 @@ bool ConsoleObjectTreeOperations::console_object_deletion_dialog(ConsoleWidget *
 
     QString contains_objects_message;
     int not_empty_containers_count = 0;
+    ObjectResultsModel *results_model = ObjectResultsModel::get(console);
     for (QModelIndex index : index_deleted_list) {
-        if (index.model()->hasChildren(index)) {
+        // NOTE: children of fetched containers are in
+        // results model, scope items only contain
+        // other containers
+        const QString dn = index.data(ObjectRole_DN).toString();
+        const bool has_results = (results_model != nullptr && results_model->get_result_count(dn) > 0);
+
+        if (has_results || index.model()->hasChildren(index)) {
             ++not_empty_containers_count;
         }
     }
@@ -602,7 +841,11 @@ void ConsoleObjectTreeOperations::console_tree_add_password_settings(ConsoleWidg
 }
 
 QString ConsoleObjectTreeOperations::console_object_count_string(ConsoleWidget *console, const QModelIndex &index) {
-    const int count = console->get_child_count(index);
+    // NOTE: results of object containers are in results
+    // model
+    ObjectResultsModel *results_model = ObjectResultsModel::get(console);
+    const int results_count = (results_model != nullptr) ? results_model->get_result_count(index) : -1;
+    const int count = (results_count != -1) ? results_count : console->get_child_count(index);
     const QString out = QCoreApplication::translate("object_impl", "%n object(s)", "", count);
 
     return out;
@@ -756,61 +999,72 @@ void ConsoleObjectTreeOperations::console_object_delete(const QList<ConsoleWidge
         return;
     }
 
-    AdInterface ad;
-    if (ad_failed(ad, console_list[0])) {
-        return;
-    }
-
-    show_busy_indicator();
-
-    QList<QString> deleted_list;
-
+    QList<AdWriteOperation> operation_list;
+    QHash<QString, QString> dn_to_class_map;
     for (const QModelIndex &idx : index_list) {
         const QString target_dn = idx.data(dn_role).toString();
         const QStringList obj_classes = idx.data(ObjectRole_ObjectClasses).toStringList();
         const QString obj_class = obj_classes.isEmpty() ? QString() : obj_classes.last();
 
-        const bool success = ad.object_delete(target_dn);
-        if (success) {
-            if (obj_class == CLASS_SITE) {
-                SiteDnAttrsUpdater(target_dn).update_for_delete(ad);
-            } else if (obj_class == CLASS_SERVER) {
-                ServerDnAttrsUpdater(target_dn).update_for_delete(ad);
-            }
-
-            deleted_list.append(target_dn);
-        }
+        operation_list.append(AdWriteOperation::make_delete(target_dn));
+        dn_to_class_map[target_dn] = obj_class;
     }
 
+    const QString label = QCoreApplication::translate("ObjectImpl", "Deleting objects...");
 
-    auto apply_changes = [&deleted_list](ConsoleWidget *target_console) {
-        const QList<QModelIndex> root_list = {
-            get_domain_object_tree_root(target_console),
-            get_pso_container_tree_root(target_console),
-            get_sites_container_tree_root(target_console),
-            get_query_tree_root(target_console),
-            get_find_object_root(target_console),
-        };
-
-        for (const QModelIndex &root : root_list) {
-            if (root.isValid()) {
-                ConsoleObjectTreeOperations::console_object_delete_dn_list(target_console, deleted_list, root, ItemType_Object, ObjectRole_DN);
+    // NOTE: objects are deleted in a background thread, console
+    // is updated after all of them are processed
+    write_thread_start(operation_list, label, console_list[0],
+        [console_list, operation_list, dn_to_class_map](const QList<bool> &result_list) {
+            QList<QString> deleted_list;
+            for (int i = 0; i < operation_list.size(); i++) {
+                if (result_list[i]) {
+                    deleted_list.append(operation_list[i].dn);
+                }
             }
-        }
 
-        const QModelIndex policy_root = get_policy_tree_root(target_console);
-        if (policy_root.isValid()) {
-            ConsoleObjectTreeOperations::console_object_delete_dn_list(target_console, deleted_list, policy_root, ItemType_PolicyOU, PolicyOURole_DN);
-        }
-    };
+            // Fix dn attrs of objects that referenced
+            // deleted sites and servers
+            AdInterface ad;
+            if (ad.is_connected()) {
+                for (const QString &target_dn : deleted_list) {
+                    const QString obj_class = dn_to_class_map[target_dn];
+
+                    if (obj_class == CLASS_SITE) {
+                        SiteDnAttrsUpdater(target_dn).update_for_delete(ad);
+                    } else if (obj_class == CLASS_SERVER) {
+                        ServerDnAttrsUpdater(target_dn).update_for_delete(ad);
+                    }
+                }
 
-    for (ConsoleWidget *console : console_list) {
-        apply_changes(console);
-    }
+                g_status->display_ad_messages(ad, console_list[0]);
+            }
+
+            auto apply_changes = [&deleted_list](ConsoleWidget *target_console) {
+                const QList<QModelIndex> root_list = {
+                    get_domain_object_tree_root(target_console),
+                    get_pso_container_tree_root(target_console),
+                    get_sites_container_tree_root(target_console),
+                    get_query_tree_root(target_console),
+                    get_find_object_root(target_console),
+                };
+
+                for (const QModelIndex &root : root_list) {
+                    if (root.isValid()) {
+                        ConsoleObjectTreeOperations::console_object_delete_dn_list(target_console, deleted_list, root, ItemType_Object, ObjectRole_DN);
+                    }
+                }
 
-    hide_busy_indicator();
+                const QModelIndex policy_root = get_policy_tree_root(target_console);
+                if (policy_root.isValid()) {
+                    ConsoleObjectTreeOperations::console_object_delete_dn_list(target_console, deleted_list, policy_root, ItemType_PolicyOU, PolicyOURole_DN);
+                }
+            };
 
-    g_status->display_ad_messages(ad, console_list[0]);
+            for (ConsoleWidget *console : console_list) {
+                apply_changes(console);
+            }
+        });
 }
 
 void ConsoleObjectTreeOperations::console_object_properties(const QList<ConsoleWidget *> &console_list, const QList<QModelIndex> &index_list, const int dn_role, const QList<QString> &class_list) {
@@ -872,6 +1126,11 @@ void ConsoleObjectTreeOperations::console_object_properties(const QList<ConsoleW
             apply_changes_to_branch(query_root, ItemType_Object, ObjectRole_DN);
             apply_changes_to_branch(find_object_root, ItemType_Object, ObjectRole_DN);
 
+            ObjectResultsModel *results_model = ObjectResultsModel::get(target_console);
+            if (results_model != nullptr) {
+                results_model->update_objects(object_list);
+            }
+
             // Apply to policy branch
             if (policy_root.isValid()) {
                 for (const AdObject &object : object_list) {
@@ -1003,3 +1262,29 @@ QModelIndex ConsoleObjectTreeOperations::get_sites_container_tree_root(ConsoleWi
 QModelIndex ConsoleObjectTreeOperations::get_pso_container_tree_root(ConsoleWidget *console) {
     return get_object_tree_root(console, g_adconfig->pso_container_dn());
 }
+
+SearchThread *get_item_search_thread(const QModelIndex &index) {
+    const QVariant id_variant = index.data(MyConsoleRole_SearchThreadId);
+    if (!id_variant.isValid()) {
+        return nullptr;
+    }
+
+    SearchThread *out = console_search_thread_map.value(id_variant.toInt());
+
+    return out;
+}
+
+void set_item_fetching(QStandardItem *item, const bool fetching) {
+    if (fetching) {
+        // Set icon to indicate that item is in "search" state
+        item->setIcon(g_icon_manager->item_icon(ItemIcon_Search_Indicator));
+    } else {
+        const bool is_disabled = item->data(ObjectRole_AccountDisabled).toBool();
+        ConsoleObjectTreeOperations::console_object_item_load_icon(item, is_disabled);
+    }
+
+    // NOTE: need to set this role to disable actions during
+    // fetch
+    item->setData(fetching, ObjectRole_Fetching);
+    item->setDragEnabled(!fetching);
+}
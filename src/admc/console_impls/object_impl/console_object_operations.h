@@ -32,6 +32,8 @@ class QString;
 class AdInterface;
 class AdObject;
 class QStandardItem;
+class QIcon;
+class QVariant;
 template<typename T> class QList;
 template<typename K, typename V> class QHash;
 class CreateObjectDialog;
@@ -42,6 +44,14 @@ namespace ConsoleObjectTreeOperations {
     void console_object_move_and_rename(const QList<ConsoleWidget *> &console_list, AdInterface &ad, const QHash<QString, QString> &old_to_new_dn_map_arg, const QString &new_parent_dn);
 
 
+    // Applies changes made outside of this app to object
+    // tree. Objects are matched to items by GUID, so that
+    // moved and renamed objects are found by their old
+    // DN. Deleted objects must have isDeleted set. Objects
+    // that aren't in the tree yet are added only if
+    // "add_new_objects" is true.
+    void console_object_apply_changes(ConsoleWidget *console, const QList<AdObject> &object_list, const bool add_new_objects);
+
     void add_objects_to_console(ConsoleWidget *console, const QList<AdObject> &object_list, const QModelIndex &parent);
     // Helper f-n that searches for objects and then adds them
     void add_objects_to_console_from_dn_list(ConsoleWidget *console, AdInterface &ad, const QList<QString> &dn_list, const QModelIndex &parent);
@@ -50,12 +60,24 @@ namespace ConsoleObjectTreeOperations {
     void console_object_item_data_load(QStandardItem *item, const AdObject &object);
     void console_object_item_load_icon(QStandardItem *item, bool disabled);
 
+    // Values displayed in object columns, shared by console
+    // items and object results model
+    QString console_object_display_value(const AdObject &object, const QString &attribute);
+    QVariant console_object_sort_value(const AdObject &object, const QString &attribute);
+    QIcon console_object_icon(const QString &object_category, const bool disabled);
+
     // NOTE: it is possible for a search to start while a
     // previous one hasn't finished. For that reason, this f-n
     // contains multiple workarounds for issues caused by that
     // case.
     void console_object_search(ConsoleWidget *console, const QModelIndex &index, const QString &base, const SearchScope scope, const QString &filter, const QList<QString> &attributes);
 
+    // Children searches pause after loading object display
+    // limit's worth of objects. These f-ns check whether
+    // search for given item is paused and continue it.
+    bool console_object_can_fetch_more(const QModelIndex &index);
+    void console_object_fetch_more(ConsoleWidget *console, const QModelIndex &index);
+
     QList<QString> object_impl_column_labels();
     QList<int> object_impl_default_columns();
     QList<QString> console_object_search_attributes();
@@ -27,6 +27,7 @@
 #include "ui/dialog/console_filter.h"
 #include "console_impls/find_object_impl.h"
 #include "console_impls/item_type.h"
+#include "console_impls/object_impl/object_results_model.h"
 #include "console_impls/policy_ou_impl.h"
 #include "console_impls/policy_root_impl.h"
 #include "console_impls/query_folder_impl.h"
@@ -43,6 +44,7 @@
 #include "tabs/general_user_tab.h"
 #include "tabs/general_group_tab.h"
 #include "core/managers/icon_manager.h"
+#include "core/notification_thread.h"
 #include "results_widgets/pso_results_widget/pso_results_widget.h"
 #include "results_widgets/subnet_results_widget/subnet_results_widget.h"
 
@@ -52,6 +54,7 @@
 #include <QStandardItemModel>
 #include <QStackedWidget>
 #include <QMessageBox>
+#include <QPointer>
 
 #include <algorithm>
 #include "drag_n_drop.h"
@@ -63,6 +66,10 @@ ObjectImpl::ObjectImpl(ConsoleWidget *console_arg)
         console,
     };
 
+    notification_thread = nullptr;
+
+    console->add_search_index(ObjectRole_DN);
+
     setup_widgets();
 
     setup_filters();
@@ -77,11 +84,46 @@ void ObjectImpl::set_buddy_console(ConsoleWidget *buddy_console) {
     };
 }
 
+ObjectImpl::~ObjectImpl() {
+    set_live_updates_enabled(false);
+}
+
+void ObjectImpl::set_live_updates_enabled(const bool enabled) {
+    if (enabled && notification_thread == nullptr) {
+        QList<QString> attributes = ConsoleObjectTreeOperations::console_object_search_attributes();
+        attributes += ATTRIBUTE_IS_DELETED;
+        attributes += ATTRIBUTE_SHOW_IN_ADVANCED_VIEW_ONLY;
+
+        // NOTE: changed objects are matched to items by GUID
+        console->add_search_index(ObjectRole_GUID);
+
+        notification_thread = new NotificationThread(attributes, this);
+
+        connect(
+            notification_thread, &NotificationThread::objects_changed,
+            this, &ObjectImpl::on_objects_changed,
+            Qt::QueuedConnection);
+
+        notification_thread->set_container_list(watched_container_list);
+        notification_thread->start();
+    } else if (!enabled && notification_thread != nullptr) {
+        // NOTE: thread checks for stop often, so this
+        // doesn't block for long
+        notification_thread->stop();
+        notification_thread->wait();
+
+        delete notification_thread;
+        notification_thread = nullptr;
+    }
+}
+
 // Load children of this item in scope tree
 // and load results linked to this scope item
 void ObjectImpl::fetch(const QModelIndex &index) {
     const QString base = index.data(ObjectRole_DN).toString();
 
+    object_results_model->clear_container(index);
+
     const SearchScope scope = SearchScope_Children;
 
     //
@@ -120,6 +162,16 @@ void ObjectImpl::fetch(const QModelIndex &index) {
     }
 
     ConsoleObjectTreeOperations::console_object_search(console, index, base, scope, filter, attributes);
+
+    watch_container(base);
+}
+
+bool ObjectImpl::can_fetch_more(const QModelIndex &index) const {
+    return ConsoleObjectTreeOperations::console_object_can_fetch_more(index);
+}
+
+void ObjectImpl::fetch_more(const QModelIndex &index) {
+    ConsoleObjectTreeOperations::console_object_fetch_more(console, index);
 }
 
 bool ObjectImpl::can_drop(const QList<QPersistentModelIndex> &dropped_list, const QSet<int> &dropped_type_list, const QPersistentModelIndex &target, const int target_type) {
@@ -160,23 +212,23 @@ void ObjectImpl::drop(const QList<QPersistentModelIndex> &dropped_list, const QS
 
     show_busy_indicator();
 
+    // NOTE: dropped objects are moved and added to group
+    // in batches after the loop
+    QList<QString> move_list;
+    QList<QString> add_to_group_list;
+
     for (const QPersistentModelIndex &dropped : dropped_list) {
         const QString dropped_dn = dropped.data(ObjectRole_DN).toString();
         const ObjectDragDrop::DropType drop_type = ObjectDragDrop::console_object_get_drop_type(dropped, target);
 
         switch (drop_type) {
             case ObjectDragDrop::DropType_Move: {
-                const bool move_success = ad.object_move(dropped_dn,
-                    target_dn);
-
-                if (move_success) {
-                    move(ad, QList<QString>({dropped_dn}), target_dn);
-                }
+                move_list.append(dropped_dn);
 
                 break;
             }
             case ObjectDragDrop::DropType_AddToGroup: {
-                ad.group_add_member(target_dn, dropped_dn);
+                add_to_group_list.append(dropped_dn);
 
                 break;
             }
@@ -186,9 +238,17 @@ void ObjectImpl::drop(const QList<QPersistentModelIndex> &dropped_list, const QS
         }
     }
 
+    if (!add_to_group_list.isEmpty()) {
+        ad.group_add_members(target_dn, add_to_group_list);
+    }
+
     hide_busy_indicator();
 
     g_status->display_ad_messages(ad, console);
+
+    if (!move_list.isEmpty()) {
+        start_move(move_list, target_dn);
+    }
 }
 
 QString ObjectImpl::get_description(const QModelIndex &index) const {
@@ -206,6 +266,21 @@ QString ObjectImpl::get_description(const QModelIndex &index) const {
 }
 
 void ObjectImpl::activate(const QModelIndex &index) {
+    // NOTE: results model doesn't contain scope items, so
+    // activated containers are opened by finding their
+    // scope item
+    if (index.model() == object_results_model) {
+        const QString dn = index.data(ObjectRole_DN).toString();
+        const QModelIndex current_scope = console->get_current_scope_item();
+        const QModelIndex scope_index = console->search_item(current_scope, ObjectRole_DN, dn, {ItemType_Object});
+
+        if (scope_index.isValid() && scope_index != current_scope) {
+            console->set_current_scope(scope_index);
+
+            return;
+        }
+    }
+
     properties({index});
 }
 
@@ -516,6 +591,45 @@ void ObjectImpl::update_results_widget(const QModelIndex &index) const {
     }
 }
 
+// Moves container to the front of watched list. Only the
+// most recently fetched containers are watched.
+void ObjectImpl::watch_container(const QString &dn) {
+    watched_container_list.removeAll(dn);
+    watched_container_list.prepend(dn);
+
+    const int max_count = NotificationThread::max_container_count();
+    if (watched_container_list.size() > max_count) {
+        watched_container_list = watched_container_list.mid(0, max_count);
+    }
+
+    if (notification_thread != nullptr) {
+        notification_thread->set_container_list(watched_container_list);
+    }
+}
+
+void ObjectImpl::on_objects_changed(const QHash<QString, AdObject> &objects) {
+    // NOTE: user's object filter can't be evaluated on the
+    // client, so with filter enabled new objects are not
+    // added, they will appear after refresh
+    const bool advanced_features_OFF = !settings_get_bool(SETTING_advanced_features);
+
+    QList<AdObject> object_list;
+    for (const AdObject &object : objects) {
+        const bool is_hidden = (advanced_features_OFF && object.get_bool(ATTRIBUTE_SHOW_IN_ADVANCED_VIEW_ONLY));
+        if (is_hidden) {
+            continue;
+        }
+
+        object_list.append(object);
+    }
+
+    const bool add_new_objects = !object_filter_enabled;
+
+    for (ConsoleWidget *target_console : console_list) {
+        ConsoleObjectTreeOperations::console_object_apply_changes(target_console, object_list, add_new_objects);
+    }
+}
+
 void ObjectImpl::set_find_action_enabled(const bool enabled) {
     find_action_enabled = enabled;
 }
@@ -548,6 +662,12 @@ QList<int> ObjectImpl::default_columns() const {
     return ConsoleObjectTreeOperations::object_impl_default_columns();
 }
 
+ConsoleResultsModel *ObjectImpl::results_model(const QModelIndex &index) const {
+    Q_UNUSED(index);
+
+    return object_results_model;
+}
+
 void ObjectImpl::refresh_tree() {
     const QModelIndex object_tree_root = ConsoleObjectTreeOperations::get_domain_object_tree_root(console);
     if (!object_tree_root.isValid()) {
@@ -621,30 +741,9 @@ void ObjectImpl::on_move() {
         dialog, &QDialog::accepted,
         this,
         [this, dialog, dn_list]() {
-            AdInterface ad2;
-            if (ad_failed(ad2, console)) {
-                return;
-            }
-
-            show_busy_indicator();
-
             const QString new_parent_dn = dialog->get_selected();
 
-            // First move in AD
-            QList<QString> moved_objects;
-            for (const QString &dn : dn_list) {
-                const bool success = ad2.object_move(dn, new_parent_dn);
-                if (success) {
-                    moved_objects.append(dn);
-                }
-            }
-
-            g_status->display_ad_messages(ad2, nullptr);
-
-            // Then move in console
-            move(ad2, moved_objects, new_parent_dn);
-
-            hide_busy_indicator();
+            start_move(dn_list, new_parent_dn);
         });
 }
 
@@ -773,65 +872,115 @@ void ObjectImpl::new_object(const QString &object_class) {
 
 
 void ObjectImpl::set_disabled(const bool disabled) {
-    AdInterface ad;
-    if (ad_failed(ad, console)) {
-        return;
-    }
-
-    show_busy_indicator();
-
-    QList<QString> changed_objects;
     const QList<QString> dn_list = get_selected_dn_list_object();
+
+    QList<AdWriteOperation> operation_list;
     for (const QString &dn : dn_list) {
-        const bool success = ad.user_set_account_option(dn, AccountOption_Disabled, disabled);
-        if (success) {
-            changed_objects.append(dn);
-        }
+        operation_list.append(AdWriteOperation::make_account_option(dn, AccountOption_Disabled, disabled));
     }
 
-    auto apply_changes = [&changed_objects, &disabled](ConsoleWidget *target_console) {
-        auto apply_changes_to_branch = [&](const QModelIndex &root_index) {
-            if (!root_index.isValid()) {
-                return;
+    const QString label = disabled ? tr("Disabling objects...") : tr("Enabling objects...");
+
+    // NOTE: console list is copied because this may be
+    // deleted before operations finish
+    const QList<ConsoleWidget *> console_list_copy = console_list;
+
+    write_thread_start(operation_list, label, console,
+        [dn_list, disabled, console_list_copy](const QList<bool> &result_list) {
+            QList<QString> changed_objects;
+            for (int i = 0; i < dn_list.size(); i++) {
+                if (result_list[i]) {
+                    changed_objects.append(dn_list[i]);
+                }
             }
 
-            for (const QString &dn : changed_objects) {
-                const QList<QModelIndex> index_list = target_console->search_items(root_index, ObjectRole_DN, dn, {ItemType_Object});
-
-                for (const QModelIndex &index : index_list) {
-                    QStandardItem *item = target_console->get_item(index);
-                    item->setData(disabled, ObjectRole_AccountDisabled);
-                    const QString category= dn_get_name(item->data(ObjectRole_ObjectCategory).toString());
-                    QIcon icon;
-                    if (category == OBJECT_CATEGORY_PERSON) {
-                        icon = disabled ? g_icon_manager->item_icon(ItemIcon_Person_Blocked) :
-                                            g_icon_manager->item_icon(ItemIcon_Person);
+            auto apply_changes = [&changed_objects, &disabled](ConsoleWidget *target_console) {
+                auto apply_changes_to_branch = [&](const QModelIndex &root_index) {
+                    if (!root_index.isValid()) {
+                        return;
+                    }
+
+                    for (const QString &dn : changed_objects) {
+                        const QList<QModelIndex> index_list = target_console->search_items(root_index, ObjectRole_DN, dn, {ItemType_Object});
+
+                        for (const QModelIndex &index : index_list) {
+                            QStandardItem *item = target_console->get_item(index);
+                            item->setData(disabled, ObjectRole_AccountDisabled);
+                            const QString category= dn_get_name(item->data(ObjectRole_ObjectCategory).toString());
+                            QIcon icon;
+                            if (category == OBJECT_CATEGORY_PERSON) {
+                                icon = disabled ? g_icon_manager->item_icon(ItemIcon_Person_Blocked) :
+                                                    g_icon_manager->item_icon(ItemIcon_Person);
+                            }
+                            else if (category == OBJECT_CATEGORY_COMPUTER) {
+                                icon = disabled ? g_icon_manager->item_icon(ItemIcon_Computer_Blocked) :
+                                                    g_icon_manager->item_icon(ItemIcon_Computer);
+                            }
+                            item->setIcon(icon);
+                        }
                     }
-                    else if (category == OBJECT_CATEGORY_COMPUTER) {
-                        icon = disabled ? g_icon_manager->item_icon(ItemIcon_Computer_Blocked) :
-                                            g_icon_manager->item_icon(ItemIcon_Computer);
+                };
+
+                const QModelIndex object_root = ConsoleObjectTreeOperations::get_domain_object_tree_root(target_console);
+                const QModelIndex find_object_root = get_find_object_root(target_console);
+                const QModelIndex query_root = get_query_tree_root(target_console);
+
+                apply_changes_to_branch(object_root);
+                apply_changes_to_branch(find_object_root);
+                apply_changes_to_branch(query_root);
+
+                ObjectResultsModel *results_model = ObjectResultsModel::get(target_console);
+                if (results_model != nullptr) {
+                    for (const QString &dn : changed_objects) {
+                        results_model->set_account_disabled(dn, disabled);
                     }
-                    item->setIcon(icon);
                 }
+            };
+
+            for (ConsoleWidget *target_console : console_list_copy) {
+                apply_changes(target_console);
             }
-        };
+        });
+}
 
-        const QModelIndex object_root = ConsoleObjectTreeOperations::get_domain_object_tree_root(target_console);
-        const QModelIndex find_object_root = get_find_object_root(target_console);
-        const QModelIndex query_root = get_query_tree_root(target_console);
+// Moves objects in a background thread, then moves their
+// items in console
+void ObjectImpl::start_move(const QList<QString> &dn_list, const QString &new_parent_dn) {
+    QList<AdWriteOperation> operation_list;
+    for (const QString &dn : dn_list) {
+        operation_list.append(AdWriteOperation::make_move(dn, new_parent_dn));
+    }
 
-        apply_changes_to_branch(object_root);
-        apply_changes_to_branch(find_object_root);
-        apply_changes_to_branch(query_root);
-    };
+    const QString label = tr("Moving objects...");
 
-    for (ConsoleWidget *target_console : console_list) {
-        apply_changes(target_console);
-    }
+    const QPointer<ObjectImpl> self = this;
 
-    hide_busy_indicator();
+    write_thread_start(operation_list, label, console,
+        [self, dn_list, new_parent_dn](const QList<bool> &result_list) {
+            if (self == nullptr) {
+                return;
+            }
 
-    g_status->display_ad_messages(ad, console);
+            QList<QString> moved_objects;
+            for (int i = 0; i < dn_list.size(); i++) {
+                if (result_list[i]) {
+                    moved_objects.append(dn_list[i]);
+                }
+            }
+
+            if (moved_objects.isEmpty()) {
+                return;
+            }
+
+            AdInterface ad;
+            if (ad_failed(ad, self->console)) {
+                return;
+            }
+
+            self->move(ad, moved_objects, new_parent_dn);
+
+            g_status->display_ad_messages(ad, self->console);
+        });
 }
 
 // NOTE: this is a helper f-n for move_and_rename() that
@@ -913,6 +1062,7 @@ bool ObjectImpl::can_create_class_at_parent(const QString &create_class, const Q
 
 void ObjectImpl::setup_widgets() {
     stacked_widget = new QStackedWidget(console);
+    object_results_model = new ObjectResultsModel(console, this);
     set_results_view(new ResultsView(console));
     group_results_widget = new GeneralGroupTab();
     user_results_widget = new GeneralUserTab();
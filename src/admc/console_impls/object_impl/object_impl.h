@@ -47,6 +47,8 @@ class GeneralGroupTab;
 class QStackedWidget;
 class PSOResultsWidget;
 class SubnetResultsWidget;
+class NotificationThread;
+class ObjectResultsModel;
 
 enum ObjectRole {
     ObjectRole_DN = MyConsoleRole_LAST + 1,
@@ -58,6 +60,8 @@ enum ObjectRole {
     ObjectRole_AccountDisabled,
     ObjectRole_Fetching,
     ObjectRole_SearchId,
+    // Hex string of objectGUID
+    ObjectRole_GUID,
 
     ObjectRole_LAST,
 };
@@ -67,6 +71,7 @@ class ObjectImpl final : public ConsoleImpl {
 
 public:
     ObjectImpl(ConsoleWidget *console);
+    ~ObjectImpl();
 
     // This is for cases where there are multiple consoles
     // in the app and you need to propagate changes from one
@@ -75,7 +80,14 @@ public:
     // buddy console.
     void set_buddy_console(ConsoleWidget *buddy_console);
 
+    // When enabled, most recently fetched containers are
+    // watched for changes made outside of this app and
+    // changes are applied to console as they happen
+    void set_live_updates_enabled(const bool enabled);
+
     void fetch(const QModelIndex &index) override;
+    bool can_fetch_more(const QModelIndex &index) const override;
+    void fetch_more(const QModelIndex &index) override;
     bool can_drop(const QList<QPersistentModelIndex> &dropped_list, const QSet<int> &dropped_type_list, const QPersistentModelIndex &target, const int target_type) override;
     void drop(const QList<QPersistentModelIndex> &dropped_list, const QSet<int> &dropped_type_list, const QPersistentModelIndex &target, const int target_type) override;
     QString get_description(const QModelIndex &index) const override;
@@ -103,6 +115,7 @@ public:
 
     QList<QString> column_labels() const override;
     QList<int> default_columns() const override;
+    ConsoleResultsModel *results_model(const QModelIndex &index) const override;
 
     void refresh_tree();
 
@@ -151,6 +164,7 @@ private:
     QMenu *new_menu;
 
     QStackedWidget *stacked_widget;
+    ObjectResultsModel *object_results_model;
     GeneralGroupTab *group_results_widget;
     GeneralUserTab *user_results_widget;
     PSOResultsWidget *pso_results_widget;
@@ -160,10 +174,15 @@ private:
     bool find_action_enabled;
     bool refresh_action_enabled;
 
+    NotificationThread *notification_thread;
+    // Most recently fetched first
+    QList<QString> watched_container_list;
+
     void new_object(const QString &object_class);
     void set_disabled(const bool disabled);
     void move_and_rename(AdInterface &ad, const QHash<QString, QString> &old_dn_list, const QString &new_parent_dn);
     void move(AdInterface &ad, const QList<QString> &old_dn_list, const QString &new_parent_dn);
+    void start_move(const QList<QString> &dn_list, const QString &new_parent_dn);
     void update_toolbar_actions();
     QList<QString> get_selected_dn_list_object();
     QString get_selected_target_dn_object();
@@ -171,6 +190,8 @@ private:
     void setup_widgets();
     void setup_filters();
     void setup_actions();
+    void watch_container(const QString &dn);
+    void on_objects_changed(const QHash<QString, AdObject> &objects);
 
     void retranslate_ui() override;
     bool event(QEvent *event) override;
@@ -0,0 +1,491 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "console_impls/object_impl/object_results_model.h"
+
+#include "adldap.h"
+#include "console_impls/item_type.h"
+#include "console_impls/object_impl/console_object_operations.h"
+#include "console_impls/object_impl/object_impl.h"
+#include "core/globals.h"
+
+#include <QHash>
+#include <QIcon>
+#include <QSet>
+
+#include <algorithm>
+
+// NOTE: removing a range of rows moves all rows after it,
+// so when removed rows are scattered over more ranges than
+// this, results are rebuilt in one pass and model is reset
+#define REMOVED_RANGE_MAX 100
+
+class ObjectResultsRow {
+public:
+    AdObject object;
+    bool account_disabled;
+};
+
+class ObjectResultsContainer {
+public:
+    // Scope item of container in console
+    QPersistentModelIndex index;
+    QList<ObjectResultsRow> row_list;
+    // Row of each result, by DN
+    QHash<QString, int> row_map;
+};
+
+// Results models of consoles, so that object tree
+// operations can reach them
+QHash<ConsoleWidget *, ObjectResultsModel *> object_results_model_map;
+
+ObjectResultsRow make_object_results_row(const AdObject &object);
+void update_row_map(ObjectResultsContainer *container);
+
+ObjectResultsModel::ObjectResultsModel(ConsoleWidget *console_arg, QObject *parent)
+: ConsoleResultsModel(console_arg, parent) {
+    current = nullptr;
+
+    object_results_model_map[console] = this;
+}
+
+ObjectResultsModel::~ObjectResultsModel() {
+    object_results_model_map.remove(console);
+
+    qDeleteAll(container_list);
+}
+
+ObjectResultsModel *ObjectResultsModel::get(ConsoleWidget *console) {
+    return object_results_model_map.value(console, nullptr);
+}
+
+void ObjectResultsModel::clear_container(const QModelIndex &index) {
+    ObjectResultsContainer *container = get_container(index);
+    if (container == nullptr) {
+        add_container(index);
+
+        return;
+    }
+
+    const bool is_current = (container == current);
+
+    if (is_current) {
+        beginResetModel();
+    }
+
+    container->row_list.clear();
+    container->row_map.clear();
+
+    if (is_current) {
+        endResetModel();
+    }
+}
+
+void ObjectResultsModel::add_objects(const QModelIndex &index, const QList<AdObject> &object_list) {
+    ObjectResultsContainer *container = get_container(index);
+    if (container == nullptr) {
+        container = add_container(index);
+    }
+
+    QList<ObjectResultsRow> new_row_list;
+
+    for (const AdObject &object : object_list) {
+        if (object.is_empty()) {
+            continue;
+        }
+
+        const int existing_row = container->row_map.value(object.get_dn(), -1);
+
+        if (existing_row != -1) {
+            container->row_list[existing_row] = make_object_results_row(object);
+            emit_row_changed(container, existing_row);
+        } else {
+            new_row_list.append(make_object_results_row(object));
+        }
+    }
+
+    if (new_row_list.isEmpty()) {
+        return;
+    }
+
+    const bool is_current = (container == current);
+    const int first = container->row_list.size();
+    const int last = first + new_row_list.size() - 1;
+
+    if (is_current) {
+        beginInsertRows(QModelIndex(), first, last);
+    }
+
+    for (int i = 0; i < new_row_list.size(); i++) {
+        const QString dn = new_row_list[i].object.get_dn();
+        container->row_map[dn] = first + i;
+    }
+
+    container->row_list.append(new_row_list);
+
+    if (is_current) {
+        endInsertRows();
+    }
+}
+
+void ObjectResultsModel::update_objects(const QList<AdObject> &object_list) {
+    for (const AdObject &object : object_list) {
+        const QString dn = object.get_dn();
+
+        for (ObjectResultsContainer *container : container_list) {
+            const int row = container->row_map.value(dn, -1);
+
+            if (row != -1) {
+                container->row_list[row] = make_object_results_row(object);
+                emit_row_changed(container, row);
+            }
+        }
+    }
+}
+
+void ObjectResultsModel::remove_dn_list(const QList<QString> &dn_list) {
+    for (ObjectResultsContainer *container : container_list) {
+        QList<int> row_list;
+
+        for (const QString &dn : dn_list) {
+            const int row = container->row_map.value(dn, -1);
+
+            if (row != -1) {
+                row_list.append(row);
+            }
+        }
+
+        if (!row_list.isEmpty()) {
+            remove_rows(container, row_list);
+        }
+    }
+}
+
+void ObjectResultsModel::set_account_disabled(const QString &dn, const bool disabled) {
+    for (ObjectResultsContainer *container : container_list) {
+        const int row = container->row_map.value(dn, -1);
+
+        if (row != -1) {
+            container->row_list[row].account_disabled = disabled;
+            emit_row_changed(container, row);
+        }
+    }
+}
+
+int ObjectResultsModel::get_result_count(const QModelIndex &index) const {
+    const ObjectResultsContainer *container = get_container(index);
+
+    if (container != nullptr) {
+        return container->row_list.size();
+    } else {
+        return -1;
+    }
+}
+
+int ObjectResultsModel::get_result_count(const QString &container_dn) const {
+    const ObjectResultsContainer *container = get_container_by_dn(container_dn);
+
+    if (container != nullptr) {
+        return container->row_list.size();
+    } else {
+        return -1;
+    }
+}
+
+QString ObjectResultsModel::find_dn_by_guid(const QString &guid) const {
+    if (guid.isEmpty()) {
+        return QString();
+    }
+
+    const QByteArray guid_bytes = QByteArray::fromHex(guid.toLatin1());
+
+    for (const ObjectResultsContainer *container : container_list) {
+        for (const ObjectResultsRow &row : container->row_list) {
+            if (row.object.get_value(ATTRIBUTE_OBJECT_GUID) == guid_bytes) {
+                return row.object.get_dn();
+            }
+        }
+    }
+
+    return QString();
+}
+
+int ObjectResultsModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid() || current == nullptr) {
+        return 0;
+    }
+
+    return current->row_list.size();
+}
+
+int ObjectResultsModel::columnCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return g_adconfig->get_columns().size();
+}
+
+QVariant ObjectResultsModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || current == nullptr) {
+        return QVariant();
+    }
+
+    const ObjectResultsRow &row = current->row_list[index.row()];
+    const AdObject &object = row.object;
+    const QString attribute = g_adconfig->get_columns().value(index.column());
+
+    switch (role) {
+        case Qt::DisplayRole: {
+            if (!object.contains(attribute)) {
+                return QVariant();
+            }
+
+            return ConsoleObjectTreeOperations::console_object_display_value(object, attribute);
+        }
+        case ConsoleRole_SortKey: {
+            return ConsoleObjectTreeOperations::console_object_sort_value(object, attribute);
+        }
+    }
+
+    // NOTE: icon and item roles are only in 0th column,
+    // same as in console's model
+    if (index.column() != 0) {
+        return QVariant();
+    }
+
+    switch (role) {
+        case Qt::DecorationRole: {
+            const QString object_category = object.get_string(ATTRIBUTE_OBJECT_CATEGORY);
+
+            return ConsoleObjectTreeOperations::console_object_icon(object_category, row.account_disabled);
+        }
+        case ConsoleRole_Type: return ItemType_Object;
+        case ObjectRole_DN: return object.get_dn();
+        case ObjectRole_GUID: return QString(object.get_value(ATTRIBUTE_OBJECT_GUID).toHex());
+        case ObjectRole_ObjectClasses: return QVariant(object.get_strings(ATTRIBUTE_OBJECT_CLASS));
+        case ObjectRole_ObjectCategory: return object.get_string(ATTRIBUTE_OBJECT_CATEGORY);
+        case ObjectRole_CannotMove: return object.get_system_flag(SystemFlagsBit_DomainCannotMove);
+        case ObjectRole_CannotRename: return object.get_system_flag(SystemFlagsBit_DomainCannotRename);
+        case ObjectRole_CannotDelete: return object.get_system_flag(SystemFlagsBit_CannotDelete);
+        case ObjectRole_AccountDisabled: return row.account_disabled;
+        case ObjectRole_Fetching: {
+            // NOTE: result is being fetched if it's a
+            // container and it's scope item is being
+            // fetched
+            const ObjectResultsContainer *container = get_container_by_dn(object.get_dn());
+
+            if (container != nullptr) {
+                return container->index.data(ObjectRole_Fetching);
+            } else {
+                return false;
+            }
+        }
+    }
+
+    return QVariant();
+}
+
+QVariant ObjectResultsModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    const QList<QString> label_list = ConsoleObjectTreeOperations::object_impl_column_labels();
+
+    return label_list.value(section);
+}
+
+Qt::ItemFlags ObjectResultsModel::flags(const QModelIndex &index) const {
+    Qt::ItemFlags out = ConsoleResultsModel::flags(index);
+
+    if (index.isValid() && current != nullptr) {
+        const AdObject &object = current->row_list[index.row()].object;
+        const bool cannot_move = object.get_system_flag(SystemFlagsBit_DomainCannotMove);
+
+        out.setFlag(Qt::ItemIsDragEnabled, !cannot_move);
+    }
+
+    return out;
+}
+
+void ObjectResultsModel::load_scope(const QModelIndex &index) {
+    current = get_container(index);
+}
+
+ObjectResultsContainer *ObjectResultsModel::get_container(const QModelIndex &index) const {
+    // NOTE: containers of removed scope items have invalid
+    // indexes, don't match them
+    if (!index.isValid()) {
+        return nullptr;
+    }
+
+    for (ObjectResultsContainer *container : container_list) {
+        if (container->index == index) {
+            return container;
+        }
+    }
+
+    return nullptr;
+}
+
+ObjectResultsContainer *ObjectResultsModel::get_container_by_dn(const QString &dn) const {
+    for (ObjectResultsContainer *container : container_list) {
+        const bool match = (container->index.isValid() && container->index.data(ObjectRole_DN).toString() == dn);
+
+        if (match) {
+            return container;
+        }
+    }
+
+    return nullptr;
+}
+
+ObjectResultsContainer *ObjectResultsModel::add_container(const QModelIndex &index) {
+    auto container = new ObjectResultsContainer();
+    container->index = index;
+    container_list.append(container);
+
+    // NOTE: results are removed together with container's
+    // scope item
+    connect(
+        index.model(), &QAbstractItemModel::rowsRemoved,
+        this, &ObjectResultsModel::remove_invalid_containers,
+        Qt::UniqueConnection);
+
+    // NOTE: scope item is fetched after it's selected, so
+    // it's container may be added when it's already the
+    // current scope
+    if (index == get_scope()) {
+        beginResetModel();
+        current = container;
+        endResetModel();
+    }
+
+    return container;
+}
+
+void ObjectResultsModel::remove_rows(ObjectResultsContainer *container, QList<int> row_list) {
+    std::sort(row_list.begin(), row_list.end());
+
+    // Group rows into ranges of consecutive rows
+    QList<QPair<int, int>> range_list;
+    for (const int row : row_list) {
+        if (!range_list.isEmpty() && range_list.last().second == row - 1) {
+            range_list.last().second = row;
+        } else {
+            range_list.append({row, row});
+        }
+    }
+
+    const bool is_current = (container == current);
+
+    if (range_list.size() > REMOVED_RANGE_MAX) {
+        const QSet<int> removed_set(row_list.begin(), row_list.end());
+
+        QList<ObjectResultsRow> remaining_list;
+        remaining_list.reserve(container->row_list.size() - removed_set.size());
+        for (int row = 0; row < container->row_list.size(); row++) {
+            if (!removed_set.contains(row)) {
+                remaining_list.append(container->row_list[row]);
+            }
+        }
+
+        if (is_current) {
+            beginResetModel();
+        }
+
+        container->row_list = remaining_list;
+        update_row_map(container);
+
+        if (is_current) {
+            endResetModel();
+        }
+    } else {
+        // NOTE: remove ranges starting from the last one,
+        // so that rows of remaining ranges don't move
+        for (int i = range_list.size() - 1; i >= 0; i--) {
+            const int first = range_list[i].first;
+            const int last = range_list[i].second;
+
+            if (is_current) {
+                beginRemoveRows(QModelIndex(), first, last);
+            }
+
+            container->row_list.remove(first, last - first + 1);
+
+            if (is_current) {
+                endRemoveRows();
+            }
+        }
+
+        update_row_map(container);
+    }
+}
+
+void ObjectResultsModel::emit_row_changed(ObjectResultsContainer *container, const int row) {
+    if (container != current) {
+        return;
+    }
+
+    const QModelIndex top_left = index(row, 0);
+    const QModelIndex bottom_right = index(row, columnCount() - 1);
+
+    emit dataChanged(top_left, bottom_right);
+}
+
+void ObjectResultsModel::remove_invalid_containers() {
+    for (ObjectResultsContainer *container : QList<ObjectResultsContainer *>(container_list)) {
+        if (container->index.isValid()) {
+            continue;
+        }
+
+        const bool is_current = (container == current);
+
+        if (is_current) {
+            beginResetModel();
+            current = nullptr;
+        }
+
+        container_list.removeAll(container);
+        delete container;
+
+        if (is_current) {
+            endResetModel();
+        }
+    }
+}
+
+ObjectResultsRow make_object_results_row(const AdObject &object) {
+    ObjectResultsRow out;
+    out.object = object;
+    out.account_disabled = object.get_account_option(AccountOption_Disabled, g_adconfig);
+
+    return out;
+}
+
+void update_row_map(ObjectResultsContainer *container) {
+    container->row_map.clear();
+    container->row_map.reserve(container->row_list.size());
+
+    for (int row = 0; row < container->row_list.size(); row++) {
+        const QString dn = container->row_list[row].object.get_dn();
+        container->row_map[dn] = row;
+    }
+}
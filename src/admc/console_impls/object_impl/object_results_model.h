@@ -0,0 +1,99 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OBJECT_RESULTS_MODEL_H
+#define OBJECT_RESULTS_MODEL_H
+
+/**
+ * Holds results of fetched object containers, so that
+ * containers with a lot of objects don't need a row of
+ * console items per object. Each result is kept as an
+ * AdObject, which is already compact, and display text,
+ * icons and roles are made only when views ask for them.
+ * Results are kept per container and model displays
+ * results of current scope item. Containers are also
+ * added to console, for the scope tree.
+ */
+
+#include "console_widget/console_results_model.h"
+
+#include <QList>
+
+class AdObject;
+class ConsoleWidget;
+class ObjectResultsContainer;
+class ObjectResultsRow;
+
+class ObjectResultsModel final : public ConsoleResultsModel {
+    Q_OBJECT
+
+public:
+    ObjectResultsModel(ConsoleWidget *console_arg, QObject *parent);
+    ~ObjectResultsModel();
+
+    // Returns results model of console's object impl or
+    // nullptr if console has none
+    static ObjectResultsModel *get(ConsoleWidget *console);
+
+    // Removes all results of container. Called when
+    // container is fetched, so that results are not
+    // duplicated when container is refreshed.
+    void clear_container(const QModelIndex &index);
+
+    // Objects that are already in container are reloaded
+    // instead of being added again
+    void add_objects(const QModelIndex &index, const QList<AdObject> &object_list);
+
+    // These apply to results in all containers
+    void update_objects(const QList<AdObject> &object_list);
+    void remove_dn_list(const QList<QString> &dn_list);
+    void set_account_disabled(const QString &dn, const bool disabled);
+
+    // Returns number of results of container or -1 if
+    // container's results are not in this model
+    int get_result_count(const QModelIndex &index) const;
+    int get_result_count(const QString &container_dn) const;
+
+    // Returns DN of result with given GUID or empty string
+    // if there's no such result. GUID is a hex string, same
+    // as in ObjectRole_GUID.
+    QString find_dn_by_guid(const QString &guid) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+protected:
+    void load_scope(const QModelIndex &index) override;
+
+private:
+    QList<ObjectResultsContainer *> container_list;
+    ObjectResultsContainer *current;
+
+    ObjectResultsContainer *get_container(const QModelIndex &index) const;
+    ObjectResultsContainer *get_container_by_dn(const QString &dn) const;
+    ObjectResultsContainer *add_container(const QModelIndex &index);
+    void remove_rows(ObjectResultsContainer *container, QList<int> row_list);
+    void emit_row_changed(ObjectResultsContainer *container, const int row);
+    void remove_invalid_containers();
+};
+
+#endif /* OBJECT_RESULTS_MODEL_H */
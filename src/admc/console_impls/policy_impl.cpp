@@ -405,6 +405,7 @@ void console_policy_rename(const QList<ConsoleWidget *> &console_list, PolicyRes
             }
 
             const AdObject object = ad_inner.search_object(dn);
+            g_gplink_manager->set_gpo_name(dn, object.get_string(ATTRIBUTE_DISPLAY_NAME));
 
             // NOTE: ok to not update dn after rename
             // because policy rename doesn't change dn, since "policy name" is displayName
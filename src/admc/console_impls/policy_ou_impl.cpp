@@ -462,6 +462,7 @@ void PolicyOUImpl::change_gp_options() {
     }
     currentItem->setData(checked, PolicyOURole_Inheritance_Block);
     currentItem->setIcon(icon_to_set);
+    g_gplink_manager->set_inheritance_blocked(dn, checked);
 
     policy_ou_results_widget->update_inheritance_widget(currentItem->index());
 }
@@ -21,10 +21,12 @@
 
 #include "console_widget/console_drag_model.h"
 
+#include "console_widget/console_impl.h"
 #include "console_widget/console_widget.h"
 #include "console_widget/console_widget_p.h"
 
 #include <QMimeData>
+#include <QSignalBlocker>
 
 #define MIME_TYPE_CONSOLE "MIME_TYPE_CONSOLE"
 
@@ -107,3 +109,62 @@ bool ConsoleDragModel::dropMimeData(const QMimeData *data, Qt::DropAction action
 
     return true;
 }
+
+bool ConsoleDragModel::canFetchMore(const QModelIndex &parent) const {
+    if (!parent.isValid()) {
+        return false;
+    }
+
+    const QModelIndex target = parent.siblingAtColumn(0);
+    ConsoleImpl *impl = console->d->get_impl(target);
+
+    const bool out = impl->can_fetch_more(target);
+
+    return out;
+}
+
+void ConsoleDragModel::fetchMore(const QModelIndex &parent) {
+    if (!parent.isValid()) {
+        return;
+    }
+
+    const QModelIndex target = parent.siblingAtColumn(0);
+    ConsoleImpl *impl = console->d->get_impl(target);
+
+    impl->fetch_more(target);
+}
+
+void ConsoleDragModel::append_rows(QStandardItem *parent_item, const QList<QList<QStandardItem *>> &row_list) {
+    if (row_list.isEmpty()) {
+        return;
+    }
+
+    // NOTE: column insertion has to be announced
+    // separately, so do it before rows are inserted
+    const int column_count = row_list[0].size();
+    if (parent_item->columnCount() < column_count) {
+        parent_item->setColumnCount(column_count);
+    }
+
+    const QModelIndex parent = indexFromItem(parent_item);
+    const int first = parent_item->rowCount();
+    const int last = first + row_list.size() - 1;
+
+    // NOTE: QStandardItem can only append multi-column
+    // rows one at a time and each append emits it's own
+    // insertion signals. Wrap appends in one insertion and
+    // silence the per-row signals. Rows are appended after
+    // all existing rows, so no persistent indexes are
+    // moved by inner insertions.
+    beginInsertRows(parent, first, last);
+
+    {
+        const QSignalBlocker blocker(this);
+
+        for (const QList<QStandardItem *> &row : row_list) {
+            parent_item->appendRow(row);
+        }
+    }
+
+    endInsertRows();
+}
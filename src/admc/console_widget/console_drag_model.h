@@ -28,7 +28,9 @@ class ConsoleWidget;
 /**
  * Implements drag and drop. Note that this only implements
  * the framework for drag and drop. The actual logic is
- * implemented by console widget and console types.
+ * implemented by console widget and console types. Also
+ * forwards incremental loading requests from views to
+ * console types.
  */
 
 class ConsoleDragModel : public QStandardItemModel {
@@ -40,6 +42,13 @@ public:
     QMimeData *mimeData(const QModelIndexList &indexes) const override;
     bool dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) override;
     bool canDropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    // Appends rows to parent as one insertion, so that
+    // proxies, views and rowsInserted() listeners process
+    // all rows at once instead of once per row
+    void append_rows(QStandardItem *parent_item, const QList<QList<QStandardItem *>> &row_list);
 
 private:
     ConsoleWidget *console;
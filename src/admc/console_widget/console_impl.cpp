@@ -38,6 +38,16 @@ void ConsoleImpl::fetch(const QModelIndex &index) {
     Q_UNUSED(index);
 }
 
+bool ConsoleImpl::can_fetch_more(const QModelIndex &index) const {
+    Q_UNUSED(index);
+
+    return false;
+}
+
+void ConsoleImpl::fetch_more(const QModelIndex &index) {
+    Q_UNUSED(index);
+}
+
 bool ConsoleImpl::can_drop(const QList<QPersistentModelIndex> &dropped_list, const QSet<int> &dropped_type_list, const QPersistentModelIndex &target, const int target_type) {
     Q_UNUSED(dropped_list);
     Q_UNUSED(dropped_type_list);
@@ -140,6 +150,12 @@ QList<int> ConsoleImpl::default_columns() const {
     return QList<int>();
 }
 
+ConsoleResultsModel *ConsoleImpl::results_model(const QModelIndex &index) const {
+    Q_UNUSED(index);
+
+    return nullptr;
+}
+
 void ConsoleImpl::update_results_widget(const QModelIndex &index) const
 {
    Q_UNUSED(index);
@@ -34,6 +34,7 @@
 
 class ConsoleWidget;
 class ResultsView;
+class ConsoleResultsModel;
 
 class ConsoleImpl : public QObject {
     Q_OBJECT
@@ -51,6 +52,17 @@ public:
     */
     virtual void fetch(const QModelIndex &index);
 
+    /**
+    * @brief Called when results of a scope item of this type
+    * are scrolled to the end. Return true if item has more
+    * children that can be loaded, after which fetch_more()
+    * will be called. Implement these if children are loaded
+    * in chunks, for example when there are too many of them
+    * to load at once.
+    */
+    virtual bool can_fetch_more(const QModelIndex &index) const;
+    virtual void fetch_more(const QModelIndex &index);
+
     /**
     * @brief Called when items are dragged on top of an item of
     * this type to determine whether dropping is allowed.
@@ -142,6 +154,16 @@ public:
     virtual QList<QString> column_labels() const;
     virtual QList<int> default_columns() const;
 
+    /**
+    * @brief Return a model that results view should display
+    * when a scope item of this type is selected, instead
+    * of item's children in console's model. Console
+    * switches returned model to the selected item. Return
+    * nullptr to display children from console's model,
+    * which is the default.
+    */
+    virtual ConsoleResultsModel *results_model(const QModelIndex &index) const;
+
     virtual void update_results_widget(const QModelIndex &index) const;
 
     virtual void retranslate_ui();
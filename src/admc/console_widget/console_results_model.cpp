@@ -0,0 +1,94 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "console_widget/console_results_model.h"
+
+#include "console_widget/console_drag_model.h"
+#include "console_widget/console_widget.h"
+#include "console_widget/console_widget_p.h"
+
+ConsoleResultsModel::ConsoleResultsModel(ConsoleWidget *console_arg, QObject *parent)
+: QAbstractTableModel(parent) {
+    console = console_arg;
+}
+
+void ConsoleResultsModel::set_scope(const QModelIndex &index) {
+    beginResetModel();
+    scope = index;
+    load_scope(index);
+    endResetModel();
+}
+
+QModelIndex ConsoleResultsModel::get_scope() const {
+    return scope;
+}
+
+Qt::ItemFlags ConsoleResultsModel::flags(const QModelIndex &index) const {
+    // NOTE: root accepts drops so that dropping on empty
+    // space in view drops onto scope item, same as when
+    // view displays console's model
+    if (!index.isValid()) {
+        return Qt::ItemIsDropEnabled;
+    }
+
+    return (QAbstractTableModel::flags(index) | Qt::ItemIsDragEnabled | Qt::ItemIsDropEnabled);
+}
+
+// NOTE: console's model doesn't depend on dragged and
+// target indexes belonging to it, so forward drag and drop
+// to it to share it's state between views
+QMimeData *ConsoleResultsModel::mimeData(const QModelIndexList &indexes) const {
+    return console->d->model->mimeData(indexes);
+}
+
+bool ConsoleResultsModel::dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) {
+    const QModelIndex target = get_drop_target(parent);
+
+    return console->d->model->dropMimeData(data, action, row, column, target);
+}
+
+bool ConsoleResultsModel::canDropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) const {
+    const QModelIndex target = get_drop_target(parent);
+
+    return console->d->model->canDropMimeData(data, action, row, column, target);
+}
+
+bool ConsoleResultsModel::canFetchMore(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return false;
+    }
+
+    return console->d->model->canFetchMore(scope);
+}
+
+void ConsoleResultsModel::fetchMore(const QModelIndex &parent) {
+    if (parent.isValid()) {
+        return;
+    }
+
+    console->d->model->fetchMore(scope);
+}
+
+QModelIndex ConsoleResultsModel::get_drop_target(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return parent;
+    } else {
+        return scope;
+    }
+}
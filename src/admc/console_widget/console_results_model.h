@@ -0,0 +1,68 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONSOLE_RESULTS_MODEL_H
+#define CONSOLE_RESULTS_MODEL_H
+
+/**
+ * Base class for models that an impl can display in results
+ * view instead of children of the scope item in console's
+ * model. Use it for types which can have a lot of results
+ * that are cheaper to keep in a compact form than as a row
+ * of items per result. Rows are flat. Drag and drop and
+ * incremental loading are forwarded to console, same as
+ * for console's own model.
+ */
+
+#include <QAbstractTableModel>
+
+class ConsoleWidget;
+
+class ConsoleResultsModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    ConsoleResultsModel(ConsoleWidget *console_arg, QObject *parent);
+
+    // Switches model to results of given scope item.
+    // Called by console when scope item is selected.
+    void set_scope(const QModelIndex &index);
+    QModelIndex get_scope() const;
+
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    QMimeData *mimeData(const QModelIndexList &indexes) const override;
+    bool dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) override;
+    bool canDropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+protected:
+    ConsoleWidget *console;
+
+    // Called during model reset when scope changes.
+    // Implement to switch to results of new scope.
+    virtual void load_scope(const QModelIndex &index) = 0;
+
+private:
+    QPersistentModelIndex scope;
+
+    QModelIndex get_drop_target(const QModelIndex &parent) const;
+};
+
+#endif /* CONSOLE_RESULTS_MODEL_H */
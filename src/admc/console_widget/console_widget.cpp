@@ -24,6 +24,7 @@
 
 #include "console_widget/console_drag_model.h"
 #include "console_widget/console_impl.h"
+#include "console_widget/console_results_model.h"
 #include "console_widget/customize_columns_dialog.h"
 #include "console_widget/results_view.h"
 #include "console_widget/scope_proxy_model.h"
@@ -198,6 +199,14 @@ ConsoleWidget::ConsoleWidget(QWidget *parent)
         d->model, &QStandardItemModel::rowsAboutToBeRemoved,
         d, &ConsoleWidgetPrivate::on_scope_items_about_to_be_removed);
 
+    // Keep search index up to date
+    connect(
+        d->model, &QAbstractItemModel::rowsInserted,
+        d, &ConsoleWidgetPrivate::on_rows_inserted);
+    connect(
+        d->model, &QAbstractItemModel::dataChanged,
+        d, &ConsoleWidgetPrivate::on_data_changed);
+
     // Update description bar when results count changes
     connect(
         d->model, &QAbstractItemModel::rowsInserted,
@@ -263,28 +272,35 @@ void ConsoleWidget::register_impl(const int type, ConsoleImpl *impl) {
 }
 
 QList<QStandardItem *> ConsoleWidget::add_scope_item(const int type, const QModelIndex &parent) {
-    const QList<QStandardItem *> row = add_results_item(type, parent);
+    const QList<QStandardItem *> row = make_scope_row(type, parent);
 
-    row[0]->setData(false, ConsoleRole_WasFetched);
-    row[0]->setData(true, ConsoleRole_IsScope);
-
-    d->scope_proxy_model->sort(0, Qt::AscendingOrder);
+    add_rows(parent, {row});
 
     return row;
 }
 
 QList<QStandardItem *> ConsoleWidget::add_results_item(const int type, const QModelIndex &parent) {
-    QStandardItem *parent_item;
-    if (parent.isValid()) {
-        parent_item = d->model->itemFromIndex(parent);
-    } else {
-        parent_item = d->model->invisibleRootItem();
-    }
+    const QList<QStandardItem *> row = make_results_row(type, parent);
+
+    add_rows(parent, {row});
+
+    return row;
+}
 
+QList<QStandardItem *> ConsoleWidget::make_scope_row(const int type, const QModelIndex &parent) {
+    const QList<QStandardItem *> row = make_results_row(type, parent);
+
+    row[0]->setData(false, ConsoleRole_WasFetched);
+    row[0]->setData(true, ConsoleRole_IsScope);
+
+    return row;
+}
+
+QList<QStandardItem *> ConsoleWidget::make_results_row(const int type, const QModelIndex &parent) {
     // Make item row
     QList<QStandardItem *> row;
     int column_count;
-    if (parent_item == d->model->invisibleRootItem()) {
+    if (!parent.isValid()) {
         column_count = 1;
     } else {
         ConsoleImpl *parent_impl = d->get_impl(parent);
@@ -299,11 +315,40 @@ QList<QStandardItem *> ConsoleWidget::add_results_item(const int type, const QMo
     row[0]->setData(false, ConsoleRole_IsScope);
     row[0]->setData(type, ConsoleRole_Type);
 
-    parent_item->appendRow(row);
-
     return row;
 }
 
+void ConsoleWidget::add_rows(const QModelIndex &parent, const QList<QList<QStandardItem *>> &row_list) {
+    if (row_list.isEmpty()) {
+        return;
+    }
+
+    QStandardItem *parent_item;
+    if (parent.isValid()) {
+        parent_item = d->model->itemFromIndex(parent);
+    } else {
+        parent_item = d->model->invisibleRootItem();
+    }
+
+    d->model->append_rows(parent_item, row_list);
+
+    // NOTE: sort once for the whole batch instead of once
+    // per scope item
+    const bool added_scope_item = [&]() {
+        for (const QList<QStandardItem *> &row : row_list) {
+            if (row[0]->data(ConsoleRole_IsScope).toBool()) {
+                return true;
+            }
+        }
+
+        return false;
+    }();
+
+    if (added_scope_item) {
+        d->scope_proxy_model->sort(0, Qt::AscendingOrder);
+    }
+}
+
 void ConsoleWidget::delete_item(const QModelIndex &index) {
     if (!index.isValid()) {
         return;
@@ -360,22 +405,27 @@ QModelIndex ConsoleWidget::get_selected_item(const int type) const {
 
 QList<QModelIndex> ConsoleWidget::search_items(const QModelIndex &parent, int role, const QVariant &value, const QList<int> &type_list) const {
     QList<QModelIndex> all_matches;
-    // NOTE: start index may be invalid if parent has no
-    // children
-    const QModelIndex start_index = d->model->index(0, 0, parent);
-    if (start_index.isValid()) {
-        const QList<QModelIndex> descendant_matches =
-            d->model->match(
-                start_index, role, value, -1,
-                Qt::MatchFlags(Qt::MatchExactly | Qt::MatchRecursive));
-        all_matches.append(descendant_matches);
-    }
 
-    const QVariant parent_value = parent.data(role);
-    const bool parent_is_match =
-        (parent_value.isValid() && (parent_value == value));
-    if (parent_is_match) {
-        all_matches.append(parent);
+    if (d->search_index_map.contains(role)) {
+        all_matches = d->search_index_lookup(parent, role, value.toString());
+    } else {
+        // NOTE: start index may be invalid if parent has no
+        // children
+        const QModelIndex start_index = d->model->index(0, 0, parent);
+        if (start_index.isValid()) {
+            const QList<QModelIndex> descendant_matches =
+                d->model->match(
+                    start_index, role, value, -1,
+                    Qt::MatchFlags(Qt::MatchExactly | Qt::MatchRecursive));
+            all_matches.append(descendant_matches);
+        }
+
+        const QVariant parent_value = parent.data(role);
+        const bool parent_is_match =
+            (parent_value.isValid() && (parent_value == value));
+        if (parent_is_match) {
+            all_matches.append(parent);
+        }
     }
 
     QList<QModelIndex> filtered_matches;
@@ -427,6 +477,20 @@ QList<QModelIndex> ConsoleWidget::search_items(const QModelIndex &parent, const
     return out;
 }
 
+void ConsoleWidget::add_search_index(const int role) {
+    if (d->search_index_map.contains(role)) {
+        return;
+    }
+
+    d->search_index_map[role] = QMultiHash<QString, QPersistentModelIndex>();
+
+    // Index items that were added before
+    const int root_row_count = d->model->rowCount();
+    if (root_row_count > 0) {
+        d->on_rows_inserted(QModelIndex(), 0, root_row_count - 1);
+    }
+}
+
 QModelIndex ConsoleWidget::search_item(const QModelIndex &parent, int role, const QVariant &value, const QList<int> &type_list) const {
     const QList<QModelIndex> index_list = search_items(parent, role, value, type_list);
 
@@ -1020,10 +1084,32 @@ void ConsoleWidgetPrivate::on_current_scope_item_changed(const QModelIndex &curr
 
     impl->selected_as_scope(current);
 
-    // Switch to new parent for results view's model if view
-    // exists
+    // Switch results view to new parent or to impl's own
+    // model, if view exists
     const bool results_view_exists = (impl->view() != nullptr);
-    if (results_view_exists) {
+    ConsoleResultsModel *results_model = impl->results_model(current);
+    if (results_view_exists && results_model != nullptr) {
+        // NOTE: impl's own model has a flat list of
+        // results and provides it's own header, so no
+        // parent to switch to or dummy row to add
+        results_model->set_scope(current);
+        impl->view()->set_model(results_model);
+        impl->view()->set_parent(QModelIndex());
+
+        // Update description bar when results count
+        // changes, same as for console's model
+        connect(
+            results_model, &QAbstractItemModel::rowsInserted,
+            this, &ConsoleWidgetPrivate::update_description, Qt::UniqueConnection);
+        connect(
+            results_model, &QAbstractItemModel::rowsRemoved,
+            this, &ConsoleWidgetPrivate::update_description, Qt::UniqueConnection);
+        connect(
+            results_model, &QAbstractItemModel::modelReset,
+            this, &ConsoleWidgetPrivate::update_description, Qt::UniqueConnection);
+    } else if (results_view_exists) {
+        impl->view()->set_model(model);
+
         model->setHorizontalHeaderLabels(impl->column_labels());
 
         // NOTE: setting horizontal labes may make columns
@@ -1045,7 +1131,9 @@ void ConsoleWidgetPrivate::on_current_scope_item_changed(const QModelIndex &curr
         if (need_dummy) {
             model->removeRow(0, current);
         }
+    }
 
+    if (results_view_exists) {
         const ResultsViewType results_type = impl->view()->current_view_type();
         switch (results_type) {
             case ResultsViewType_Icons: {
@@ -1111,10 +1199,140 @@ void ConsoleWidgetPrivate::on_scope_items_about_to_be_removed(const QModelIndex
         targets_future.removeAll(index);
     }
 
+    // Remove removed items from search index
+    for (auto it = search_index_map.begin(); it != search_index_map.end(); it++) {
+        const int role = it.key();
+        QMultiHash<QString, QPersistentModelIndex> &index_map = it.value();
+
+        for (const QModelIndex &index : removed_scope_items) {
+            const QString value = index.data(role).toString();
+
+            if (!value.isEmpty()) {
+                index_map.remove(value, QPersistentModelIndex(index));
+            }
+        }
+    }
+
     // Update navigation since an item in history could've been removed
     update_navigation_actions();
 }
 
+// NOTE: inserted rows may already have children, so
+// index whole subtrees
+void ConsoleWidgetPrivate::on_rows_inserted(const QModelIndex &parent, int first, int last) {
+    if (search_index_map.isEmpty()) {
+        return;
+    }
+
+    const QList<int> role_list = search_index_map.keys();
+
+    QStack<QModelIndex> stack;
+    for (int r = first; r <= last; r++) {
+        stack.push(model->index(r, 0, parent));
+    }
+
+    while (!stack.isEmpty()) {
+        const QModelIndex index = stack.pop();
+
+        search_index_add(index, role_list);
+
+        for (int r = 0; r < model->rowCount(index); r++) {
+            stack.push(model->index(r, 0, index));
+        }
+    }
+}
+
+// NOTE: role values are usually set after item is added
+// to the model, so need to update index on data changes
+void ConsoleWidgetPrivate::on_data_changed(const QModelIndex &top_left, const QModelIndex &bottom_right, const QList<int> &roles) {
+    if (search_index_map.isEmpty() || top_left.column() != 0) {
+        return;
+    }
+
+    const QList<int> role_list = [&]() {
+        if (roles.isEmpty()) {
+            return search_index_map.keys();
+        }
+
+        QList<int> out;
+        for (const int role : roles) {
+            if (search_index_map.contains(role)) {
+                out.append(role);
+            }
+        }
+
+        return out;
+    }();
+
+    if (role_list.isEmpty()) {
+        return;
+    }
+
+    for (int r = top_left.row(); r <= bottom_right.row(); r++) {
+        const QModelIndex index = top_left.siblingAtRow(r);
+
+        search_index_add(index, role_list);
+    }
+}
+
+void ConsoleWidgetPrivate::search_index_add(const QModelIndex &index, const QList<int> &role_list) {
+    for (const int role : role_list) {
+        const QString value = index.data(role).toString();
+        if (value.isEmpty()) {
+            continue;
+        }
+
+        QMultiHash<QString, QPersistentModelIndex> &index_map = search_index_map[role];
+        const QPersistentModelIndex persistent_index = QPersistentModelIndex(index);
+
+        if (!index_map.contains(value, persistent_index)) {
+            index_map.insert(value, persistent_index);
+        }
+    }
+}
+
+// Returns indexes that have given role value and are
+// equal to or descendants of parent
+QList<QModelIndex> ConsoleWidgetPrivate::search_index_lookup(const QModelIndex &parent, const int role, const QString &value) {
+    QList<QModelIndex> out;
+
+    QMultiHash<QString, QPersistentModelIndex> &index_map = search_index_map[role];
+
+    auto it = index_map.find(value);
+    while (it != index_map.end() && it.key() == value) {
+        const QPersistentModelIndex index = it.value();
+
+        const bool is_outdated = (!index.isValid() || index.data(role).toString() != value);
+        if (is_outdated) {
+            it = index_map.erase(it);
+
+            continue;
+        }
+
+        const bool is_in_parent = [&]() {
+            if (!parent.isValid()) {
+                return true;
+            }
+
+            for (QModelIndex current = index; current.isValid(); current = current.parent()) {
+                if (current == parent) {
+                    return true;
+                }
+            }
+
+            return false;
+        }();
+
+        if (is_in_parent) {
+            out.append(index);
+        }
+
+        it++;
+    }
+
+    return out;
+}
+
 void ConsoleWidgetPrivate::on_focus_changed(QWidget *old, QWidget *now) {
     Q_UNUSED(old);
 
@@ -1358,7 +1576,10 @@ void ConsoleWidgetPrivate::on_scope_expanded(const QModelIndex &index_proxy) {
 
 void ConsoleWidgetPrivate::on_results_activated(const QModelIndex &index) {
     const QModelIndex main_index = index.siblingAtColumn(0);
-    const bool is_scope = main_index.data(ConsoleRole_IsScope).toBool();
+
+    // NOTE: results from impl's own model are never scope
+    // items, even if they have a matching role value
+    const bool is_scope = (main_index.model() == model && main_index.data(ConsoleRole_IsScope).toBool());
 
     if (is_scope) {
         q->set_current_scope(main_index);
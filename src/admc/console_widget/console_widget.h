@@ -44,8 +44,14 @@ class QStandardItem;
 class QMenu;
 class ConsoleImpl;
 class ConsoleDragModel;
+class ConsoleResultsModel;
 
 enum ConsoleRolePublic {
+    // Optional typed value that results are sorted by
+    // instead of display text, for example a number or a
+    // datetime. Set it for each item in a row.
+    ConsoleRole_SortKey = Qt::UserRole + 18,
+
     ConsoleRole_Type = Qt::UserRole + 19,
 
     // NOTE: when implementing custom roles, make sure they do
@@ -108,6 +114,16 @@ public:
     QList<QStandardItem *> add_scope_item(const int type, const QModelIndex &parent);
     QList<QStandardItem *> add_results_item(const int type, const QModelIndex &parent);
 
+    // Batch versions of f-ns above, use these when adding
+    // many items at once. make_*_row() f-ns create a row
+    // that is not yet in the console. Load row's data and
+    // then pass rows to add_rows() which inserts all of
+    // them at once. Note that all rows must be made for
+    // the same parent.
+    QList<QStandardItem *> make_scope_row(const int type, const QModelIndex &parent);
+    QList<QStandardItem *> make_results_row(const int type, const QModelIndex &parent);
+    void add_rows(const QModelIndex &parent, const QList<QList<QStandardItem *>> &row_list);
+
     // Deletes an item and all of it's columns
     void delete_item(const QModelIndex &index);
 
@@ -139,6 +155,12 @@ public:
     QList<QModelIndex> search_items(const QModelIndex &parent, int role, const QVariant &value, const QList<int> &type = QList<int>()) const;
     QList<QModelIndex> search_items(const QModelIndex &parent, const QList<int> &type) const;
 
+    // Adds an index of items by value of given role, which
+    // makes search_items() for that role fast. Values of
+    // this role must be strings. Index is kept up to date
+    // when items are added, changed or removed.
+    void add_search_index(const int role);
+
     // Single index versions of search f-ns. Use when you
     // expect only one valid result or none. QModelIndex()
     // is returned if no items are found.
@@ -206,6 +228,7 @@ private:
     ConsoleWidgetPrivate *d;
 
     friend ConsoleDragModel;
+    friend ConsoleResultsModel;
 };
 
 int console_item_get_type(const QModelIndex &index);
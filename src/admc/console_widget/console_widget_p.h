@@ -49,10 +49,12 @@ enum ConsoleRole {
     ConsoleRole_IsScope = Qt::UserRole + 3,
     ConsoleRole_IsHidden
 
-    // NOTE: don't go above ConsoleRole_Type and
-    // ConsoleRole_LAST (defined in public header)
+    // NOTE: don't go above ConsoleRole_SortKey,
+    // ConsoleRole_Type and ConsoleRole_LAST (defined in
+    // public header)
 
     // NOTE: these roles are "public" defined in public header
+    // ConsoleRole_SortKey = Qt::UserRole + 18,
     // ConsoleRole_Type = Qt::UserRole + 19,
     // ConsoleRole_LAST = Qt::UserRole + 20
 };
@@ -91,6 +93,12 @@ public:
 
     QPersistentModelIndex domain_info_index;
 
+    // Maps role => (role value => items with that value)
+    // NOTE: index may contain outdated entries, for
+    // example if role value changed. These are filtered
+    // out and removed on lookup.
+    QHash<int, QMultiHash<QString, QPersistentModelIndex>> search_index_map;
+
 
     ConsoleWidgetPrivate(ConsoleWidget *q_arg);
 
@@ -109,10 +117,14 @@ public:
     void open_context_menu(const QPoint &global_pos);
     void add_actions(QMenu *menu);
     bool update_actions();
+    void search_index_add(const QModelIndex &index, const QList<int> &role_list);
+    QList<QModelIndex> search_index_lookup(const QModelIndex &parent, const int role, const QString &value);
 
 public slots:
     void on_current_scope_item_changed(const QModelIndex &current, const QModelIndex &);
     void on_scope_items_about_to_be_removed(const QModelIndex &parent, int first, int last);
+    void on_rows_inserted(const QModelIndex &parent, int first, int last);
+    void on_data_changed(const QModelIndex &top_left, const QModelIndex &bottom_right, const QList<int> &roles);
     void on_focus_changed(QWidget *old, QWidget *now);
     void on_refresh();
     void on_customize_columns();
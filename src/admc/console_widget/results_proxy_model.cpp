@@ -0,0 +1,87 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "console_widget/results_proxy_model.h"
+
+#include "console_widget/console_widget.h"
+
+// NOTE: cache is dropped when it grows past this size, so
+// that it doesn't hold keys of strings that are long gone
+#define SORT_KEY_CACHE_MAX 100000
+
+ResultsProxyModel::ResultsProxyModel(QObject *parent)
+: QSortFilterProxyModel(parent) {
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+}
+
+void ResultsProxyModel::setSourceModel(QAbstractItemModel *source_model) {
+    sort_key_cache.clear();
+
+    QSortFilterProxyModel::setSourceModel(source_model);
+}
+
+bool ResultsProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const {
+    const QVariant left_key = left.data(ConsoleRole_SortKey);
+    const QVariant right_key = right.data(ConsoleRole_SortKey);
+
+    // NOTE: if only one of the items has a typed key, then
+    // the other one has no value for this column. Put
+    // empty values first, same as empty display text.
+    if (left_key.isValid() || right_key.isValid()) {
+        if (!left_key.isValid()) {
+            return true;
+        } else if (!right_key.isValid()) {
+            return false;
+        }
+
+        const QPartialOrdering order = QVariant::compare(left_key, right_key);
+        if (order != QPartialOrdering::Unordered) {
+            return (order == QPartialOrdering::Less);
+        }
+    }
+
+    const QString left_text = left.data(sortRole()).toString();
+    const QString right_text = right.data(sortRole()).toString();
+
+    const bool out = (compare_text(left_text, right_text) < 0);
+
+    return out;
+}
+
+int ResultsProxyModel::compare_text(const QString &left, const QString &right) const {
+    if (sort_key_cache.size() > SORT_KEY_CACHE_MAX) {
+        sort_key_cache.clear();
+    }
+
+    auto get_key = [&](const QString &text) {
+        auto it = sort_key_cache.constFind(text);
+        if (it == sort_key_cache.constEnd()) {
+            it = sort_key_cache.insert(text, collator.sortKey(text));
+        }
+
+        return it.value();
+    };
+
+    const QCollatorSortKey left_key = get_key(left);
+    const QCollatorSortKey right_key = get_key(right);
+
+    const int out = left_key.compare(right_key);
+
+    return out;
+}
@@ -0,0 +1,54 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESULTS_PROXY_MODEL_H
+#define RESULTS_PROXY_MODEL_H
+
+#include <QCollator>
+#include <QHash>
+#include <QSortFilterProxyModel>
+
+/**
+ * Proxy model for results views. Items that have a typed
+ * sort key (ConsoleRole_SortKey) are sorted by that key, so
+ * that numbers and datetimes are ordered by value. Other
+ * items are sorted by display text using locale-aware
+ * comparison. Collator sort keys for display text are
+ * computed once per string and reused across comparisons.
+ */
+
+class ResultsProxyModel final : public QSortFilterProxyModel {
+    Q_OBJECT
+
+public:
+    ResultsProxyModel(QObject *parent);
+
+    void setSourceModel(QAbstractItemModel *source_model) override;
+
+protected:
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+private:
+    QCollator collator;
+    mutable QHash<QString, QCollatorSortKey> sort_key_cache;
+
+    int compare_text(const QString &left, const QString &right) const;
+};
+
+#endif /* RESULTS_PROXY_MODEL_H */
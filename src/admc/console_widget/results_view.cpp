@@ -21,6 +21,8 @@
 
 #include "console_widget/results_view.h"
 
+#include "console_widget/results_proxy_model.h"
+
 #include <QHeaderView>
 #include <QListView>
 #include <QSortFilterProxyModel>
@@ -49,8 +51,7 @@ ResultsView::ResultsView(QWidget *parent)
     views[ResultsViewType_List] = list_view;
     views[ResultsViewType_Detail] = m_detail_view;
 
-    proxy_model = new QSortFilterProxyModel(this);
-    proxy_model->setSortCaseSensitivity(Qt::CaseInsensitive);
+    proxy_model = new ResultsProxyModel(this);
 
     // Perform common setup on child views
     for (auto view : views.values()) {
@@ -98,6 +99,12 @@ ResultsView::ResultsView(QWidget *parent)
 }
 
 void ResultsView::set_model(QAbstractItemModel *model) {
+    // NOTE: changing source model resets proxy, so skip
+    // it if model is the same
+    if (proxy_model->sourceModel() == model) {
+        return;
+    }
+
     proxy_model->setSourceModel(model);
 }
 
@@ -50,10 +50,8 @@ QHash<QString, AdObject> ad_search_objects(AdInterface &ad,
 void ad_add_members_to_groups(AdInterface &ad,
                               const  QList<QString> &targets,
                               const QList<QString> &groups) {
-    for (const QString &target : targets) {
-        for (auto group : groups) {
-            ad.group_add_member(group, target);
-        }
+    for (const QString &group : groups) {
+        ad.group_add_members(group, targets);
     }
 }
 
@@ -0,0 +1,227 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gpo_perms_audit_thread.h"
+
+#include "adldap.h"
+#include "core/globals.h"
+
+#include <QMutexLocker>
+#include <QThreadPool>
+
+#include <algorithm>
+
+// NOTE: each worker uses it's own LDAP connection and SMB
+// context, so keep this small
+#define AUDIT_WORKER_COUNT 8
+
+QMutex GpoPermsAuditThread::cache_mutex;
+QHash<QString, GpoPermsAuditThread::CacheEntry> GpoPermsAuditThread::cache;
+
+GpoPermsAuditThread::GpoPermsAuditThread()
+: stop_flag(false),
+  m_failed_to_connect(false),
+  m_not_admin(false) {
+}
+
+void GpoPermsAuditThread::stop() {
+    stop_flag = true;
+}
+
+// NOTE: must be called before thread is started
+void GpoPermsAuditThread::set_sync_list(const QList<QString> &dn_list) {
+    sync_list = dn_list;
+}
+
+void GpoPermsAuditThread::run() {
+    AdInterface ad;
+    if (!ad.is_connected()) {
+        m_failed_to_connect = true;
+        ad_messages = ad.messages();
+
+        return;
+    }
+
+    // NOTE: non-admins can't read full descriptors, so
+    // there's nothing to compare
+    if (!ad.logged_in_as_domain_admin()) {
+        m_not_admin = true;
+        ad_messages = ad.messages();
+
+        return;
+    }
+
+    // NOTE: gpo_sync_perms() already processes GPT
+    // contents in parallel, so policies themselves are
+    // synced one by one
+    for (const QString &dn : sync_list) {
+        if (stop_flag) {
+            break;
+        }
+
+        ad.gpo_sync_perms(dn);
+
+        QMutexLocker locker(&cache_mutex);
+        cache.remove(dn);
+    }
+
+    const QString base = g_adconfig->policies_dn();
+    const SearchScope scope = SearchScope_All;
+    const QString filter = filter_CONDITION(Condition_Equals, ATTRIBUTE_OBJECT_CLASS, CLASS_GP_CONTAINER);
+    const QList<QString> attributes = {ATTRIBUTE_WHEN_CHANGED};
+    const QHash<QString, AdObject> results = ad.search(base, scope, filter, attributes);
+
+    ad_messages = ad.messages();
+
+    QHash<QString, QString> when_changed_map;
+    for (const AdObject &object : results) {
+        const QString dn = object.get_dn();
+
+        if (!sync_list.isEmpty() && !sync_list.contains(dn)) {
+            continue;
+        }
+
+        when_changed_map[dn] = object.get_string(ATTRIBUTE_WHEN_CHANGED);
+    }
+
+    if (stop_flag) {
+        return;
+    }
+
+    check_all(when_changed_map.keys(), when_changed_map);
+}
+
+void GpoPermsAuditThread::check_all(const QList<QString> &dn_list, const QHash<QString, QString> &when_changed_map) {
+    const int total_count = dn_list.size();
+    std::atomic<int> done_count(0);
+
+    QList<GpoPermsAuditResult> cached_list;
+    QList<QString> unchecked_list;
+
+    {
+        QMutexLocker locker(&cache_mutex);
+
+        for (const QString &dn : dn_list) {
+            const bool is_cached = (cache.contains(dn) && cache[dn].when_changed == when_changed_map[dn]);
+
+            if (is_cached) {
+                cached_list.append(cache[dn].result);
+            } else {
+                unchecked_list.append(dn);
+            }
+        }
+    }
+
+    for (const GpoPermsAuditResult &result : cached_list) {
+        emit result_ready(result);
+    }
+
+    done_count = cached_list.size();
+    emit progress(done_count, total_count);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(AUDIT_WORKER_COUNT);
+
+    // NOTE: workers take policies from a shared counter, so
+    // that slow policies don't hold up the rest
+    std::atomic<int> next_index(0);
+
+    auto worker = [&]() {
+        AdInterface worker_ad;
+        if (!worker_ad.is_connected()) {
+            QMutexLocker locker(&messages_mutex);
+            ad_messages.append(worker_ad.messages());
+
+            return;
+        }
+
+        while (!stop_flag) {
+            const int index = next_index++;
+            if (index >= unchecked_list.size()) {
+                break;
+            }
+
+            const QString dn = unchecked_list.at(index);
+
+            const QList<QString> gpc_attributes = QList<QString>();
+            const bool get_sacl = true;
+            const AdObject gpc_object = worker_ad.search_object(dn, gpc_attributes, get_sacl);
+
+            GpoPermsAuditResult result;
+            result.dn = dn;
+            result.name = gpc_object.get_string(ATTRIBUTE_DISPLAY_NAME);
+
+            bool check_ok = true;
+            result.perms_ok = worker_ad.gpo_check_perms(gpc_object, &check_ok);
+            result.check_ok = check_ok;
+
+            // NOTE: errors are reported as part of result,
+            // instead of showing a message for every
+            // policy
+            if (!check_ok) {
+                QList<QString> error_list;
+                for (const AdMessage &message : worker_ad.messages()) {
+                    if (message.type() == AdMessageType_Error) {
+                        error_list.append(message.text());
+                    }
+                }
+
+                result.error = error_list.join("\n");
+            }
+
+            worker_ad.clear_messages();
+
+            if (check_ok) {
+                QMutexLocker locker(&cache_mutex);
+
+                cache[dn] = {when_changed_map[dn], result};
+            }
+
+            emit result_ready(result);
+
+            const int new_done_count = ++done_count;
+            emit progress(new_done_count, total_count);
+        }
+    };
+
+    const int worker_count = std::min((int) unchecked_list.size(), AUDIT_WORKER_COUNT);
+    for (int i = 0; i < worker_count; i++) {
+        pool.start(worker);
+    }
+
+    pool.waitForDone();
+}
+
+bool GpoPermsAuditThread::failed_to_connect() const {
+    return m_failed_to_connect;
+}
+
+bool GpoPermsAuditThread::not_admin() const {
+    return m_not_admin;
+}
+
+QList<AdMessage> GpoPermsAuditThread::get_ad_messages() const {
+    return ad_messages;
+}
+
+void GpoPermsAuditThread::clear_cache() {
+    QMutexLocker locker(&cache_mutex);
+
+    cache.clear();
+}
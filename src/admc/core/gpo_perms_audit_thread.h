@@ -0,0 +1,100 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GPO_PERMS_AUDIT_THREAD_H
+#define GPO_PERMS_AUDIT_THREAD_H
+
+/**
+ * A thread that checks whether GPT permissions match GPC
+ * permissions for all policies in the domain. Checks are
+ * spread over a pool of workers, each with it's own
+ * AdInterface, so they use multiple LDAP connections and
+ * SMB contexts. result_ready() is emitted for each policy
+ * as soon as it is checked and progress() after it. Use
+ * stop() to cancel remaining checks. Note that creator of
+ * thread should call thread's deleteLater() in the
+ * finished() slot.
+ *
+ * If sync list is set, permissions of policies in the list
+ * are synced first and then only those policies are
+ * checked.
+ *
+ * Results are cached by GPC's whenChanged, so policies
+ * that didn't change since last audit are not checked
+ * again. Note that changes made only to GPT don't change
+ * whenChanged, call clear_cache() to recheck everything.
+ */
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <atomic>
+
+class AdMessage;
+
+struct GpoPermsAuditResult {
+    QString dn;
+    QString name;
+    // False if check couldn't be performed, in which case
+    // "error" contains the reason
+    bool check_ok;
+    bool perms_ok;
+    QString error;
+};
+
+class GpoPermsAuditThread final : public QThread {
+    Q_OBJECT
+
+public:
+    GpoPermsAuditThread();
+
+    void stop();
+    void set_sync_list(const QList<QString> &dn_list);
+    bool failed_to_connect() const;
+    bool not_admin() const;
+    QList<AdMessage> get_ad_messages() const;
+
+    static void clear_cache();
+
+signals:
+    void result_ready(const GpoPermsAuditResult &result);
+    void progress(const int done_count, const int total_count);
+
+private:
+    struct CacheEntry {
+        QString when_changed;
+        GpoPermsAuditResult result;
+    };
+
+    static QMutex cache_mutex;
+    static QHash<QString, CacheEntry> cache;
+
+    std::atomic<bool> stop_flag;
+    QList<QString> sync_list;
+    bool m_failed_to_connect;
+    bool m_not_admin;
+    QMutex messages_mutex;
+    QList<AdMessage> ad_messages;
+
+    void run() override;
+    void check_all(const QList<QString> &dn_list, const QHash<QString, QString> &when_changed_map);
+};
+
+#endif /* GPO_PERMS_AUDIT_THREAD_H */
@@ -28,6 +28,7 @@
 #include "ad_object.h"
 #include "ad_config.h"
 #include "ad_filter.h"
+#include "ad_utils.h"
 #include "core/globals.h"
 #include "gplink.h"
 #include "utils.h"
@@ -42,25 +43,68 @@ void GPLinkManager::update() {
 
     is_updated = false;
 
+    {
+        QMutexLocker locker(&mutex);
+        pending_topology = Topology();
+    }
+
     const QString &filter = filter_OR({filter_CONDITION(Condition_Equals, ATTRIBUTE_OBJECT_CLASS, CLASS_OU),
-                                      filter_CONDITION(Condition_Equals, ATTRIBUTE_OBJECT_CLASS, CLASS_DOMAIN)});
+                                      filter_CONDITION(Condition_Equals, ATTRIBUTE_OBJECT_CLASS, CLASS_DOMAIN),
+                                      filter_CONDITION(Condition_Equals, ATTRIBUTE_OBJECT_CLASS, CLASS_GP_CONTAINER)});
     auto search_thread = new SearchThread(g_adconfig->domain_dn(),
                                           SearchScope_All,
                                           filter,
-                                          {ATTRIBUTE_GPLINK});
+                                          {ATTRIBUTE_OBJECT_CLASS,
+                                           ATTRIBUTE_GPLINK,
+                                           ATTRIBUTE_GPOPTIONS,
+                                           ATTRIBUTE_NAME,
+                                           ATTRIBUTE_DISPLAY_NAME});
+
+    // NOTE: index has to contain all OU's, so don't stop at
+    // object display limit
+    search_thread->set_fetch_more_enabled(true);
+    connect(search_thread, &SearchThread::paused, search_thread, &SearchThread::fetch_more);
 
     connect(search_thread, &SearchThread::results_ready, this, [this](const QHash<QString, AdObject> &results) {
-        for (const QString &dn : results.keys()) {
+        QMutexLocker locker(&mutex);
+
+        for (const AdObject &object : results) {
+            const QString dn = object.get_dn();
+
+            if (object.is_class(CLASS_GP_CONTAINER)) {
+                pending_topology.gpo_name_map[dn.toLower()] = object.get_string(ATTRIBUTE_DISPLAY_NAME);
+
+                continue;
+            }
+
+            OUEntry &entry = topology_get_ou(&pending_topology, dn);
+            entry.name = object.get_string(ATTRIBUTE_NAME);
+            entry.inheritance_blocked = (object.get_string(ATTRIBUTE_GPOPTIONS) == GPOPTIONS_BLOCK_INHERITANCE);
+
             // Make gplink trimmed because some values can contain only spaces for some reason
-            const QString gplink_str = results[dn].get_string(ATTRIBUTE_GPLINK).trimmed();
+            const QString gplink_str = object.get_string(ATTRIBUTE_GPLINK).trimmed();
             if (!gplink_str.isEmpty()) {
-                set_gplink(dn, results[dn].get_string(ATTRIBUTE_GPLINK));
+                topology_set_gplink(&pending_topology, dn, object.get_string(ATTRIBUTE_GPLINK));
             }
         }
     });
 
     connect(search_thread, &SearchThread::finished, this, [this, search_thread]() {
-        failed_to_update = search_thread->failed_to_connect();
+        // NOTE: keep previous topology if search didn't
+        // load all objects, partial topology would be
+        // missing inherited policies
+        failed_to_update = !search_thread->is_complete();
+
+        {
+            QMutexLocker locker(&mutex);
+
+            if (!failed_to_update) {
+                topology = pending_topology;
+            }
+
+            pending_topology = Topology();
+        }
+
         is_updated = true;
 
         search_thread->deleteLater();
@@ -71,11 +115,26 @@ void GPLinkManager::update() {
 
 void GPLinkManager::set_gplink(const QString &ou_dn, const QString &gplink_str) {
     QMutexLocker locker(&mutex);
-    ou_links[ou_dn] = gplink_str;
+
+    topology_set_gplink(&topology, ou_dn, gplink_str);
+
+    // NOTE: also apply change to topology that is being
+    // loaded, in case it was loaded before the change
+    if (!is_updated) {
+        topology_set_gplink(&pending_topology, ou_dn, gplink_str);
+    }
 }
 
 QString GPLinkManager::ou_gplink(const QString &ou_dn) const {
-    return ou_links.value(ou_dn, QString());
+    QMutexLocker locker(&mutex);
+
+    return topology.ou_links.value(ou_dn, QString());
+}
+
+Gplink GPLinkManager::ou_gplink_parsed(const QString &ou_dn) const {
+    QMutexLocker locker(&mutex);
+
+    return topology.ou_map.value(ou_dn.toLower()).gplink;
 }
 
 bool GPLinkManager::update_failed() {
@@ -83,17 +142,167 @@ bool GPLinkManager::update_failed() {
 }
 
 const QHash<QString, QString> &GPLinkManager::gplinks_map() const {
-    return ou_links;
+    return topology.ou_links;
 }
 
 QStringList GPLinkManager::linked_ou_list(const QString &policy_dn) const {
-    QStringList ou_dn_list;
-    for (const QString &ou_dn : ou_links.keys()) {
-        Gplink gplink = Gplink(ou_links[ou_dn]);
-        if (gplink.contains(policy_dn)) {
-            ou_dn_list.append(ou_dn);
+    QMutexLocker locker(&mutex);
+
+    const QSet<QString> ou_set = topology.gpo_ou_map.value(policy_dn.toLower());
+
+    return QStringList(ou_set.begin(), ou_set.end());
+}
+
+QList<EffectivePolicy> GPLinkManager::effective_policy_list(const QString &ou_dn) const {
+    QMutexLocker locker(&mutex);
+
+    QList<EffectivePolicy> enforced_list;
+    QList<EffectivePolicy> normal_list;
+    bool inheritance_blocked = false;
+
+    // Go up the OU chain, starting from OU itself
+    QString dn = ou_dn;
+    while (!dn.isEmpty()) {
+        const QString key = dn.toLower();
+
+        if (topology.ou_map.contains(key)) {
+            const OUEntry &entry = topology.ou_map[key];
+
+            // NOTE: enforced links of parents take
+            // precedence over enforced links of children,
+            // so they are inserted before them
+            QList<EffectivePolicy> level_enforced_list;
+
+            for (const QString &gpo_dn : entry.gpo_list) {
+                if (entry.disabled_set.contains(gpo_dn)) {
+                    continue;
+                }
+
+                const bool is_enforced = entry.enforced_set.contains(gpo_dn);
+                const EffectivePolicy policy = {gpo_dn, entry.dn, is_enforced};
+
+                if (is_enforced) {
+                    level_enforced_list.append(policy);
+                } else if (!inheritance_blocked) {
+                    normal_list.append(policy);
+                }
+            }
+
+            enforced_list = level_enforced_list + enforced_list;
+
+            // NOTE: blocking inheritance on OU blocks links
+            // of it's parents, but not it's own links
+            if (entry.inheritance_blocked) {
+                inheritance_blocked = true;
+            }
         }
+
+        const QString parent_dn = dn_get_parent(dn);
+        if (parent_dn == dn) {
+            break;
+        }
+
+        dn = parent_dn;
+    }
+
+    // Same GPO may be linked at multiple levels, only keep
+    // the link with highest precedence
+    QList<EffectivePolicy> out;
+    QSet<QString> added_set;
+
+    for (const EffectivePolicy &policy : enforced_list + normal_list) {
+        const QString gpo_key = policy.gpo_dn.toLower();
+
+        if (!added_set.contains(gpo_key)) {
+            out.append(policy);
+            added_set.insert(gpo_key);
+        }
+    }
+
+    return out;
+}
+
+void GPLinkManager::set_inheritance_blocked(const QString &ou_dn, const bool blocked) {
+    QMutexLocker locker(&mutex);
+
+    topology_get_ou(&topology, ou_dn).inheritance_blocked = blocked;
+
+    if (!is_updated) {
+        topology_get_ou(&pending_topology, ou_dn).inheritance_blocked = blocked;
+    }
+}
+
+QString GPLinkManager::gpo_name(const QString &gpo_dn) const {
+    QMutexLocker locker(&mutex);
+
+    return topology.gpo_name_map.value(gpo_dn.toLower());
+}
+
+void GPLinkManager::set_gpo_name(const QString &gpo_dn, const QString &name) {
+    QMutexLocker locker(&mutex);
+
+    topology.gpo_name_map[gpo_dn.toLower()] = name;
+
+    if (!is_updated) {
+        pending_topology.gpo_name_map[gpo_dn.toLower()] = name;
+    }
+}
+
+QString GPLinkManager::ou_name(const QString &ou_dn) const {
+    QMutexLocker locker(&mutex);
+
+    const QString key = ou_dn.toLower();
+
+    if (topology.ou_map.contains(key) && !topology.ou_map[key].name.isEmpty()) {
+        return topology.ou_map[key].name;
+    } else {
+        return dn_get_name(ou_dn);
+    }
+}
+
+void GPLinkManager::topology_set_gplink(Topology *target, const QString &ou_dn, const QString &gplink_str) {
+    target->ou_links[ou_dn] = gplink_str;
+
+    OUEntry &entry = topology_get_ou(target, ou_dn);
+
+    // Unlink OU from GPO's of previous gplink
+    for (const QString &gpo_dn : entry.gpo_list) {
+        const QString gpo_key = gpo_dn.toLower();
+
+        target->gpo_ou_map[gpo_key].remove(entry.dn);
+
+        if (target->gpo_ou_map[gpo_key].isEmpty()) {
+            target->gpo_ou_map.remove(gpo_key);
+        }
+    }
+
+    entry.gplink = Gplink(gplink_str);
+    entry.gpo_list = entry.gplink.get_gpo_list();
+    entry.enforced_set.clear();
+    entry.disabled_set.clear();
+
+    for (const QString &gpo_dn : entry.gpo_list) {
+        if (entry.gplink.get_option(gpo_dn, GplinkOption_Enforced)) {
+            entry.enforced_set.insert(gpo_dn);
+        }
+
+        if (entry.gplink.get_option(gpo_dn, GplinkOption_Disabled)) {
+            entry.disabled_set.insert(gpo_dn);
+        }
+
+        target->gpo_ou_map[gpo_dn.toLower()].insert(entry.dn);
+    }
+}
+
+GPLinkManager::OUEntry &GPLinkManager::topology_get_ou(Topology *target, const QString &ou_dn) {
+    const QString key = ou_dn.toLower();
+
+    if (!target->ou_map.contains(key)) {
+        OUEntry entry;
+        entry.dn = ou_dn;
+
+        target->ou_map.insert(key, entry);
     }
 
-    return ou_dn_list;
+    return target->ou_map[key];
 }
@@ -24,11 +24,38 @@
 #ifndef GPLINKMANAGER_H
 #define GPLINKMANAGER_H
 
+/**
+ * Keeps an in-memory index of group policy topology, loaded
+ * by one subtree search in update(): gPLink's of all OU's
+ * (and domain), which OU's each GPO is linked to, OU's
+ * that block inheritance and display names of GPO's.
+ * Effective policies of any OU can then be computed
+ * without going to the server. Index is updated
+ * incrementally when gplinks change through ADMC. Changes
+ * made outside of ADMC are picked up on next update().
+ */
+
 #include <QObject>
 #include <QHash>
+#include <QList>
+#include <QSet>
 #include <QString>
 #include <QMutex>
 
+#include "gplink.h"
+
+// Policy that applies to an OU, see
+// GPLinkManager::effective_policy_list()
+struct EffectivePolicy {
+    // GPO dn with correct letter case, see
+    // Gplink::get_gpo_list()
+    QString gpo_dn;
+    // OU that GPO is linked to, may be OU itself or one of
+    // it's parents
+    QString ou_dn;
+    bool is_enforced = false;
+};
+
 class GPLinkManager final : public QObject {
     Q_OBJECT
 
@@ -38,16 +65,69 @@ public:
     void update();
     void set_gplink(const QString &ou_dn, const QString &gplink_str);
     QString ou_gplink(const QString &ou_dn) const;
+    // Parsed version of ou_gplink(), parsing is done once
+    // when gplink is set
+    Gplink ou_gplink_parsed(const QString &ou_dn) const;
     bool update_failed();
     const QHash<QString, QString>& gplinks_map() const;
     QStringList linked_ou_list(const QString &policy_dn) const;
 
+    // Returns policies that apply to OU, in order of
+    // precedence, highest first. Enforced links come first,
+    // links of parents first. Then the rest, links of
+    // children first, excluding those above OU's that block
+    // inheritance. Disabled links are skipped.
+    QList<EffectivePolicy> effective_policy_list(const QString &ou_dn) const;
+
+    void set_inheritance_blocked(const QString &ou_dn, const bool blocked);
+
+    // Returns empty string if name is unknown, for example
+    // for GPO's that were created after last update()
+    QString gpo_name(const QString &gpo_dn) const;
+    void set_gpo_name(const QString &gpo_dn, const QString &name);
+
+    // Returns name of OU, which is "name" attribute, or name
+    // from dn if OU wasn't loaded
+    QString ou_name(const QString &ou_dn) const;
+
 private:
-    // OU DN - key, GPLink string - value. DN keys can contain domain dn.
-    QHash<QString, QString> ou_links;
+    struct OUEntry {
+        // Dn with original letter case
+        QString dn;
+        QString name;
+        Gplink gplink;
+        // GPO dn's in link order, see
+        // Gplink::get_gpo_list()
+        QList<QString> gpo_list;
+        QSet<QString> enforced_set;
+        QSet<QString> disabled_set;
+        bool inheritance_blocked = false;
+    };
+
+    struct Topology {
+        // OU DN - key, GPLink string - value. DN keys can contain domain dn.
+        QHash<QString, QString> ou_links;
+
+        // NOTE: keys of maps below are lower-cased dn's,
+        // since gplink stores dn's in a different letter
+        // case
+        QHash<QString, OUEntry> ou_map;
+        // GPO dn => dn's of OU's it's linked to
+        QHash<QString, QSet<QString>> gpo_ou_map;
+        QHash<QString, QString> gpo_name_map;
+    };
+
+    Topology topology;
+    // Topology that is being loaded by update(). Replaces
+    // current one once loading finishes, so that users
+    // don't see a half-loaded index in the meantime.
+    Topology pending_topology;
     mutable QMutex mutex;
     bool is_updated;
     bool failed_to_update = false;
+
+    static void topology_set_gplink(Topology *target, const QString &ou_dn, const QString &gplink_str);
+    static OUEntry &topology_get_ou(Topology *target, const QString &ou_dn);
 };
 
 #endif // GPLINKMANAGER_H
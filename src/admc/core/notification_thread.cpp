@@ -0,0 +1,138 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "notification_thread.h"
+
+#include "adldap.h"
+
+#include <QHash>
+
+// NOTE: AD allows 5 notifications per connection by
+// default (MaxNotificationPerConn)
+#define MAX_CONTAINER_COUNT 5
+
+// How often thread checks for stop and for changes of
+// container list while waiting for notifications
+#define WAIT_INTERVAL_MILLIS 500
+
+#define RECONNECT_DELAY_MILLIS (30 * 1000)
+
+NotificationThread::NotificationThread(const QList<QString> &attributes_arg, QObject *parent)
+: QThread(parent),
+  stop_flag(false),
+  attributes(attributes_arg) {
+}
+
+void NotificationThread::stop() {
+    QMutexLocker locker(&mutex);
+
+    stop_flag = true;
+    wake_condition.wakeAll();
+}
+
+void NotificationThread::set_container_list(const QList<QString> &container_list_arg) {
+    QMutexLocker locker(&mutex);
+
+    container_list = container_list_arg.mid(0, MAX_CONTAINER_COUNT);
+    wake_condition.wakeAll();
+}
+
+int NotificationThread::max_container_count() {
+    return MAX_CONTAINER_COUNT;
+}
+
+void NotificationThread::run() {
+    while (!stop_flag) {
+        {
+            AdInterface ad;
+            if (ad.is_connected()) {
+                watch(ad);
+            }
+        }
+
+        if (!stop_flag) {
+            wait_for_wake(RECONNECT_DELAY_MILLIS);
+        }
+    }
+}
+
+// Returns when connection fails or thread is stopped
+void NotificationThread::watch(AdInterface &ad) {
+    // Container => notification id, -1 if notification
+    // failed to start
+    QHash<QString, int> notification_map;
+
+    while (!stop_flag) {
+        const QList<QString> container_list_now = [&]() {
+            QMutexLocker locker(&mutex);
+
+            return container_list;
+        }();
+
+        for (const QString &container : notification_map.keys()) {
+            if (!container_list_now.contains(container)) {
+                const int notification_id = notification_map.take(container);
+                ad.notification_stop(notification_id);
+            }
+        }
+
+        bool any_started = false;
+
+        for (const QString &container : container_list_now) {
+            if (!notification_map.contains(container)) {
+                const int notification_id = ad.notification_start(container, attributes);
+                notification_map[container] = notification_id;
+            }
+
+            if (notification_map[container] != -1) {
+                any_started = true;
+            }
+        }
+
+        if (!any_started) {
+            wait_for_wake(WAIT_INTERVAL_MILLIS);
+
+            continue;
+        }
+
+        QHash<QString, AdObject> results;
+        const bool success = ad.notification_wait(WAIT_INTERVAL_MILLIS, &results);
+
+        if (!results.isEmpty() && !stop_flag) {
+            emit objects_changed(results);
+        }
+
+        if (!success) {
+            break;
+        }
+    }
+
+    // NOTE: remaining notifications are abandoned by
+    // AdInterface when it's destroyed
+}
+
+void NotificationThread::wait_for_wake(const int timeout_millis) {
+    QMutexLocker locker(&mutex);
+
+    if (stop_flag) {
+        return;
+    }
+
+    wake_condition.wait(&mutex, timeout_millis);
+}
@@ -0,0 +1,71 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NOTIFICATION_THREAD_H
+#define NOTIFICATION_THREAD_H
+
+/**
+ * A thread that watches containers for changes made
+ * outside of this app, using AD change notifications.
+ * objects_changed() is emitted with objects that were
+ * added, modified, moved or deleted in watched containers.
+ * Deleted objects have isDeleted set. Objects that were
+ * moved out of a watched container are returned with their
+ * new DN. Set watched containers with set_container_list(),
+ * only the first few are watched because AD limits the
+ * number of notifications per connection. If connection is
+ * lost, thread reconnects after a delay. Call stop() and
+ * wait() before deleting the thread.
+ */
+
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+
+class AdObject;
+class AdInterface;
+
+class NotificationThread final : public QThread {
+    Q_OBJECT
+
+public:
+    NotificationThread(const QList<QString> &attributes, QObject *parent);
+
+    void stop();
+    void set_container_list(const QList<QString> &container_list);
+
+    static int max_container_count();
+
+signals:
+    void objects_changed(const QHash<QString, AdObject> &objects);
+
+private:
+    std::atomic<bool> stop_flag;
+    mutable QMutex mutex;
+    QWaitCondition wake_condition;
+    QList<QString> container_list;
+    QList<QString> attributes;
+
+    void run() override;
+    void watch(AdInterface &ad);
+    void wait_for_wake(const int timeout_millis);
+};
+
+#endif /* NOTIFICATION_THREAD_H */
@@ -26,29 +26,83 @@
 
 #include <QHash>
 
+// NOTE: server drops paged search state after a while, so
+// there's no point in staying paused for too long
+#define PAUSE_TIMEOUT_MILLIS (5 * 60 * 1000)
+
+// Max number of objects in one results_ready() batch and
+// max number of batches that can wait in receiver's queue
+#define BATCH_SIZE 200
+#define MAX_PENDING_BATCH_COUNT 4
+
 SearchThread::SearchThread(const QString base_arg,
                            const SearchScope scope_arg,
                            const QString &filter_arg,
                            const QList<QString> attributes_arg) :
     stop_flag(false),
+    fetch_more_enabled(false),
+    m_can_fetch_more(false),
+    result_limit(0),
+    pending_batch_count(0),
     base(base_arg),
     scope(scope_arg),
     filter(filter_arg),
     attributes(attributes_arg),
     id(0),
     m_failed_to_connect(false),
-    m_hit_object_display_limit(false)
+    m_hit_object_display_limit(false),
+    m_is_complete(false)
 {
     static int id_max = 0;
     id = id_max;
     id_max++;
+
+    // NOTE: thread object lives in the thread that created
+    // it, so this slot runs in receivers' thread after
+    // batch is delivered. This connection is made before
+    // any others, so it runs before other receivers.
+    connect(
+        this, &SearchThread::results_ready,
+        this, &SearchThread::on_batch_delivered,
+        Qt::QueuedConnection);
 }
 
 void SearchThread::stop() {
+    QMutexLocker locker(&pause_mutex);
+
     stop_flag = true;
+    pause_condition.wakeAll();
+}
+
+// NOTE: must be called before thread is started
+void SearchThread::set_fetch_more_enabled(const bool enabled) {
+    fetch_more_enabled = enabled;
+}
+
+bool SearchThread::can_fetch_more() const {
+    QMutexLocker locker(&pause_mutex);
+
+    return m_can_fetch_more;
+}
+
+void SearchThread::fetch_more() {
+    QMutexLocker locker(&pause_mutex);
+
+    if (!m_can_fetch_more) {
+        return;
+    }
+
+    const int object_display_limit = settings_get_int(SETTING_object_display_limit);
+    result_limit += object_display_limit;
+
+    m_can_fetch_more = false;
+    pause_condition.wakeAll();
 }
 
 void SearchThread::run() {
+    QElapsedTimer timer;
+    timer.start();
+
     AdInterface ad;
     if (!ad.is_connected()) {
         m_failed_to_connect = true;
@@ -57,11 +111,12 @@ void SearchThread::run() {
     }
 
     AdCookie cookie;
+    cookie.set_cancel_token(&stop_flag);
 
-    const int object_display_limit =
-        settings_get_int(SETTING_object_display_limit);
+    result_limit = settings_get_int(SETTING_object_display_limit);
 
     int total_results_count = 0;
+    int page_count = 0;
 
     while (true) {
         QHash<QString, AdObject> results;
@@ -69,27 +124,125 @@ void SearchThread::run() {
         const bool success =
             ad.search_paged(base, scope, filter, attributes, &results, &cookie);
 
-        total_results_count += results.count();
+        if (stop_flag) {
+            break;
+        }
 
-        if (total_results_count > object_display_limit) {
+        page_count++;
+
+        // NOTE: if page crosses display limit, still
+        // return objects up to the limit
+        const bool over_limit = (total_results_count + results.count() > result_limit);
+        if (!fetch_more_enabled && over_limit) {
             m_hit_object_display_limit = true;
 
-            break;
+            const int remaining_count = result_limit - total_results_count;
+            QHash<QString, AdObject> limited_results;
+            for (auto it = results.cbegin(); it != results.cend() && limited_results.size() < remaining_count; it++) {
+                limited_results.insert(it.key(), it.value());
+            }
+
+            results = limited_results;
         }
 
+        total_results_count += results.count();
+
         ad_messages = ad.messages();
 
-        emit results_ready(results);
+        emit_results(results);
+
+        emit progress(total_results_count, page_count, timer.elapsed());
 
-        const bool search_interrupted = (!success || stop_flag);
+        const bool search_interrupted = (!success || stop_flag || m_hit_object_display_limit);
         if (search_interrupted) {
             break;
         }
 
         if (!cookie.more_pages()) {
+            m_is_complete = true;
+
+            break;
+        }
+
+        if (fetch_more_enabled && total_results_count >= result_limit) {
+            const bool resumed = wait_for_fetch_more();
+            if (!resumed) {
+                break;
+            }
+        }
+    }
+}
+
+// Splits results into batches. Waits before emitting a
+// batch if receivers haven't processed previous ones yet.
+void SearchThread::emit_results(const QHash<QString, AdObject> &results) {
+    QHash<QString, AdObject> batch;
+
+    for (auto it = results.cbegin(); it != results.cend(); it++) {
+        batch.insert(it.key(), it.value());
+
+        const bool is_last = (std::next(it) == results.cend());
+        const bool batch_is_full = (batch.size() >= BATCH_SIZE);
+        if (!batch_is_full && !is_last) {
+            continue;
+        }
+
+        {
+            QMutexLocker locker(&pause_mutex);
+
+            while (pending_batch_count >= MAX_PENDING_BATCH_COUNT && !stop_flag) {
+                pause_condition.wait(&pause_mutex);
+            }
+
+            if (stop_flag) {
+                return;
+            }
+
+            pending_batch_count++;
+        }
+
+        emit results_ready(batch);
+
+        batch.clear();
+    }
+}
+
+void SearchThread::on_batch_delivered() {
+    QMutexLocker locker(&pause_mutex);
+
+    pending_batch_count--;
+    pause_condition.wakeAll();
+}
+
+// Returns true if search should continue, false if it was
+// stopped or timed out while paused
+bool SearchThread::wait_for_fetch_more() {
+    {
+        QMutexLocker locker(&pause_mutex);
+
+        if (stop_flag) {
+            return false;
+        }
+
+        m_can_fetch_more = true;
+    }
+
+    emit paused();
+
+    QMutexLocker locker(&pause_mutex);
+
+    while (m_can_fetch_more && !stop_flag) {
+        const bool woken = pause_condition.wait(&pause_mutex, PAUSE_TIMEOUT_MILLIS);
+        if (!woken) {
             break;
         }
     }
+
+    const bool resumed = (!m_can_fetch_more && !stop_flag);
+
+    m_can_fetch_more = false;
+
+    return resumed;
 }
 
 int SearchThread::get_id() const {
@@ -107,3 +260,7 @@ bool SearchThread::hit_object_display_limit() const {
 QList<AdMessage> SearchThread::get_ad_messages() const {
     return ad_messages;
 }
+
+bool SearchThread::is_complete() const {
+    return m_is_complete;
+}
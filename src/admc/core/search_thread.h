@@ -26,15 +26,31 @@
  * A thread that performs an AD search operation. Useful for
  * searches that are expected to take a long time. For
  * regular small searches this is overkill. results_ready()
- * signal returns search results as they arrive. If search
- * has multiple pages, then results_ready() will be emitted
- * multiple times. Use stop() to stop search. Note that search is
- * not stopped immediately but when current results page is
- * done processing. Note that creator of thread should call
- * thread's deleteLater() in the finished() slot.
+ * signal returns search results as they arrive, in batches
+ * of limited size. Thread waits for receivers to catch up
+ * if too many batches are queued, so that the GUI thread
+ * isn't flooded with results. progress() is emitted after
+ * every page. Use stop() to stop search. Stopping takes
+ * effect even in the middle of a page, request for the
+ * page is abandoned. Note that creator of thread should
+ * call thread's deleteLater() in the finished() slot.
+ *
+ * By default, search stops once it returns more objects
+ * than the object display limit. Objects up to the limit
+ * are still returned. If fetch more is enabled, search
+ * instead pauses after every display limit's worth of
+ * objects and emits paused(). Call fetch_more() to continue
+ * with the next chunk of pages. Paused search keeps it's
+ * connection and paging cookie, so that it continues from
+ * the same place. Search that stays paused for too long is
+ * stopped.
  */
 
+#include <QElapsedTimer>
+#include <QMutex>
 #include <QThread>
+#include <QWaitCondition>
+#include <atomic>
 
 #include "ad_defines.h"
 
@@ -51,17 +67,33 @@ public:
                  const QList<QString> attributes);
 
     void stop();
+    void set_fetch_more_enabled(const bool enabled);
+    bool can_fetch_more() const;
+    void fetch_more();
     int get_id() const;
     bool failed_to_connect() const;
     bool hit_object_display_limit() const;
     QList<AdMessage> get_ad_messages() const;
 
+    // Returns true if all pages of search were received.
+    // False if search failed to connect, failed midway,
+    // was stopped or hit object display limit.
+    bool is_complete() const;
+
 signals:
     void results_ready(const QHash<QString, AdObject> &results);
+    void progress(const int object_count, const int page_count, const qint64 elapsed_ms);
     void over_object_display_limit();
+    void paused();
 
 private:
-    bool stop_flag;
+    std::atomic<bool> stop_flag;
+    bool fetch_more_enabled;
+    bool m_can_fetch_more;
+    int result_limit;
+    int pending_batch_count;
+    mutable QMutex pause_mutex;
+    QWaitCondition pause_condition;
     QString base;
     SearchScope scope;
     QString filter;
@@ -69,9 +101,13 @@ private:
     int id;
     bool m_failed_to_connect;
     bool m_hit_object_display_limit;
+    std::atomic<bool> m_is_complete;
     QList<AdMessage> ad_messages;
 
     void run() override;
+    void emit_results(const QHash<QString, AdObject> &results);
+    void on_batch_delivered();
+    bool wait_for_fetch_more();
 };
 
 #endif /* SEARCH_THREAD_H */
@@ -28,7 +28,12 @@
 #include <QDialog>
 #include <QHeaderView>
 #include <QLocale>
+#include <QMultiHash>
+#include <QMutex>
+#include <QPointer>
+#include <QReadWriteLock>
 #include <QSettings>
+#include <QThreadPool>
 
 const QHash<QString, QVariant> setting_default_map = {
     {SETTING_advanced_features, false},
@@ -56,6 +61,7 @@ const QHash<QString, QVariant> setting_default_map = {
     {SETTING_feature_profile_tab, false},
     {SETTING_feature_dev_mode, false},
     {SETTING_feature_current_locale_first, false},
+    {SETTING_feature_live_updates, false},
 };
 
 void settings_setup_dialog_geometry(const QString setting, QDialog *dialog) {
@@ -101,20 +107,188 @@ bool settings_restore_header_state(const QString setting, QHeaderView *header) {
     }
 }
 
+// NOTE: QSettings reads and parses the settings file
+// every time it is constructed, which is too slow for
+// settings that are read in loops. Instead, settings are
+// loaded once into memory and all reads are served from
+// there. Changes are applied in memory immediately and
+// written to the file in the background. Writes are done
+// by a single thread, so they are applied in order. Note
+// that changes made to the file by other processes after
+// the first load are not picked up.
+
+struct SettingsSubscription {
+    QPointer<QObject> context;
+    std::function<void(const QVariant &)> callback;
+};
+
+static QReadWriteLock settings_cache_lock;
+static bool settings_cache_loaded = false;
+static QHash<QString, QVariant> settings_cache;
+
+static QMutex settings_write_mutex;
+static QHash<QString, QVariant> settings_pending_write_map;
+static bool settings_write_scheduled = false;
+
+static QMutex settings_subscription_mutex;
+static QMultiHash<QString, SettingsSubscription> settings_subscription_map;
+
+static void settings_cache_load();
+static void settings_write_pending();
+static void settings_notify(const QString &setting, const QVariant &value);
+static QThreadPool *settings_write_pool();
+
 QVariant settings_get_variant(const QString setting) {
-    QSettings settings;
+    settings_cache_load();
 
-    const QVariant default_value = setting_default_map.value(setting, QVariant());
+    QReadLocker locker(&settings_cache_lock);
 
-    const QVariant value = settings.value(setting, default_value);
+    if (settings_cache.contains(setting)) {
+        return settings_cache.value(setting);
+    } else {
+        const QVariant default_value = setting_default_map.value(setting, QVariant());
 
-    return value;
+        return default_value;
+    }
 }
 
 void settings_set_variant(const QString setting, const QVariant &value) {
+    settings_cache_load();
+
+    const bool value_changed = [&]() {
+        QWriteLocker locker(&settings_cache_lock);
+
+        const QVariant default_value = setting_default_map.value(setting, QVariant());
+        const QVariant old_value = settings_cache.value(setting, default_value);
+
+        settings_cache.insert(setting, value);
+
+        return (old_value != value);
+    }();
+
+    {
+        QMutexLocker locker(&settings_write_mutex);
+
+        settings_pending_write_map.insert(setting, value);
+
+        if (!settings_write_scheduled) {
+            settings_write_scheduled = true;
+            settings_write_pool()->start(settings_write_pending);
+        }
+    }
+
+    if (value_changed) {
+        settings_notify(setting, value);
+    }
+}
+
+void settings_connect(const QString &setting, QObject *context, const std::function<void(const QVariant &)> &callback) {
+    QMutexLocker locker(&settings_subscription_mutex);
+
+    SettingsSubscription subscription;
+    subscription.context = context;
+    subscription.callback = callback;
+
+    settings_subscription_map.insert(setting, subscription);
+}
+
+void settings_flush() {
+    settings_write_pool()->waitForDone();
+}
+
+void settings_cache_load() {
+    {
+        QReadLocker locker(&settings_cache_lock);
+
+        if (settings_cache_loaded) {
+            return;
+        }
+    }
+
+    QWriteLocker locker(&settings_cache_lock);
+
+    // NOTE: check again because another thread could've
+    // loaded cache while we were waiting for write lock
+    if (settings_cache_loaded) {
+        return;
+    }
+
+    const QSettings settings;
+
+    for (const QString &setting : settings.allKeys()) {
+        settings_cache.insert(setting, settings.value(setting));
+    }
+
+    settings_cache_loaded = true;
+}
+
+// Writes all changes accumulated since last write. Runs
+// in the background.
+void settings_write_pending() {
+    const QHash<QString, QVariant> pending_write_map = [&]() {
+        QMutexLocker locker(&settings_write_mutex);
+
+        const QHash<QString, QVariant> out = settings_pending_write_map;
+        settings_pending_write_map.clear();
+        settings_write_scheduled = false;
+
+        return out;
+    }();
+
     QSettings settings;
 
-    settings.setValue(setting, value);
+    for (auto it = pending_write_map.begin(); it != pending_write_map.end(); it++) {
+        settings.setValue(it.key(), it.value());
+    }
+
+    settings.sync();
+}
+
+// Calls subscribers of setting in their context's
+// thread. Subscriptions of destroyed contexts are removed.
+void settings_notify(const QString &setting, const QVariant &value) {
+    QList<SettingsSubscription> subscription_list;
+
+    {
+        QMutexLocker locker(&settings_subscription_mutex);
+
+        auto it = settings_subscription_map.find(setting);
+        while (it != settings_subscription_map.end() && it.key() == setting) {
+            if (it.value().context.isNull()) {
+                it = settings_subscription_map.erase(it);
+            } else {
+                subscription_list.append(it.value());
+                it++;
+            }
+        }
+    }
+
+    for (const SettingsSubscription &subscription : subscription_list) {
+        QObject *context = subscription.context.data();
+        if (context == nullptr) {
+            continue;
+        }
+
+        const std::function<void(const QVariant &)> callback = subscription.callback;
+
+        QMetaObject::invokeMethod(
+            context,
+            [callback, value]() {
+                callback(value);
+            },
+            Qt::AutoConnection);
+    }
+}
+
+QThreadPool *settings_write_pool() {
+    static QThreadPool *pool = []() {
+        auto out = new QThreadPool();
+        out->setMaxThreadCount(1);
+
+        return out;
+    }();
+
+    return pool;
 }
 
 void settings_save_main_window_geometry(const QByteArray &geometry) {
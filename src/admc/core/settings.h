@@ -24,11 +24,15 @@
 
 /**
  * Utility f-ns for saving and loading settings using
- * QSettings.
+ * QSettings. Settings are loaded into memory on first
+ * access and changes are written back to disk in the
+ * background. All f-ns are thread-safe.
  */
 
 #include <QVariant>
 
+#include <functional>
+
 class QAction;
 class QVariant;
 class QWidget;
@@ -100,6 +104,7 @@ DEFINE_SETTING(SETTING_create_shared_folder_dialog_geometry);
 DEFINE_SETTING(SETTING_create_contact_dialog_geometry);
 DEFINE_SETTING(SETTING_find_policy_dialog_geometry);
 DEFINE_SETTING(SETTING_time_span_attribute_dialog_geometry);
+DEFINE_SETTING(SETTING_gpo_perms_audit_dialog_geometry);
 
 // Header state
 DEFINE_SETTING(SETTING_results_header);
@@ -158,9 +163,20 @@ DEFINE_SETTING(SETTING_remembered_principals)
 DEFINE_SETTING(SETTING_feature_profile_tab);
 DEFINE_SETTING(SETTING_feature_dev_mode);
 DEFINE_SETTING(SETTING_feature_current_locale_first);
+DEFINE_SETTING(SETTING_feature_live_updates);
 
 QVariant settings_get_variant(const QString setting);
 void settings_set_variant(const QString setting, const QVariant &value);
+
+// Calls callback with new value every time setting value
+// changes. Callback is called in the thread of "context".
+// Subscription ends when context is destroyed.
+void settings_connect(const QString &setting, QObject *context, const std::function<void(const QVariant &)> &callback);
+
+// Waits until all changes are written to disk. Call this
+// before app exits.
+void settings_flush();
+
 void settings_save_main_window_geometry(const QByteArray &geometry);
 void settings_save_main_window_state(const QByteArray &state);
 QByteArray settings_load_main_window_state();
@@ -0,0 +1,70 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "write_thread.h"
+
+#include "adldap.h"
+
+WriteThread::WriteThread(const QList<AdWriteOperation> &operation_list_arg)
+: stop_flag(false),
+  operation_list(operation_list_arg),
+  result_list(operation_list_arg.size(), false),
+  m_failed_to_connect(false) {
+}
+
+void WriteThread::stop() {
+    stop_flag = true;
+}
+
+void WriteThread::run() {
+    AdInterface ad;
+    if (!ad.is_connected()) {
+        m_failed_to_connect = true;
+        ad_messages = ad.messages();
+
+        return;
+    }
+
+    AdWriteQueue queue(ad);
+    queue.set_cancel_token(&stop_flag);
+    queue.set_progress_callback(
+        [this](const int done_count, const int total_count) {
+            emit progress(done_count, total_count);
+        });
+
+    result_list = queue.run(operation_list);
+
+    ad_messages = ad.messages();
+}
+
+bool WriteThread::failed_to_connect() const {
+    return m_failed_to_connect;
+}
+
+bool WriteThread::was_stopped() const {
+    return stop_flag;
+}
+
+QList<bool> WriteThread::get_result_list() const {
+    return result_list;
+}
+
+QList<AdMessage> WriteThread::get_ad_messages() const {
+    return ad_messages;
+}
@@ -0,0 +1,66 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WRITE_THREAD_H
+#define WRITE_THREAD_H
+
+/**
+ * A thread that performs bulk write operations using
+ * AdWriteQueue, so that GUI is not blocked while they are
+ * performed. progress() is emitted after every finished
+ * operation. Use stop() to cancel remaining operations.
+ * Results and messages are available after thread
+ * finishes. Note that creator of thread should call
+ * thread's deleteLater() in the finished() slot.
+ */
+
+#include <QList>
+#include <QThread>
+#include <atomic>
+
+#include "ad_write_queue.h"
+
+class AdMessage;
+
+class WriteThread final : public QThread {
+    Q_OBJECT
+
+public:
+    WriteThread(const QList<AdWriteOperation> &operation_list);
+
+    void stop();
+    bool failed_to_connect() const;
+    bool was_stopped() const;
+    QList<bool> get_result_list() const;
+    QList<AdMessage> get_ad_messages() const;
+
+signals:
+    void progress(const int done_count, const int total_count);
+
+private:
+    std::atomic<bool> stop_flag;
+    QList<AdWriteOperation> operation_list;
+    QList<bool> result_list;
+    bool m_failed_to_connect;
+    QList<AdMessage> ad_messages;
+
+    void run() override;
+};
+
+#endif /* WRITE_THREAD_H */
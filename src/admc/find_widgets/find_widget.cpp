@@ -34,9 +34,18 @@
 
 #include <QMenu>
 #include <QStandardItem>
+#include <algorithm>
+
+// NOTE: results of last search can become outdated because
+// of changes made outside of this app, so they are reused
+// only for a short time
+#define LAST_RESULTS_MAX_AGE_MILLIS (60 * 1000)
 
 FindWidget::FindWidget(QWidget *parent)
-: QWidget(parent) {
+: QWidget(parent),
+  last_results_complete(false),
+  last_results_generation(0),
+  find_stopped(false) {
     ui = new Ui::FindWidget();
     ui->setupUi(this);
 
@@ -90,6 +99,12 @@ FindWidget::FindWidget(QWidget *parent)
     connect(
         ui->clear_button, &QPushButton::clicked,
         this, &FindWidget::on_clear_button);
+    connect(
+        ui->stop_button, &QPushButton::clicked,
+        this,
+        [this]() {
+            find_stopped = true;
+        });
 
     // NOTE: need this for the case where dialog is closed
     // while a search is in progress. Without this busy
@@ -156,11 +171,33 @@ void FindWidget::find() {
     const QString base = ui->select_base_widget->get_base();
     const QList<QString> search_attributes = ConsoleObjectTreeOperations::console_object_search_attributes();
 
+    if (can_narrow_locally(base, filter, search_attributes)) {
+        narrow_results(filter);
+
+        return;
+    }
+
+    last_base = base;
+    last_filter = filter;
+    last_results.clear();
+    last_results_complete = false;
+    find_stopped = false;
+    current_filter = filter;
+
+    // NOTE: remember cache generation before search
+    // starts, so that writes done while search is in
+    // progress also invalidate results
+    last_results_generation = AdObjectCache::instance()->generation();
+    last_results_timer.start();
+
     auto find_thread = new SearchThread(base, SearchScope_All, filter, search_attributes);
 
     connect(
         find_thread, &SearchThread::results_ready,
         this, &FindWidget::handle_find_thread_results);
+    connect(
+        find_thread, &SearchThread::progress,
+        this, &search_thread_display_progress);
     connect(
         this, &QObject::destroyed,
         find_thread, &SearchThread::stop);
@@ -171,9 +208,23 @@ void FindWidget::find() {
         find_thread, &SearchThread::finished,
         this,
         [this, find_thread]() {
-            g_status->display_ad_messages(find_thread->get_ad_messages(), this);
+            search_thread_clear_progress();
+
+            const QList<AdMessage> ad_messages = find_thread->get_ad_messages();
+
+            g_status->display_ad_messages(ad_messages, this);
             search_thread_display_errors(find_thread, this);
 
+            // NOTE: only results of a search that loaded
+            // all objects can be narrowed locally
+            const bool any_errors = std::any_of(ad_messages.begin(), ad_messages.end(), [](const AdMessage &message) {
+                return (message.type() == AdMessageType_Error);
+            });
+            last_results_complete = (!find_stopped && !any_errors && !find_thread->failed_to_connect() && !find_thread->hit_object_display_limit());
+            if (!last_results_complete) {
+                last_results.clear();
+            }
+
             ui->find_button->setEnabled(true);
             ui->clear_button->setEnabled(true);
 
@@ -196,15 +247,63 @@ void FindWidget::find() {
 }
 
 void FindWidget::handle_find_thread_results(const QHash<QString, AdObject> &results) {
+    last_results.insert(results);
+
+    add_results_to_console(results.values());
+}
+
+void FindWidget::add_results_to_console(const QList<AdObject> &object_list) {
     const QModelIndex head_index = head_item->index();
 
-    for (const AdObject &object : results) {
+    for (const AdObject &object : object_list) {
         const QList<QStandardItem *> row = ui->console->add_results_item(ItemType_Object, head_index);
 
         ConsoleObjectTreeOperations::console_object_load(row, object);
     }
 }
 
+// NOTE: repeating current search always goes to the
+// server, so that user can refresh results
+bool FindWidget::can_narrow_locally(const QString &base, const QString &filter, const QList<QString> &attributes) const {
+    if (!last_results_complete || base != last_base || filter == current_filter) {
+        return false;
+    }
+
+    // NOTE: any write done through AdInterface, including
+    // actions on objects in find results, changes cache
+    // generation. Objects in last results may be outdated
+    // after that, so they shouldn't be reused.
+    const bool objects_changed = (AdObjectCache::instance()->generation() != last_results_generation);
+    const bool results_expired = last_results_timer.hasExpired(LAST_RESULTS_MAX_AGE_MILLIS);
+    if (objects_changed || results_expired) {
+        return false;
+    }
+
+    const AdFilterMatcher matcher(filter, g_adconfig);
+    const AdFilterMatcher last_matcher(last_filter, g_adconfig);
+
+    return (matcher.is_narrowing_of(last_matcher) && matcher.can_match_locally(attributes));
+}
+
+// Displays objects from results of last search that match
+// given filter. Results of last search are kept, so that
+// filter can be changed again.
+void FindWidget::narrow_results(const QString &filter) {
+    const AdFilterMatcher matcher(filter, g_adconfig);
+
+    QList<AdObject> narrowed_list;
+    for (const AdObject &object : last_results) {
+        if (matcher.matches(object)) {
+            narrowed_list.append(object);
+        }
+    }
+
+    clear_results();
+    add_results_to_console(narrowed_list);
+
+    current_filter = filter;
+}
+
 QList<QString> FindWidget::get_selected_dns() const {
     const QList<QModelIndex> indexes = ui->console->get_selected_items(ItemType_Object);
     const QList<QString> out = index_list_to_dn_list(indexes, ObjectRole_DN);
@@ -215,6 +314,10 @@ QList<QString> FindWidget::get_selected_dns() const {
 void FindWidget::on_clear_button() {
     ui->filter_widget->clear();
     clear_results();
+
+    last_results.clear();
+    last_results_complete = false;
+    current_filter.clear();
 }
 
 void FindWidget::retranslate_ui() {
@@ -25,10 +25,21 @@
  * Provides a way for user to find objects. FilterWidget is
  * used for filter input and FindResults for displaying
  * objects. Used by FindObjectDialog and SelectObjectDialog.
+ *
+ * Results of last complete search are kept. If user then
+ * searches again with a narrower filter, like the previous
+ * filter with an added condition, results are filtered
+ * locally without asking the server. Kept results are not
+ * reused if any object was modified since they were
+ * loaded or if they are too old.
  */
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QWidget>
 
+#include "ad_object.h"
+
 class QStandardItem;
 class AdObject;
 class QMenu;
@@ -80,8 +91,20 @@ private:
     QAction *action_customize_columns;
     QAction *action_toggle_description_bar;
 
+    QString last_base;
+    QString last_filter;
+    QHash<QString, AdObject> last_results;
+    bool last_results_complete;
+    int last_results_generation;
+    QElapsedTimer last_results_timer;
+    bool find_stopped;
+    QString current_filter;
+
     void on_clear_button();
     void clear_results();
+    void add_results_to_console(const QList<AdObject> &object_list);
+    bool can_narrow_locally(const QString &base, const QString &filter, const QList<QString> &attributes) const;
+    void narrow_results(const QString &filter);
 
     void retranslate_ui();
     bool event(QEvent *event) override;
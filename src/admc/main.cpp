@@ -31,6 +31,7 @@
 #include "ui/dialog/connection_options.h"
 #include "core/config.h"
 #include "core/globals.h"
+#include "core/gpo_perms_audit_thread.h"
 #include "core/settings.h"
 #include "locale.h"
 #include "main_window.h"
@@ -50,6 +51,7 @@ int main(int argc, char **argv) {
     // passing this type from thread results in a runtime
     // error.
     qRegisterMetaType<QHash<QString, AdObject>>("QHash<QString, AdObject>");
+    qRegisterMetaType<GpoPermsAuditResult>("GpoPermsAuditResult");
 
     QApplication app(argc, argv);
     app.setApplicationDisplayName(ADMC_APPLICATION_DISPLAY_NAME);
@@ -117,5 +119,7 @@ int main(int argc, char **argv) {
 
     delete main_window;
 
+    settings_flush();
+
     return retval;
 }
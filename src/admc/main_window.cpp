@@ -44,6 +44,7 @@
 #include "core/config.h"
 #include "core/fsmo.h"
 #include "core/globals.h"
+#include "core/gpo_perms_audit_thread.h"
 #include "core/managers/country_manager.h"
 #include "core/managers/gplink_manager.h"
 #include "core/managers/icon_manager.h"
@@ -111,11 +112,6 @@ void MainWindow::resizeEvent(QResizeEvent *event) {
     QMainWindow::resizeEvent(event);
 }
 
-void MainWindow::on_log_searches_changed() {
-    const bool enabled = ui->action_log_searches->isChecked();
-    AdInterface::set_log_searches(enabled);
-}
-
 void MainWindow::on_show_login_changed() {
     const bool enabled = ui->action_show_login->isChecked();
     login_label->setVisible(enabled);
@@ -337,11 +333,14 @@ void MainWindow::setup_simple_settings() {
             });
     }
 
+    settings_connect(
+        SETTING_log_searches, this,
+        [](const QVariant &value) {
+            AdInterface::set_log_searches(value.toBool());
+        });
+    AdInterface::set_log_searches(settings_get_bool(SETTING_log_searches));
+
     // NOTE: Call these slots now to load initial state
-    connect(
-        ui->action_log_searches, &QAction::triggered,
-        this, &MainWindow::on_log_searches_changed);
-    on_log_searches_changed();
     connect(
         ui->action_show_login, &QAction::triggered,
         this, &MainWindow::on_show_login_changed);
@@ -557,6 +556,8 @@ void MainWindow::init_on_connect(AdInterface &ad) {
 
     setup_complex_settings(object_impl);
 
+    object_impl->set_live_updates_enabled(settings_get_bool(SETTING_feature_live_updates));
+
     connect(
         ui->action_filter_objects, &QAction::triggered,
                 object_impl, &ObjectImpl::open_console_filter_dialog);
@@ -652,6 +653,12 @@ void MainWindow::on_change_user() {
 }
 
 void MainWindow::on_logout() {
+    if (object_impl) {
+        object_impl->set_live_updates_enabled(false);
+    }
+
+    GpoPermsAuditThread::clear_cache();
+
     ui->console->clear_scope_tree();
     ui->console->hide_scope_and_results(true);
 
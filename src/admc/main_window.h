@@ -78,7 +78,6 @@ private:
     bool is_language_changed = false;
 
     void retranslate_themes_menu();
-    void on_log_searches_changed();
     void on_show_login_changed();
     void open_manual();
     void open_connection_options();
@@ -160,14 +160,16 @@ void CommonPermissionsWidget::update_object_typed_permission(const QModelIndex &
     const SecurityRight superior_right = main_index.data(RightsItemRole_SecurityRight).value<SecurityRight>();
     const QList<SecurityRight> subordinate_right_list = ad_security_get_subordinate_right_list(g_adconfig, superior_right, {appliable_class});
 
+    update_sd_index();
+    const QList<SecurityRightState> subordinate_state_list = sd_index.get_right_state_list(trustee, subordinate_right_list);
+
     bool all_allow_subordinates_set = true;
     bool all_deny_subordinates_set = true;
-    for (const SecurityRight &right : subordinate_right_list) {
+    for (const SecurityRightState &state : subordinate_state_list) {
         if (!all_allow_subordinates_set && !all_deny_subordinates_set) {
             return;
         }
 
-        const SecurityRightState state = security_descriptor_get_right_state(sd, trustee, right);
         for (int type_i = 0; type_i < SecurityRightStateType_COUNT; type_i++) {
             const SecurityRightStateType type = (SecurityRightStateType) type_i;
 
@@ -192,7 +194,8 @@ void CommonPermissionsWidget::update_object_typed_permission(const QModelIndex &
 
     security_descriptor_add_right(sd, g_adconfig, {appliable_class}, trustee, superior_right, all_allow_subordinates_set);
 
-    const SecurityRightState state = security_descriptor_get_right_state(sd, trustee, superior_right);
+    update_sd_index();
+    const SecurityRightState state = sd_index.get_right_state(trustee, superior_right);
     const SecurityRightStateType type = all_allow_subordinates_set ? SecurityRightStateType_Allow : SecurityRightStateType_Deny;
     const bool object_ace_state = state.get(SecurityRightStateInherited_No, type);
     if (object_ace_state) {
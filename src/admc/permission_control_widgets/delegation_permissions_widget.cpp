@@ -149,9 +149,9 @@ void DelegationPermissionsWidget::update_task_check_state(QStandardItem *item) {
 
     int inherited_rights_count = 0;
 
-    for (const SecurityRight &right : rights) {
-        const SecurityRightState state = security_descriptor_get_right_state(sd, trustee, right);
+    const QList<SecurityRightState> state_list = sd_index.get_right_state_list(trustee, rights);
 
+    for (const SecurityRightState &state : state_list) {
         if (right_state_checked_list.contains(Qt::Unchecked)) {
             continue;
         }
@@ -199,6 +199,8 @@ void DelegationPermissionsWidget::update_permissions() {
     // changing state of items
     ignore_item_changed_signal = true;
 
+    update_sd_index();
+
     for (int row = 0; row < rights_model->rowCount(); row++) {
         const QModelIndex index = rights_model->index(row, 0);
         if (!index.isValid() || item_is_message(index)) {
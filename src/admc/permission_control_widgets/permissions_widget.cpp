@@ -64,6 +64,7 @@ PermissionsWidget::PermissionsWidget(QWidget *parent) :
 
 void PermissionsWidget::init(const QStringList &target_classes, security_descriptor *sd_arg) {
     sd = sd_arg;
+    sd_index.load(sd);
     target_class_list = target_classes;
     rights_model->removeRows(0, rights_model->rowCount());
 }
@@ -185,6 +186,10 @@ void PermissionsWidget::update_permissions() {
     // changing state of items
     ignore_item_changed_signal = true;
 
+    update_sd_index();
+
+    QList<int> row_list;
+    QList<SecurityRight> right_list;
     for (int row = 0; row < rights_model->rowCount(); row++) {
         const QModelIndex index = rights_model->index(row, 0);
         if (!index.isValid() || item_is_message(index)) {
@@ -193,8 +198,14 @@ void PermissionsWidget::update_permissions() {
 
         QStandardItem *main_item = rights_model->itemFromIndex(index);
 
-        SecurityRight right = main_item->data(RightsItemRole_SecurityRight).value<SecurityRight>();
-        update_row_check_state(row, right);
+        const SecurityRight right = main_item->data(RightsItemRole_SecurityRight).value<SecurityRight>();
+        row_list.append(row);
+        right_list.append(right);
+    }
+
+    const QList<SecurityRightState> state_list = sd_index.get_right_state_list(trustee, right_list);
+    for (int i = 0; i < row_list.size(); i++) {
+        update_row_check_state(row_list[i], state_list[i]);
     }
 
     // NOTE: need to make read only again because
@@ -290,13 +301,12 @@ QList<QStandardItem *> PermissionsWidget::create_item_row(const SecurityRight &r
     return row;
 }
 
-void PermissionsWidget::update_row_check_state(int row, const SecurityRight &right) {
+void PermissionsWidget::update_row_check_state(int row, const SecurityRightState &state) {
     const QHash<SecurityRightStateType, QModelIndex> checkable_index_map = {
         {SecurityRightStateType_Allow, rights_model->index(row, PermissionColumn_Allowed)},
         {SecurityRightStateType_Deny, rights_model->index(row, PermissionColumn_Denied)},
     };
 
-    const SecurityRightState state = security_descriptor_get_right_state(sd, trustee, right);
     for (int type_i = 0; type_i < SecurityRightStateType_COUNT; type_i++) {
         const SecurityRightStateType type = (SecurityRightStateType) type_i;
 
@@ -327,3 +337,7 @@ bool RightsSortModel::filterAcceptsRow(int source_row, const QModelIndex &source
     const QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
     return !index.data(RightsItemRole_HiddenItem).toBool();
 }
+
+void PermissionsWidget::update_sd_index() {
+    sd_index.update_trustee(sd, trustee);
+}
@@ -22,6 +22,8 @@
 #ifndef PERMISSIONS_WIDGET_H
 #define PERMISSIONS_WIDGET_H
 
+#include "ad_security.h"
+
 #include <QWidget>
 #include <QLocale>
 #include <QSortFilterProxyModel>
@@ -94,6 +96,7 @@ protected:
 
     bool ignore_item_changed_signal;
     security_descriptor *sd;
+    SecurityDescriptorIndex sd_index;
     bool read_only;
     QStandardItemModel *rights_model;
     QTreeView *rights_view;
@@ -114,8 +117,12 @@ protected:
     void append_message_item();
     virtual QList<QStandardItem*> create_item_row(const SecurityRight &right);
 
+    // Updates index for current trustee. Call this before
+    // checking right states if sd could've changed.
+    void update_sd_index();
+
 private:
-    void update_row_check_state(int row, const SecurityRight &right);
+    void update_row_check_state(int row, const SecurityRightState &state);
     virtual bool right_applies_to_class(const SecurityRight &right, const QString &obj_class) = 0;
     virtual bool there_are_rights_for_class(const QString &obj_class) = 0;
 };
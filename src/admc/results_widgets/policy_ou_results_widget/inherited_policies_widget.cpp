@@ -80,12 +80,26 @@ void InheritedPoliciesWidget::update(const QString &ou_dn_arg) {
     ou_dn = ou_dn_arg;
     AdInterface ad;
     if (!ad.is_connected()) {
+        hide_busy_indicator();
         return;
     }
 
     model->removeRows(0, model->rowCount());
-    add_enabled_policy_items(ad, ou_dn_arg);
-    remove_link_duplicates();
+
+    // NOTE: precedence is computed from gplink manager's
+    // index, so no need to load every OU up the chain
+    const QList<EffectivePolicy> policy_list = g_gplink_manager->effective_policy_list(ou_dn_arg);
+    for (const EffectivePolicy &policy : policy_list) {
+        const QList<QStandardItem *> row = make_item_row(InheritedPoliciesColumns_COUNT);
+        const bool loaded = load_item(row, ad, policy);
+
+        if (loaded) {
+            model->appendRow(row);
+        } else {
+            qDeleteAll(row);
+        }
+    }
+
     set_priority_to_items();
     model->sort(InheritedPoliciesColumns_Prority);
     hide_busy_indicator();
@@ -102,58 +116,6 @@ void InheritedPoliciesWidget::hide_not_enforced_inherited_links(bool hide) {
     }
 }
 
-void InheritedPoliciesWidget::add_enabled_policy_items(AdInterface &ad, const QString ou_dn, bool inheritance_blocked) {
-    const AdObject ou_obj = ad.search_object(ou_dn, {ATTRIBUTE_NAME,
-                                                     ATTRIBUTE_GPOPTIONS,
-                                                     ATTRIBUTE_GPLINK});
-    if (ou_obj.is_empty()) {
-        return;
-    }
-
-    const Gplink gplink = Gplink(ou_obj.get_string(ATTRIBUTE_GPLINK));
-    const QStringList enforced_links = gplink.enforced_gpo_dn_list();
-    const QStringList disabled_links = gplink.disabled_gpo_dn_list();
-    int enforced_policy_row = 0;
-    for (QString gpo_dn : gplink.get_gpo_list()) {
-        if (disabled_links.contains(gpo_dn)) {
-            continue;
-        }
-
-        bool policy_is_enforced = enforced_links.contains(gpo_dn);
-        QList<QStandardItem *> row;
-
-        if (policy_is_enforced) {
-            row = make_item_row(InheritedPoliciesColumns_COUNT);
-            load_item(row, ad, ou_obj.get_string(ATTRIBUTE_NAME), gpo_dn, policy_is_enforced);
-            model->insertRow(enforced_policy_row, row);
-            ++enforced_policy_row;
-        }
-        else if (!inheritance_blocked) {
-            row = make_item_row(InheritedPoliciesColumns_COUNT);
-            load_item(row, ad, ou_obj.get_string(ATTRIBUTE_NAME), gpo_dn, policy_is_enforced);
-            model->appendRow(row);
-        }
-    }
-
-
-    bool inheritance_is_blocked = ou_obj.get_string(ATTRIBUTE_GPOPTIONS) == GPOPTIONS_BLOCK_INHERITANCE || inheritance_blocked;
-    add_enabled_policy_items(ad, dn_get_parent(ou_dn), inheritance_is_blocked);
-}
-
-void InheritedPoliciesWidget::remove_link_duplicates() {
-    QStringList dn_list;
-    for (int row = 0; row < model->rowCount(); ++row) {
-        // The same dn is set to each item in the row
-        const QString dn = model->index(row, 0).data(RowRole_DN).toString();
-        if (dn_list.contains(dn)) {
-            model->removeRow(row);
-            --row;
-            continue;
-        }
-        dn_list << dn;
-    }
-}
-
 void InheritedPoliciesWidget::set_priority_to_items() {
     for(int row = 0; row < model->rowCount(); ++row) {
         model->item(row, InheritedPoliciesColumns_Prority)->
@@ -161,20 +123,31 @@ void InheritedPoliciesWidget::set_priority_to_items() {
     }
 }
 
-void InheritedPoliciesWidget::load_item(const QList<QStandardItem *> row, AdInterface &ad, const QString &ou_name, const QString &policy_dn, bool is_enforced) {
-    AdObject gpo = ad.search_object(policy_dn, {ATTRIBUTE_DISPLAY_NAME});
-    if (gpo.is_empty()) {
-        return;
+bool InheritedPoliciesWidget::load_item(const QList<QStandardItem *> row, AdInterface &ad, const EffectivePolicy &policy) {
+    QString name = g_gplink_manager->gpo_name(policy.gpo_dn);
+
+    // NOTE: policy may have been created after gplink
+    // manager was updated, in which case load it's name
+    // from server
+    if (name.isEmpty()) {
+        const AdObject gpo = ad.search_object(policy.gpo_dn, {ATTRIBUTE_DISPLAY_NAME});
+        if (gpo.is_empty()) {
+            return false;
+        }
+
+        name = gpo.get_string(ATTRIBUTE_DISPLAY_NAME);
+        g_gplink_manager->set_gpo_name(policy.gpo_dn, name);
     }
 
-    set_data_for_row(row, policy_dn, RowRole_DN);
-    set_data_for_row(row, is_enforced, RowRole_IsEnforced);
+    set_data_for_row(row, policy.gpo_dn, RowRole_DN);
+    set_data_for_row(row, policy.is_enforced, RowRole_IsEnforced);
 
-    const QString name = gpo.get_string(ATTRIBUTE_DISPLAY_NAME);
     row[InheritedPoliciesColumns_Name]->setText(name);
-    row[InheritedPoliciesColumns_Location]->setText(ou_name);
-    if (is_enforced)
+    row[InheritedPoliciesColumns_Location]->setText(g_gplink_manager->ou_name(policy.ou_dn));
+    if (policy.is_enforced)
         row[0]->setIcon(g_icon_manager->item_icon(ItemIcon_Policy_Enforced));
     else
         row[0]->setIcon(g_icon_manager->item_icon(ItemIcon_Policy_Link));
+
+    return true;
 }
@@ -34,6 +34,7 @@ class QStandardItemModel;
 class ConsoleWidget;
 class QStandardItem;
 class AdInterface;
+struct EffectivePolicy;
 
 class InheritedPoliciesWidget final : public QWidget
 {
@@ -68,10 +69,8 @@ private:
     QModelIndex selected_scope_index;
     QString ou_dn;
 
-    void add_enabled_policy_items(AdInterface &ad, const QString ou_dn, bool inheritance_blocked = false);
-    void remove_link_duplicates();
     void set_priority_to_items();
-    void load_item(const QList<QStandardItem *> row, AdInterface &ad, const QString &ou_name, const QString &policy_dn, bool is_enforced);
+    bool load_item(const QList<QStandardItem *> row, AdInterface &ad, const EffectivePolicy &policy);
 };
 
 #endif // INHERITED_POLICIES_WIDGET_H
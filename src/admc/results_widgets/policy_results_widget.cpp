@@ -154,7 +154,7 @@ void PolicyResultsWidget::update(const QString &new_gpo) {
         row[PolicyResultsColumn_Path]->setText(dn_get_parent_canonical(ou_dn));
 
         const QString gplink_string = g_gplink_manager->ou_gplink(ou_dn);
-        const Gplink gplink = Gplink(gplink_string);
+        const Gplink gplink = g_gplink_manager->ou_gplink_parsed(ou_dn);
 
         const bool is_enforced = gplink.get_option(gpo, GplinkOption_Enforced);
         Qt::CheckState checkstate = is_enforced ? Qt::Checked : Qt::Unchecked;
@@ -211,23 +211,35 @@ bool MembershipTabEdit::apply(AdInterface &ad, const QString &target) const {
         case MembershipTabType_Members: {
             const QString group = target;
 
+            QList<QString> removed_list;
             for (auto user : original_values) {
                 const bool removed = !current_values.contains(user);
                 if (removed) {
-                    const bool success = ad.group_remove_member(group, user);
-                    if (!success) {
-                        total_success = false;
-                    }
+                    removed_list.append(user);
                 }
             }
 
+            QList<QString> added_list;
             for (auto user : current_values) {
                 const bool added = !original_values.contains(user);
                 if (added) {
-                    const bool success = ad.group_add_member(group, user);
-                    if (!success) {
-                        total_success = false;
-                    }
+                    added_list.append(user);
+                }
+            }
+
+            // NOTE: all members are modified in batches,
+            // instead of one request per member
+            if (!removed_list.isEmpty()) {
+                const bool success = ad.group_remove_members(group, removed_list);
+                if (!success) {
+                    total_success = false;
+                }
+            }
+
+            if (!added_list.isEmpty()) {
+                const bool success = ad.group_add_members(group, added_list);
+                if (!success) {
+                    total_success = false;
                 }
             }
 
@@ -31,11 +31,14 @@
 #include "core/utils.h"
 #include "permission_control_widgets/sddl_view_dialog.h"
 
+#include <QApplication>
 #include <QDebug>
 #include <QLabel>
 #include <QPersistentModelIndex>
+#include <QPointer>
 #include <QSortFilterProxyModel>
 #include <QStandardItemModel>
+#include <QThreadPool>
 #include <QTreeView>
 #include <algorithm>
 #include <QMenu>
@@ -140,6 +143,8 @@ SecurityTab::SecurityTab(QList<AttributeEdit *> *edit_list, QWidget *parent)
 }
 
 void SecurityTab::load(AdInterface &ad, const AdObject &object) {
+    Q_UNUSED(ad);
+
     // TODO: Remove security tab self reload after changes applying (because its excessive).
     // Probably this should be done for other tabs too.
 
@@ -154,7 +159,7 @@ void SecurityTab::load(AdInterface &ad, const AdObject &object) {
         widget->init(target_class_list, sd);
     }
 
-    load_sd(ad, sd);
+    load_sd(sd);
 
     if (ui->applied_objects_cmbBox->count() == 0) {
         load_applied_objects_cmbbox(target_class_list);
@@ -208,7 +213,7 @@ SecurityTab::~SecurityTab() {
 // here but it is called implicitly because
 // setCurrentIndex() emits currentChanged() signal
 // which calls set_current_trustee() on permission widgets
-void SecurityTab::load_sd(AdInterface &ad, security_descriptor *sd_arg) {
+void SecurityTab::load_sd(security_descriptor *sd_arg) {
     // Save previous selected trustee before reloading
     // trustee model. This is for the case where we
     // need to restore selection later.
@@ -224,7 +229,7 @@ void SecurityTab::load_sd(AdInterface &ad, security_descriptor *sd_arg) {
     // Load trustee model
     trustee_model->removeRows(0, trustee_model->rowCount());
     const QList<QByteArray> trustee_list = security_descriptor_get_trustee_list(sd_arg);
-    add_trustees(trustee_list, ad);
+    add_trustees(trustee_list);
 
     // Select a trustee
     //
@@ -339,18 +344,12 @@ void SecurityTab::on_restore_previous_sd() {
 
     show_busy_indicator();
 
-    AdInterface ad;
-    if (!ad.is_connected()) {
-        hide_busy_indicator();
-        return;
-    }
-
     security_descriptor_free(sd);
     sd = security_descriptor_copy(previous_sd);
 
     // Block signals to avoid possible chaos
     ui->trustee_view->selectionModel()->blockSignals(true);
-    load_sd(ad, sd);
+    load_sd(sd);
 
     for (PermissionsWidget *permission_widget : permissions_widgets) {
         permission_widget->blockSignals(true);
@@ -440,16 +439,11 @@ void SecurityTab::on_add_trustee_button() {
                 sid_list.append(sid);
             }
 
-            add_trustees(sid_list, ad);
+            add_trustees(sid_list);
         });
 }
 
 void SecurityTab::on_remove_trustee_button() {
-    AdInterface ad;
-    if (ad_failed(ad, ui->remove_trustee_button)) {
-        return;
-    }
-
     QList<QByteArray> removed_trustee_list;
     QItemSelectionModel *selection_model = ui->trustee_view->selectionModel();
     const QList<QPersistentModelIndex> selected_list =
@@ -468,7 +462,7 @@ void SecurityTab::on_remove_trustee_button() {
     // NOTE: we do this instead of removing selected
     // indexes because not all trustee's are guaranteed
     // to have been removed
-    load_sd(ad, sd);
+    load_sd(sd);
 
     const bool removed_any = !removed_trustee_list.isEmpty();
 
@@ -477,7 +471,7 @@ void SecurityTab::on_remove_trustee_button() {
     }
 }
 
-void SecurityTab::add_trustees(const QList<QByteArray> &sid_list, AdInterface &ad) {
+void SecurityTab::add_trustees(const QList<QByteArray> &sid_list) {
     QList<QString> current_sid_string_list;
     for (int row = 0; row < trustee_model->rowCount(); row++) {
         QStandardItem *item = trustee_model->item(row, 0);
@@ -489,6 +483,7 @@ void SecurityTab::add_trustees(const QList<QByteArray> &sid_list, AdInterface &a
 
     bool added_anything = false;
     bool failed_to_add_because_already_exists = false;
+    QList<QByteArray> unresolved_sid_list;
 
     for (const QByteArray &sid : sid_list) {
         const QString sid_string = object_sid_display_value(sid);
@@ -499,8 +494,20 @@ void SecurityTab::add_trustees(const QList<QByteArray> &sid_list, AdInterface &a
             continue;
         }
 
+        // NOTE: display sid until name is resolved
+        const QString name = [&]() {
+            const QString cached_name = ad_security_get_cached_trustee_name(sid);
+
+            if (!cached_name.isEmpty()) {
+                return cached_name;
+            } else {
+                unresolved_sid_list.append(sid);
+
+                return sid_string;
+            }
+        }();
+
         auto item = new QStandardItem();
-        const QString name = ad_security_get_trustee_name(ad, sid);
         item->setText(name);
         item->setData(sid, TrusteeItemRole_Sid);
         trustee_model->appendRow(item);
@@ -510,6 +517,8 @@ void SecurityTab::add_trustees(const QList<QByteArray> &sid_list, AdInterface &a
 
     ui->trustee_view->sortByColumn(0, Qt::AscendingOrder);
 
+    resolve_trustee_names(unresolved_sid_list);
+
     if (added_anything) {
         emit tab_edit->edited();
     }
@@ -519,6 +528,55 @@ void SecurityTab::add_trustees(const QList<QByteArray> &sid_list, AdInterface &a
     }
 }
 
+// Resolves trustee names in the background, so that tab
+// doesn't block while names are searched for. Names are
+// updated as each chunk of trustees is resolved.
+void SecurityTab::resolve_trustee_names(const QList<QByteArray> &sid_list) {
+    if (sid_list.isEmpty()) {
+        return;
+    }
+
+    const QPointer<SecurityTab> tab = this;
+
+    QThreadPool::globalInstance()->start([tab, sid_list]() {
+        AdInterface ad;
+        if (!ad.is_connected()) {
+            return;
+        }
+
+        for (int i = 0; i < sid_list.size(); i += AD_SECURITY_TRUSTEE_SEARCH_CHUNK_SIZE) {
+            const QList<QByteArray> chunk = sid_list.mid(i, AD_SECURITY_TRUSTEE_SEARCH_CHUNK_SIZE);
+            const QHash<QByteArray, QString> name_map = ad_security_get_trustee_name_map(ad, chunk);
+
+            // NOTE: tab may be destroyed while we were
+            // searching, so check it in the main thread
+            QMetaObject::invokeMethod(
+                qApp,
+                [tab, name_map]() {
+                    if (tab.isNull()) {
+                        return;
+                    }
+
+                    tab->on_trustee_names_resolved(name_map);
+                },
+                Qt::QueuedConnection);
+        }
+    });
+}
+
+void SecurityTab::on_trustee_names_resolved(const QHash<QByteArray, QString> &name_map) {
+    for (int row = 0; row < trustee_model->rowCount(); row++) {
+        QStandardItem *item = trustee_model->item(row, 0);
+        const QByteArray sid = item->data(TrusteeItemRole_Sid).toByteArray();
+
+        if (name_map.contains(sid)) {
+            item->setText(name_map[sid]);
+        }
+    }
+
+    ui->trustee_view->sortByColumn(0, Qt::AscendingOrder);
+}
+
 void SecurityTab::on_add_well_known_trustee() {
     auto dialog = new SelectWellKnownTrusteeDialog(ui->trustee_view);
     dialog->open();
@@ -527,14 +585,9 @@ void SecurityTab::on_add_well_known_trustee() {
         dialog, &QDialog::accepted,
         this,
         [this, dialog]() {
-            AdInterface ad;
-            if (ad_failed(ad, ui->trustee_view)) {
-                return;
-            }
-
             const QList<QByteArray> trustee_list = dialog->get_selected();
 
-            add_trustees(trustee_list, ad);
+            add_trustees(trustee_list);
         });
 }
 
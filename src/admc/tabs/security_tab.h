@@ -75,8 +75,10 @@ private:
     void on_remove_trustee_button();
     void on_add_trustee_button();
     void on_add_well_known_trustee();
-    void add_trustees(const QList<QByteArray> &sid_list, AdInterface &ad);
-    void load_sd(AdInterface &ad, security_descriptor *sd_arg);
+    void add_trustees(const QList<QByteArray> &sid_list);
+    void resolve_trustee_names(const QList<QByteArray> &sid_list);
+    void on_trustee_names_resolved(const QHash<QByteArray, QString> &name_map);
+    void load_sd(security_descriptor *sd_arg);
     QByteArray get_current_trustee() const;
     void load_applied_objects_cmbbox(const QStringList &target_class_list);
     void on_applied_objs_cmbbox();
@@ -186,6 +186,7 @@ void ConnectionOptionsDialog::accept() {
     const bool domain_is_changed = (domain_was_default != domain_is_default) || custom_domain_changed;
     if (domain_is_changed) {
         load_g_adconfig(ad);
+        ad_security_clear_trustee_name_cache();
     }
 
     emit host_changed(selected_host);
@@ -271,6 +272,10 @@ void ConnectionOptionsDialog::host_button_toggled(bool is_default_checked) {
 void ConnectionOptionsDialog::get_hosts() {
     ui->host_select_list->clear();
     QString domain = ui->domain_custom_edit->text();
+
+    // NOTE: user explicitly asked for hosts, so query DNS
+    // instead of using cached results
+    clear_domain_hosts_cache();
     QStringList hosts = get_domain_hosts(domain, QString());
     if (hosts.isEmpty()) {
         ui->host_warning_label->setVisible(true);
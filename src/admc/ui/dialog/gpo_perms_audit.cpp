@@ -0,0 +1,260 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ui/dialog/gpo_perms_audit.h"
+#include "ui/dialog/ui_gpo_perms_audit.h"
+
+#include "adldap.h"
+#include "core/gpo_perms_audit_thread.h"
+#include "core/settings.h"
+#include "ui/status.h"
+
+#include <QMessageBox>
+#include <QPushButton>
+#include <QStandardItemModel>
+
+enum AuditColumn {
+    AuditColumn_Name,
+    AuditColumn_Status,
+
+    AuditColumn_COUNT,
+};
+
+#define DN_ROLE (Qt::UserRole + 1)
+
+GpoPermsAuditDialog::GpoPermsAuditDialog(QWidget *parent)
+: QDialog(parent) {
+    ui = new Ui::GpoPermsAuditDialog();
+    ui->setupUi(this);
+
+    setAttribute(Qt::WA_DeleteOnClose);
+
+    audit_is_running = false;
+    checked_count = 0;
+    total_count = 0;
+
+    model = new QStandardItemModel(0, AuditColumn_COUNT, this);
+    ui->view->setModel(model);
+
+    retranslate_ui();
+
+    settings_setup_dialog_geometry(SETTING_gpo_perms_audit_dialog_geometry, this);
+
+    connect(
+        ui->sync_selected_button, &QPushButton::clicked,
+        this, &GpoPermsAuditDialog::on_sync_selected);
+    connect(
+        ui->sync_all_button, &QPushButton::clicked,
+        this, &GpoPermsAuditDialog::on_sync_all);
+    connect(
+        ui->recheck_button, &QPushButton::clicked,
+        this, &GpoPermsAuditDialog::on_recheck);
+    connect(
+        ui->view->selectionModel(), &QItemSelectionModel::selectionChanged,
+        this, &GpoPermsAuditDialog::update_buttons);
+
+    start_audit(QList<QString>());
+}
+
+GpoPermsAuditDialog::~GpoPermsAuditDialog() {
+    delete ui;
+}
+
+void GpoPermsAuditDialog::start_audit(const QList<QString> &sync_list) {
+    if (audit_is_running) {
+        return;
+    }
+
+    audit_is_running = true;
+    checked_count = 0;
+    total_count = 0;
+    update_status();
+    update_buttons();
+
+    auto thread = new GpoPermsAuditThread();
+    thread->set_sync_list(sync_list);
+
+    connect(
+        thread, &GpoPermsAuditThread::result_ready,
+        this, &GpoPermsAuditDialog::on_result,
+        Qt::QueuedConnection);
+    connect(
+        thread, &GpoPermsAuditThread::progress,
+        this,
+        [this](const int done_count, const int total_count_arg) {
+            checked_count = done_count;
+            total_count = total_count_arg;
+            update_status();
+        },
+        Qt::QueuedConnection);
+    connect(
+        this, &QObject::destroyed,
+        thread, &GpoPermsAuditThread::stop,
+        Qt::DirectConnection);
+    connect(
+        thread, &GpoPermsAuditThread::finished,
+        this,
+        [this, thread]() {
+            audit_is_running = false;
+            update_status();
+            update_buttons();
+
+            g_status->display_ad_messages(thread->get_ad_messages(), this);
+
+            if (thread->not_admin()) {
+                QMessageBox::warning(this, tr("Error"), tr("Only domain administrators can audit policy permissions."));
+            }
+        },
+        Qt::QueuedConnection);
+
+    // NOTE: delete thread even if dialog was closed
+    connect(
+        thread, &GpoPermsAuditThread::finished,
+        thread, &QObject::deleteLater);
+
+    thread->start();
+}
+
+void GpoPermsAuditDialog::on_result(const GpoPermsAuditResult &result) {
+    const int existing_row = find_row(result.dn);
+
+    const bool is_ok = (result.check_ok && result.perms_ok);
+    if (is_ok) {
+        // NOTE: policy may have been fixed since it was
+        // listed
+        if (existing_row != -1) {
+            model->removeRow(existing_row);
+        }
+
+        return;
+    }
+
+    const QString status = [&]() {
+        if (result.check_ok) {
+            return tr("GPT permissions don't match GPC");
+        } else {
+            return tr("Failed to check");
+        }
+    }();
+
+    const QString name = [&]() {
+        if (!result.name.isEmpty()) {
+            return result.name;
+        } else {
+            return result.dn;
+        }
+    }();
+
+    QList<QStandardItem *> row;
+    if (existing_row != -1) {
+        for (int column = 0; column < AuditColumn_COUNT; column++) {
+            row.append(model->item(existing_row, column));
+        }
+    } else {
+        for (int column = 0; column < AuditColumn_COUNT; column++) {
+            row.append(new QStandardItem());
+        }
+
+        model->appendRow(row);
+    }
+
+    row[AuditColumn_Name]->setText(name);
+    row[AuditColumn_Name]->setData(result.dn, DN_ROLE);
+    row[AuditColumn_Status]->setText(status);
+    row[AuditColumn_Status]->setToolTip(result.error);
+
+    update_status();
+    update_buttons();
+}
+
+void GpoPermsAuditDialog::on_sync_selected() {
+    QList<QString> dn_list;
+
+    const QList<QModelIndex> selected_list = ui->view->selectionModel()->selectedRows(AuditColumn_Name);
+    for (const QModelIndex &index : selected_list) {
+        dn_list.append(index.data(DN_ROLE).toString());
+    }
+
+    start_audit(dn_list);
+}
+
+void GpoPermsAuditDialog::on_sync_all() {
+    QList<QString> dn_list;
+
+    for (int row = 0; row < model->rowCount(); row++) {
+        dn_list.append(model->item(row, AuditColumn_Name)->data(DN_ROLE).toString());
+    }
+
+    start_audit(dn_list);
+}
+
+void GpoPermsAuditDialog::on_recheck() {
+    // NOTE: GPT may have been changed outside of ADMC,
+    // which doesn't change GPC's whenChanged, so don't use
+    // cached results
+    GpoPermsAuditThread::clear_cache();
+
+    model->removeRows(0, model->rowCount());
+
+    start_audit(QList<QString>());
+}
+
+void GpoPermsAuditDialog::update_status() {
+    const QString progress_text = QString(tr("Checked %1 of %2 policies, found %3 problem(s).")).arg(checked_count).arg(total_count).arg(model->rowCount());
+
+    if (audit_is_running) {
+        ui->status_label->setText(tr("Checking permissions...") + " " + progress_text);
+    } else {
+        ui->status_label->setText(progress_text);
+    }
+}
+
+void GpoPermsAuditDialog::update_buttons() {
+    const bool have_selection = ui->view->selectionModel()->hasSelection();
+    const bool have_rows = (model->rowCount() > 0);
+
+    ui->sync_selected_button->setEnabled(!audit_is_running && have_selection);
+    ui->sync_all_button->setEnabled(!audit_is_running && have_rows);
+    ui->recheck_button->setEnabled(!audit_is_running);
+}
+
+int GpoPermsAuditDialog::find_row(const QString &dn) const {
+    for (int row = 0; row < model->rowCount(); row++) {
+        const QString row_dn = model->item(row, AuditColumn_Name)->data(DN_ROLE).toString();
+
+        if (row_dn == dn) {
+            return row;
+        }
+    }
+
+    return -1;
+}
+
+void GpoPermsAuditDialog::retranslate_ui() {
+    model->setHorizontalHeaderLabels({tr("Name"), tr("Status")});
+    update_status();
+}
+
+bool GpoPermsAuditDialog::event(QEvent *event) {
+    if (event->type() == QEvent::LanguageChange) {
+        ui->retranslateUi(this);
+        retranslate_ui();
+    }
+    return QDialog::event(event);
+}
@@ -0,0 +1,68 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GPO_PERMS_AUDIT_DIALOG_H
+#define GPO_PERMS_AUDIT_DIALOG_H
+
+/**
+ * Dialog that audits permissions of all policies in the
+ * domain in the background. Lists policies whose GPT
+ * permissions don't match GPC permissions, or which
+ * couldn't be checked, as results come in. Offers to sync
+ * permissions of selected or all listed policies.
+ */
+
+#include <QDialog>
+
+class QStandardItemModel;
+struct GpoPermsAuditResult;
+
+namespace Ui {
+class GpoPermsAuditDialog;
+}
+
+class GpoPermsAuditDialog final : public QDialog {
+    Q_OBJECT
+
+public:
+    Ui::GpoPermsAuditDialog *ui;
+
+    GpoPermsAuditDialog(QWidget *parent);
+    ~GpoPermsAuditDialog();
+
+    void retranslate_ui();
+    bool event(QEvent *event) override;
+
+private:
+    QStandardItemModel *model;
+    bool audit_is_running;
+    int checked_count;
+    int total_count;
+
+    void start_audit(const QList<QString> &sync_list);
+    void on_result(const GpoPermsAuditResult &result);
+    void on_sync_selected();
+    void on_sync_all();
+    void on_recheck();
+    void update_status();
+    void update_buttons();
+    int find_row(const QString &dn) const;
+};
+
+#endif /* GPO_PERMS_AUDIT_DIALOG_H */
@@ -28,6 +28,7 @@
 #include "core/globals.h"
 #include "core/search_thread.h"
 #include "core/settings.h"
+#include "core/write_thread.h"
 #include "ui/status.h"
 
 #include <QAbstractItemView>
@@ -43,6 +44,7 @@
 #include <QModelIndex>
 #include <QPersistentModelIndex>
 #include <QPlainTextEdit>
+#include <QProgressDialog>
 #include <QScreen>
 #include <QSortFilterProxyModel>
 #include <QStandardItem>
@@ -395,3 +397,62 @@ void search_thread_display_errors(SearchThread *thread, QWidget *parent) {
             parent);
     }
 }
+
+void search_thread_display_progress(const int object_count, const int page_count, const qint64 elapsed_ms) {
+    const QString elapsed_string = QString::number(elapsed_ms / 1000.0, 'f', 1);
+    const QString message = QCoreApplication::translate("object_impl.cpp", "Searching... %1 objects received, %2 pages, %3 s").arg(QString::number(object_count), QString::number(page_count), elapsed_string);
+
+    g_status->show_message(message);
+}
+
+void search_thread_clear_progress() {
+    g_status->clear_message();
+}
+
+void write_thread_start(const QList<AdWriteOperation> &operation_list, const QString &label, QWidget *parent, const std::function<void(const QList<bool> &result_list)> &on_finished) {
+    auto thread = new WriteThread(operation_list);
+
+    auto progress_dialog = new QProgressDialog(label, QCoreApplication::translate("utils.cpp", "Cancel"), 0, operation_list.size(), parent);
+    progress_dialog->setWindowModality(Qt::WindowModal);
+    progress_dialog->setAttribute(Qt::WA_DeleteOnClose);
+    progress_dialog->setAutoClose(false);
+    progress_dialog->setAutoReset(false);
+    // NOTE: don't flash the dialog for quick operations
+    progress_dialog->setMinimumDuration(500);
+    progress_dialog->setValue(0);
+
+    QObject::connect(
+        thread, &WriteThread::progress,
+        progress_dialog, &QProgressDialog::setValue,
+        Qt::QueuedConnection);
+    QObject::connect(
+        progress_dialog, &QProgressDialog::canceled,
+        thread, &WriteThread::stop,
+        Qt::DirectConnection);
+    QObject::connect(
+        parent, &QObject::destroyed,
+        thread, &WriteThread::stop,
+        Qt::DirectConnection);
+    QObject::connect(
+        thread, &WriteThread::finished,
+        parent,
+        [thread, progress_dialog, parent, on_finished]() {
+            progress_dialog->close();
+
+            g_status->display_ad_messages(thread->get_ad_messages(), parent);
+
+            if (thread->failed_to_connect()) {
+                return;
+            }
+
+            on_finished(thread->get_result_list());
+        },
+        Qt::QueuedConnection);
+
+    // NOTE: delete thread even if parent was destroyed
+    QObject::connect(
+        thread, &WriteThread::finished,
+        thread, &QObject::deleteLater);
+
+    thread->start();
+}
@@ -24,6 +24,8 @@
 
 #include "core/search_thread.h"
 
+#include <functional>
+
 class AdInterface;
 class AdObject;
 class ConsoleWidget;
@@ -40,6 +42,7 @@ class QString;
 class QTreeView;
 class QVariant;
 class QWidget;
+struct AdWriteOperation;
 template <typename K, typename T> class QHash;
 template <typename K, typename T> class QMap;
 template <typename T> class QList;
@@ -153,4 +156,17 @@ QString gpo_status_from_int(int status);
 
 void search_thread_display_errors(SearchThread *thread, QWidget *parent);
 
+// Shows progress of search thread in status bar. Call
+// search_thread_clear_progress() when search is finished.
+void search_thread_display_progress(const int object_count, const int page_count, const qint64 elapsed_ms);
+void search_thread_clear_progress();
+
+// Performs write operations in a background thread. Shows
+// a progress dialog with a cancel button if operations take
+// a while. When finished, messages are displayed and
+// "on_finished" is called with results, in the same order
+// as operations. "on_finished" is not called if parent is
+// destroyed before that.
+void write_thread_start(const QList<AdWriteOperation> &operation_list, const QString &label, QWidget *parent, const std::function<void(const QList<bool> &result_list)> &on_finished);
+
 #endif /* UTILS_H */
@@ -0,0 +1,264 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "admc_test_ad_filter_matcher.h"
+
+#include "ad_config.h"
+#include "ad_defines.h"
+#include "ad_filter.h"
+#include "ad_filter_matcher.h"
+#include "ad_interface.h"
+#include "ad_object.h"
+
+#include <QLocale>
+
+const QString test_dn = "CN=test-user,CN=Users,DC=foodomain,DC=com";
+
+const QHash<QString, QList<QByteArray>> test_attributes_data = {
+    {ATTRIBUTE_OBJECT_CLASS, {"top", "person", "organizationalPerson", "user"}},
+    {ATTRIBUTE_OBJECT_CATEGORY, {"CN=Person,CN=Schema,CN=Configuration,DC=foodomain,DC=com"}},
+    {ATTRIBUTE_NAME, {"test-user"}},
+    {ATTRIBUTE_DESCRIPTION, {"Some (description) *"}},
+    {ATTRIBUTE_USER_ACCOUNT_CONTROL, {"514"}},
+    {ATTRIBUTE_GROUP_TYPE, {"-2147483646"}},
+    {ATTRIBUTE_OBJECT_GUID, {QByteArray("\x01\x02\xff", 3)}},
+    // S-1-5-21-1-2-3-500
+    {ATTRIBUTE_OBJECT_SID, {QByteArray("\x01\x05\x00\x00\x00\x00\x00\x05\x15\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00\x00\x03\x00\x00\x00\xf4\x01\x00\x00", 28)}},
+    {"serialNumber", {"ABC"}},
+    {ATTRIBUTE_WHEN_CHANGED, {"20240101000000.0Z"}},
+};
+
+const QString test_sid_escaped = "\\01\\05\\00\\00\\00\\00\\00\\05\\15\\00\\00\\00\\01\\00\\00\\00\\02\\00\\00\\00\\03\\00\\00\\00\\f4\\01\\00\\00";
+
+AdObject make_test_object();
+
+// NOTE: schema is needed for comparisons that depend on
+// attribute syntax. It's only available if there's a
+// connection to AD server, otherwise those tests are
+// skipped.
+void ADMCTestAdFilterMatcher::initTestCase() {
+    AdInterface ad;
+    if (!ad.is_connected()) {
+        return;
+    }
+
+    adconfig = new AdConfig();
+    adconfig->load(ad, QLocale(QLocale::English));
+}
+
+void ADMCTestAdFilterMatcher::cleanupTestCase() {
+    delete adconfig;
+    adconfig = nullptr;
+}
+
+void ADMCTestAdFilterMatcher::is_valid_data() {
+    QTest::addColumn<QString>("filter");
+    QTest::addColumn<bool>("expected_valid");
+
+    QTest::newRow("empty") << "" << true;
+    QTest::newRow("simple") << "(name=test)" << true;
+    QTest::newRow("no parentheses") << "name=test" << true;
+    QTest::newRow("nested") << "(&(|(name=a)(name=b))(!(description=*)))" << true;
+    QTest::newRow("whitespace") << " (& (name=a) (name=b) ) " << true;
+    QTest::newRow("escaped") << "(name=\\28test\\29)" << true;
+    QTest::newRow("extensible") << "(userAccountControl:1.2.840.113556.1.4.803:=2)" << true;
+    QTest::newRow("absolute true") << "(&)" << true;
+    QTest::newRow("unbalanced") << "(&(name=a)" << false;
+    QTest::newRow("trailing garbage") << "(name=a))" << false;
+    QTest::newRow("no attribute") << "(=a)" << false;
+    QTest::newRow("bad escape") << "(name=\\zz)" << false;
+    QTest::newRow("truncated escape") << "(name=a\\2)" << false;
+    QTest::newRow("not without filter") << "(!)" << false;
+}
+
+void ADMCTestAdFilterMatcher::is_valid() {
+    QFETCH(QString, filter);
+    QFETCH(bool, expected_valid);
+
+    const AdFilterMatcher matcher(filter);
+
+    QCOMPARE(matcher.is_valid(), expected_valid);
+}
+
+void ADMCTestAdFilterMatcher::matches_data() {
+    QTest::addColumn<QString>("filter");
+    QTest::addColumn<bool>("expected_matches");
+
+    QTest::newRow("empty") << "" << true;
+    QTest::newRow("equals") << "(name=test-user)" << true;
+    QTest::newRow("equals case-insensitive") << "(name=TEST-USER)" << true;
+    QTest::newRow("attribute case-insensitive") << "(NAME=test-user)" << true;
+    QTest::newRow("not equals") << "(name=other)" << false;
+    QTest::newRow("multi-valued") << "(objectClass=person)" << true;
+    QTest::newRow("present") << "(description=*)" << true;
+    QTest::newRow("not present") << "(mail=*)" << false;
+    QTest::newRow("object class always present") << "(objectClass=*)" << true;
+    QTest::newRow("starts with") << "(name=test*)" << true;
+    QTest::newRow("ends with") << "(name=*user)" << true;
+    QTest::newRow("contains") << "(name=*st-us*)" << true;
+    QTest::newRow("substring any in order") << "(name=t*st*user)" << true;
+    QTest::newRow("substring any out of order") << "(name=*user*test*)" << false;
+    QTest::newRow("substring overlap") << "(name=test*user*r)" << false;
+    QTest::newRow("escaped special chars") << "(description=*\\28description\\29 \\2a)" << true;
+    QTest::newRow("binary") << "(objectGUID=\\01\\02\\ff)" << true;
+    QTest::newRow("binary mismatch") << "(objectGUID=\\01\\02\\fe)" << false;
+    QTest::newRow("sid escaped") << QString("(objectSid=%1)").arg(test_sid_escaped) << true;
+    QTest::newRow("greater or equal") << "(userAccountControl>=514)" << true;
+    QTest::newRow("less or equal") << "(userAccountControl<=100)" << false;
+    QTest::newRow("bit and") << "(userAccountControl:1.2.840.113556.1.4.803:=2)" << true;
+    QTest::newRow("bit and all bits") << "(userAccountControl:1.2.840.113556.1.4.803:=6)" << false;
+    QTest::newRow("bit or") << "(userAccountControl:1.2.840.113556.1.4.804:=6)" << true;
+    QTest::newRow("bit and negative") << "(groupType:1.2.840.113556.1.4.803:=2147483648)" << true;
+    QTest::newRow("bit and negative mask") << "(groupType:1.2.840.113556.1.4.803:=-2147483648)" << true;
+    QTest::newRow("and") << "(&(name=test-user)(objectClass=user))" << true;
+    QTest::newRow("and fails") << "(&(name=test-user)(objectClass=group))" << false;
+    QTest::newRow("or") << "(|(name=other)(objectClass=user))" << true;
+    QTest::newRow("or fails") << "(|(name=other)(objectClass=group))" << false;
+    QTest::newRow("not") << "(!(objectClass=group))" << true;
+    QTest::newRow("absolute false") << "(|)" << false;
+    QTest::newRow("category dn") << "(objectCategory=CN=Person,CN=Schema,CN=Configuration,DC=foodomain,DC=com)" << true;
+    QTest::newRow("built by filter f-ns") << filter_AND({filter_CONDITION(Condition_StartsWith, ATTRIBUTE_NAME, "test"), filter_CONDITION(Condition_Unset, ATTRIBUTE_MAIL)}) << true;
+}
+
+void ADMCTestAdFilterMatcher::matches() {
+    QFETCH(QString, filter);
+    QFETCH(bool, expected_matches);
+
+    const AdFilterMatcher matcher(filter);
+    QVERIFY(matcher.is_valid());
+
+    const AdObject object = make_test_object();
+
+    QCOMPARE(matcher.matches(object), expected_matches);
+}
+
+void ADMCTestAdFilterMatcher::matches_with_schema_data() {
+    QTest::addColumn<QString>("filter");
+    QTest::addColumn<bool>("expected_can_match");
+    QTest::addColumn<bool>("expected_matches");
+
+    // NOTE: these differ from string comparison, where
+    // "514" is greater than "1000"
+    QTest::newRow("integer greater or equal") << "(userAccountControl>=1000)" << true << false;
+    QTest::newRow("integer less or equal") << "(userAccountControl<=1000)" << true << true;
+    QTest::newRow("negative integer greater or equal") << "(groupType>=-3000000000)" << true << true;
+    QTest::newRow("unicode case-insensitive") << "(name=TEST-USER)" << true << true;
+    QTest::newRow("printable case-exact") << "(serialNumber=abc)" << true << false;
+    QTest::newRow("printable case-exact match") << "(serialNumber=ABC)" << true << true;
+    QTest::newRow("sid escaped") << QString("(objectSid=%1)").arg(test_sid_escaped) << true << true;
+    QTest::newRow("sid string") << "(objectSid=S-1-5-21-1-2-3-500)" << false << false;
+    QTest::newRow("octet string") << "(objectGUID=abc)" << false << false;
+    QTest::newRow("generalized time") << "(whenChanged>=20240101000000Z)" << false << false;
+    QTest::newRow("generalized time present") << "(whenChanged=*)" << true << true;
+    QTest::newRow("time from schema") << "(dSCorePropagationData<=20240101000000Z)" << false << false;
+}
+
+void ADMCTestAdFilterMatcher::matches_with_schema() {
+    QFETCH(QString, filter);
+    QFETCH(bool, expected_can_match);
+    QFETCH(bool, expected_matches);
+
+    if (adconfig == nullptr) {
+        QSKIP("Schema is not available, no connection to AD server");
+    }
+
+    const AdFilterMatcher matcher(filter, adconfig);
+    QVERIFY(matcher.is_valid());
+
+    QCOMPARE(matcher.can_match_locally(QList<QString>()), expected_can_match);
+
+    const AdObject object = make_test_object();
+
+    QCOMPARE(matcher.matches(object), expected_matches);
+}
+
+void ADMCTestAdFilterMatcher::can_match_locally_data() {
+    QTest::addColumn<QString>("filter");
+    QTest::addColumn<QList<QString>>("loaded_attributes");
+    QTest::addColumn<bool>("expected_can_match");
+
+    const QList<QString> loaded_attributes = {ATTRIBUTE_NAME, ATTRIBUTE_DESCRIPTION};
+
+    QTest::newRow("loaded") << "(name=a)" << loaded_attributes << true;
+    QTest::newRow("loaded case-insensitive") << "(Description=a)" << loaded_attributes << true;
+    QTest::newRow("not loaded") << "(mail=a)" << loaded_attributes << false;
+    QTest::newRow("not loaded nested") << "(&(name=a)(!(mail=a)))" << loaded_attributes << false;
+    QTest::newRow("all loaded") << "(mail=a)" << QList<QString>() << true;
+    QTest::newRow("object class present") << "(objectClass=*)" << loaded_attributes << true;
+    QTest::newRow("in chain") << filter_matching_rule_in_chain(ATTRIBUTE_MEMBER_OF, test_dn) << QList<QString>() << false;
+    QTest::newRow("category shorthand") << "(objectCategory=person)" << QList<QString>() << false;
+    QTest::newRow("sid string") << "(objectSid=S-1-5-21-1-2-3-500)" << QList<QString>() << false;
+    QTest::newRow("sid escaped") << QString("(objectSid=%1)").arg(test_sid_escaped) << QList<QString>() << true;
+    QTest::newRow("time") << "(whenChanged>=20240101000000Z)" << QList<QString>() << false;
+    QTest::newRow("time equals") << "(whenCreated=20240101000000.0Z)" << QList<QString>() << false;
+    QTest::newRow("time present") << "(whenCreated=*)" << QList<QString>() << true;
+}
+
+void ADMCTestAdFilterMatcher::can_match_locally() {
+    QFETCH(QString, filter);
+    QFETCH(QList<QString>, loaded_attributes);
+    QFETCH(bool, expected_can_match);
+
+    const AdFilterMatcher matcher(filter);
+
+    QCOMPARE(matcher.can_match_locally(loaded_attributes), expected_can_match);
+}
+
+void ADMCTestAdFilterMatcher::is_narrowing_of_data() {
+    QTest::addColumn<QString>("filter");
+    QTest::addColumn<QString>("other_filter");
+    QTest::addColumn<bool>("expected_narrowing");
+
+    QTest::newRow("same") << "(name=a)" << "(name=a)" << true;
+    QTest::newRow("anything narrows empty") << "(name=a)" << "" << true;
+    QTest::newRow("empty doesn't narrow") << "" << "(name=a)" << false;
+    QTest::newRow("added condition") << "(&(name=a)(description=b))" << "(name=a)" << true;
+    QTest::newRow("added condition to and") << "(&(name=a)(description=b)(mail=c))" << "(&(description=b)(name=a))" << true;
+    QTest::newRow("removed condition") << "(name=a)" << "(&(name=a)(description=b))" << false;
+    QTest::newRow("removed or branch") << "(|(objectClass=user)(objectClass=group))" << "(|(objectClass=user)(objectClass=group)(objectClass=contact))" << true;
+    QTest::newRow("added or branch") << "(|(objectClass=user)(objectClass=group))" << "(objectClass=user)" << false;
+    QTest::newRow("different") << "(name=a)" << "(name=b)" << false;
+    QTest::newRow("normalized") << "( & (NAME=a) (description=b) )" << "(name=a)" << true;
+}
+
+void ADMCTestAdFilterMatcher::is_narrowing_of() {
+    QFETCH(QString, filter);
+    QFETCH(QString, other_filter);
+    QFETCH(bool, expected_narrowing);
+
+    const AdFilterMatcher matcher(filter);
+    const AdFilterMatcher other_matcher(other_filter);
+
+    QCOMPARE(matcher.is_narrowing_of(other_matcher), expected_narrowing);
+}
+
+void ADMCTestAdFilterMatcher::to_string() {
+    const AdFilterMatcher matcher(" (&(Name=a*b)(!(objectGUID=\\01\\FF))) ");
+
+    QCOMPARE(matcher.to_string(), QString("(&(name=a*b)(!(objectguid=\\01\\ff)))"));
+}
+
+AdObject make_test_object() {
+    AdObject object;
+    object.load(test_dn, test_attributes_data);
+
+    return object;
+}
+
+QTEST_MAIN(ADMCTestAdFilterMatcher)
@@ -0,0 +1,52 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ADMC_TEST_AD_FILTER_MATCHER_H
+#define ADMC_TEST_AD_FILTER_MATCHER_H
+
+#include <QObject>
+#include <QTest>
+
+class AdConfig;
+
+class ADMCTestAdFilterMatcher : public QObject {
+    Q_OBJECT
+
+public slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+private slots:
+    void is_valid_data();
+    void is_valid();
+    void matches_data();
+    void matches();
+    void matches_with_schema_data();
+    void matches_with_schema();
+    void can_match_locally_data();
+    void can_match_locally();
+    void is_narrowing_of_data();
+    void is_narrowing_of();
+    void to_string();
+
+private:
+    AdConfig *adconfig = nullptr;
+};
+
+#endif /* ADMC_TEST_AD_FILTER_MATCHER_H */
@@ -23,6 +23,7 @@
 #include "core/globals.h"
 #include "samba/dom_sid.h"
 
+#include <QElapsedTimer>
 #include <QTest>
 
 #define TEST_GPO "ADMCTestAdInterface_TEST_GPO"
@@ -125,6 +126,15 @@ void ADMCTestAdInterface::gpo_check_perms() {
     QVERIFY(gpo_check_perms_ok_2);
     QCOMPARE(perms_after, false);
 
+    // Syncing should make GPT perms match GPC perms again
+    const bool sync_success = ad.gpo_sync_perms(gpc_dn);
+    QVERIFY(sync_success);
+
+    bool gpo_check_perms_ok_3 = true;
+    const bool perms_after_sync = ad.gpo_check_perms(gpc_dn, &gpo_check_perms_ok_3);
+    QVERIFY(gpo_check_perms_ok_3);
+    QCOMPARE(perms_after_sync, true);
+
     bool deleted_object;
     const bool delete_success = ad.gpo_delete(gpc_dn, &deleted_object);
     QVERIFY(delete_success);
@@ -180,6 +190,124 @@ void ADMCTestAdInterface::object_rename() {
     QVERIFY(object_exists(new_dn));
 }
 
+// Writes through AdInterface should invalidate cached
+// objects, including back links of linked attributes
+void ADMCTestAdInterface::search_object_cache() {
+    const QString user_dn = test_object_dn(TEST_USER, CLASS_USER);
+    const bool add_user_success = ad.object_add(user_dn, CLASS_USER);
+    QVERIFY(add_user_success);
+
+    const QString group_dn = test_object_dn(TEST_GROUP, CLASS_GROUP);
+    const bool add_group_success = ad.object_add(group_dn, CLASS_GROUP);
+    QVERIFY(add_group_success);
+
+    const AdObject user_before = ad.search_object(user_dn);
+    QVERIFY(user_before.contains(ATTRIBUTE_USN_CHANGED));
+    QVERIFY(user_before.get_strings(ATTRIBUTE_MEMBER_OF).isEmpty());
+
+    const QString description = "test-description";
+    const bool replace_success = ad.attribute_replace_string(user_dn, ATTRIBUTE_DESCRIPTION, description);
+    QVERIFY(replace_success);
+
+    const AdObject user_after_replace = ad.search_object(user_dn);
+    QCOMPARE(user_after_replace.get_string(ATTRIBUTE_DESCRIPTION), description);
+
+    const bool add_member_success = ad.group_add_member(group_dn, user_dn);
+    QVERIFY(add_member_success);
+
+    const AdObject user_after_add = ad.search_object(user_dn);
+    QCOMPARE(user_after_add.get_strings(ATTRIBUTE_MEMBER_OF), QList<QString>({group_dn}));
+
+    // Back link of a linked attribute other than member
+    const bool set_manager_success = ad.attribute_replace_string(group_dn, ATTRIBUTE_MANAGED_BY, user_dn);
+    QVERIFY(set_manager_success);
+
+    const AdObject user_after_manage = ad.search_object(user_dn);
+    QCOMPARE(user_after_manage.get_strings(ATTRIBUTE_MANAGED_OBJECTS), QList<QString>({group_dn}));
+}
+
+void ADMCTestAdInterface::notification() {
+    AdInterface watcher_ad;
+    QVERIFY(watcher_ad.is_connected());
+
+    const int notification_id = watcher_ad.notification_start(test_arena_dn(), {ATTRIBUTE_DESCRIPTION, ATTRIBUTE_OBJECT_GUID});
+    QVERIFY(notification_id != -1);
+
+    const QString user_dn = test_object_dn(TEST_USER, CLASS_USER);
+    const bool add_user_success = ad.object_add(user_dn, CLASS_USER);
+    QVERIFY(add_user_success);
+
+    const QString description = "test-description";
+    const bool replace_success = ad.attribute_replace_string(user_dn, ATTRIBUTE_DESCRIPTION, description);
+    QVERIFY(replace_success);
+
+    // NOTE: notifications are sent asynchronously, so
+    // wait until modification arrives
+    QElapsedTimer timer;
+    timer.start();
+    QString received_description;
+    while (received_description != description && !timer.hasExpired(10000)) {
+        QHash<QString, AdObject> results;
+        const bool wait_success = watcher_ad.notification_wait(500, &results);
+        QVERIFY(wait_success);
+
+        if (results.contains(user_dn)) {
+            received_description = results[user_dn].get_string(ATTRIBUTE_DESCRIPTION);
+        }
+    }
+
+    QCOMPARE(received_description, description);
+
+    watcher_ad.notification_stop(notification_id);
+}
+
+void ADMCTestAdInterface::write_queue() {
+    const QString ou_dn = test_object_dn(TEST_OU, CLASS_OU);
+    const bool add_ou_success = ad.object_add(ou_dn, CLASS_OU);
+    QVERIFY(add_ou_success);
+
+    QList<QString> user_list;
+    for (int i = 0; i < 3; i++) {
+        const QString user_dn = test_object_dn(QString("%1-%2").arg(TEST_USER).arg(i), CLASS_USER);
+        const bool add_user_success = ad.object_add(user_dn, CLASS_USER);
+        QVERIFY(add_user_success);
+
+        user_list.append(user_dn);
+    }
+
+    // NOTE: last operation fails because object doesn't
+    // exist
+    const QString missing_dn = test_object_dn(TEST_OBJECT, CLASS_USER);
+    const QList<AdWriteOperation> operation_list = {
+        AdWriteOperation::make_account_option(user_list[0], AccountOption_DontExpirePassword, true),
+        AdWriteOperation::make_move(user_list[1], ou_dn),
+        AdWriteOperation::make_delete(user_list[2]),
+        AdWriteOperation::make_delete(missing_dn),
+    };
+
+    int last_done_count = 0;
+    AdWriteQueue queue(ad);
+    queue.set_max_in_flight(2);
+    queue.set_progress_callback(
+        [&](const int done_count, const int total_count) {
+            QCOMPARE(total_count, operation_list.size());
+            last_done_count = done_count;
+        });
+
+    const QList<bool> result_list = queue.run(operation_list);
+    QCOMPARE(result_list, QList<bool>({true, true, true, false}));
+    QCOMPARE(last_done_count, operation_list.size());
+
+    const AdObject modified_user = ad.search_object(user_list[0]);
+    QVERIFY(modified_user.get_account_option(AccountOption_DontExpirePassword, g_adconfig));
+
+    const QString moved_dn = dn_move(user_list[1], ou_dn);
+    QVERIFY(object_exists(moved_dn));
+    QVERIFY(!object_exists(user_list[1]));
+
+    QVERIFY(!object_exists(user_list[2]));
+}
+
 void ADMCTestAdInterface::group_add_member() {
     const QString user_dn = test_object_dn(TEST_USER, CLASS_USER);
     const bool add_user_success = ad.object_add(user_dn, CLASS_USER);
@@ -211,6 +339,100 @@ void ADMCTestAdInterface::group_remove_member() {
     QVERIFY(member_list.isEmpty());
 }
 
+// NOTE: request small ranges, so that values are retrieved
+// in multiple range requests without having to add more
+// than MaxValRange (1500 by default) members
+void ADMCTestAdInterface::group_member_range() {
+    const int member_count = 5;
+    const int range_size = 2;
+
+    const QString group_dn = test_object_dn(TEST_GROUP, CLASS_GROUP);
+    const bool add_group_success = ad.object_add(group_dn, CLASS_GROUP);
+    QVERIFY(add_group_success);
+
+    QList<QString> user_list;
+    for (int i = 0; i < member_count; i++) {
+        const QString user_dn = test_object_dn(QString("%1-%2").arg(TEST_USER).arg(i), CLASS_USER);
+        const bool add_user_success = ad.object_add(user_dn, CLASS_USER);
+        QVERIFY(add_user_success);
+
+        user_list.append(user_dn);
+    }
+
+    const bool add_members_success = ad.group_add_members(group_dn, user_list);
+    QVERIFY(add_members_success);
+
+    QList<QString> member_list;
+    int start = 0;
+    int request_count = 0;
+    while (start != -1) {
+        QList<QByteArray> values;
+        int next_start;
+        const bool success = ad.search_attribute_range(group_dn, ATTRIBUTE_MEMBER, start, &values, &next_start, range_size);
+        QVERIFY(success);
+
+        request_count++;
+        QVERIFY(values.size() <= range_size);
+
+        // NOTE: next range starts right after this one,
+        // unless this is the last range
+        if (next_start != -1) {
+            QCOMPARE(values.size(), range_size);
+            QCOMPARE(next_start, start + range_size);
+        }
+
+        member_list += bytearray_list_to_string_list(values);
+        start = next_start;
+
+        QVERIFY2(request_count <= member_count, "Range retrieval doesn't end");
+    }
+
+    QCOMPARE(request_count, 3);
+    QCOMPARE(member_list.size(), member_count);
+    QCOMPARE(QSet<QString>(member_list.begin(), member_list.end()), QSet<QString>(user_list.begin(), user_list.end()));
+
+    // Range that is left to server contains all members
+    QList<QByteArray> all_values;
+    int all_next_start;
+    const bool all_success = ad.search_attribute_range(group_dn, ATTRIBUTE_MEMBER, 0, &all_values, &all_next_start);
+    QVERIFY(all_success);
+    QCOMPARE(all_values.size(), member_count);
+    QCOMPARE(all_next_start, -1);
+}
+
+void ADMCTestAdInterface::group_add_remove_members() {
+    const QString group_dn = test_object_dn(TEST_GROUP, CLASS_GROUP);
+    const bool add_group_success = ad.object_add(group_dn, CLASS_GROUP);
+    QVERIFY(add_group_success);
+
+    QList<QString> user_list;
+    for (int i = 0; i < 3; i++) {
+        const QString user_dn = test_object_dn(QString("%1-%2").arg(TEST_USER).arg(i), CLASS_USER);
+        const bool add_user_success = ad.object_add(user_dn, CLASS_USER);
+        QVERIFY(add_user_success);
+
+        user_list.append(user_dn);
+    }
+
+    // NOTE: first user is already a member, so batch is
+    // rejected and members are added one by one
+    const bool add_first_success = ad.group_add_member(group_dn, user_list[0]);
+    QVERIFY(add_first_success);
+
+    const bool add_all_success = ad.group_add_members(group_dn, user_list);
+    QVERIFY(!add_all_success);
+
+    const AdObject group_after_add = ad.search_object(group_dn);
+    const QList<QString> member_list = group_after_add.get_strings(ATTRIBUTE_MEMBER);
+    QCOMPARE(QSet<QString>(member_list.begin(), member_list.end()), QSet<QString>(user_list.begin(), user_list.end()));
+
+    const bool remove_all_success = ad.group_remove_members(group_dn, user_list);
+    QVERIFY(remove_all_success);
+
+    const AdObject group_after_remove = ad.search_object(group_dn);
+    QVERIFY(group_after_remove.get_strings(ATTRIBUTE_MEMBER).isEmpty());
+}
+
 void ADMCTestAdInterface::group_set_scope() {
     const QString group_dn = test_object_dn(TEST_GROUP, CLASS_GROUP);
     const bool add_group_success = ad.object_add(group_dn, CLASS_GROUP);
@@ -39,11 +39,17 @@ private slots:
 
     void group_add_member();
     void group_remove_member();
+    void group_member_range();
+    void group_add_remove_members();
     void group_set_scope();
     void group_set_type();
 
     void user_set_account_option();
 
+    void search_object_cache();
+    void notification();
+    void write_queue();
+
 private:
 };
 
@@ -0,0 +1,189 @@
+/*
+ * ADMC - AD Management Center
+ *
+ * Copyright (C) 2026 BaseALT Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "admc_test_ad_object.h"
+
+#include "ad_defines.h"
+#include "ad_object.h"
+
+#include <malloc.h>
+
+#define BENCHMARK_OBJECT_COUNT 20000
+
+const QString test_dn = "CN=test-user,CN=Users,DC=foodomain,DC=com";
+
+const QHash<QString, QList<QByteArray>> test_attributes_data = {
+    {ATTRIBUTE_OBJECT_CLASS, {"top", "person", "organizationalPerson", "user"}},
+    {ATTRIBUTE_NAME, {"test-user"}},
+    {ATTRIBUTE_DESCRIPTION, {"description"}},
+    {ATTRIBUTE_MEMBER_OF, {"CN=group-1,DC=foodomain,DC=com", "CN=group-2,DC=foodomain,DC=com"}},
+    {ATTRIBUTE_USER_ACCOUNT_CONTROL, {"512"}},
+    {ATTRIBUTE_MAIL, {""}},
+};
+
+// Replica of previous AdObject layout, for comparison
+struct OldLayoutObject {
+    QString dn;
+    QHash<QString, QList<QByteArray>> attributes_data;
+};
+
+QHash<QString, QList<QByteArray>> make_benchmark_attributes(const int i);
+size_t get_allocated_bytes();
+
+void ADMCTestAdObject::empty() {
+    const AdObject object;
+
+    QVERIFY(object.is_empty());
+    QVERIFY(!object.contains(ATTRIBUTE_NAME));
+    QVERIFY(object.get_values(ATTRIBUTE_NAME).isEmpty());
+    QCOMPARE(object.get_string(ATTRIBUTE_NAME), QString());
+    QCOMPARE(object.get_dn(), QString());
+}
+
+void ADMCTestAdObject::get_values() {
+    AdObject object;
+    object.load(test_dn, test_attributes_data);
+
+    QCOMPARE(object.get_dn(), test_dn);
+    QVERIFY(!object.is_empty());
+
+    for (const QString &attribute : test_attributes_data.keys()) {
+        QVERIFY(object.contains(attribute));
+        QCOMPARE(object.get_values(attribute), test_attributes_data[attribute]);
+    }
+
+    QVERIFY(!object.contains(ATTRIBUTE_CN));
+    QVERIFY(object.get_values(ATTRIBUTE_CN).isEmpty());
+}
+
+void ADMCTestAdObject::get_string() {
+    AdObject object;
+    object.load(test_dn, test_attributes_data);
+
+    QCOMPARE(object.get_string(ATTRIBUTE_NAME), QString("test-user"));
+    QCOMPARE(object.get_string(ATTRIBUTE_OBJECT_CLASS), QString("user"));
+    QCOMPARE(object.get_string(ATTRIBUTE_MAIL), QString(""));
+    QCOMPARE(object.get_int(ATTRIBUTE_USER_ACCOUNT_CONTROL), 512);
+}
+
+void ADMCTestAdObject::attributes() {
+    AdObject object;
+    object.load(test_dn, test_attributes_data);
+
+    QList<QString> actual = object.attributes();
+    QList<QString> expected = test_attributes_data.keys();
+    std::sort(actual.begin(), actual.end());
+    std::sort(expected.begin(), expected.end());
+
+    QCOMPARE(actual, expected);
+}
+
+void ADMCTestAdObject::get_attributes_data() {
+    AdObject object;
+    object.load(test_dn, test_attributes_data);
+
+    QCOMPARE(object.get_attributes_data(), test_attributes_data);
+}
+
+void ADMCTestAdObject::copy() {
+    AdObject object;
+    object.load(test_dn, test_attributes_data);
+
+    AdObject copy = object;
+    QCOMPARE(copy.get_attributes_data(), test_attributes_data);
+
+    // Reloading copy must not change original
+    copy.load(test_dn, {{ATTRIBUTE_NAME, {"other-name"}}});
+    QCOMPARE(copy.get_string(ATTRIBUTE_NAME), QString("other-name"));
+    QCOMPARE(object.get_string(ATTRIBUTE_NAME), QString("test-user"));
+}
+
+// Compares heap usage of old and new layouts for a large
+// search result
+void ADMCTestAdObject::memory_benchmark() {
+    size_t old_layout_bytes;
+    {
+        const size_t bytes_before = get_allocated_bytes();
+
+        QHash<QString, OldLayoutObject> results;
+        for (int i = 0; i < BENCHMARK_OBJECT_COUNT; i++) {
+            OldLayoutObject object;
+            object.dn = QString("CN=user-%1,CN=Users,DC=foodomain,DC=com").arg(i);
+            object.attributes_data = make_benchmark_attributes(i);
+
+            results.insert(object.dn, object);
+        }
+
+        old_layout_bytes = get_allocated_bytes() - bytes_before;
+    }
+
+    size_t new_layout_bytes;
+    {
+        const size_t bytes_before = get_allocated_bytes();
+
+        QHash<QString, AdObject> results;
+        for (int i = 0; i < BENCHMARK_OBJECT_COUNT; i++) {
+            const QString dn = QString("CN=user-%1,CN=Users,DC=foodomain,DC=com").arg(i);
+
+            AdObject object;
+            object.load(dn, make_benchmark_attributes(i));
+
+            results.insert(dn, object);
+        }
+
+        new_layout_bytes = get_allocated_bytes() - bytes_before;
+    }
+
+    qInfo() << "Memory for" << BENCHMARK_OBJECT_COUNT << "objects:";
+    qInfo() << "    old layout:" << old_layout_bytes << "bytes";
+    qInfo() << "    new layout:" << new_layout_bytes << "bytes";
+
+    QVERIFY(new_layout_bytes < old_layout_bytes);
+}
+
+// NOTE: values are created for each object separately, to
+// imitate values decoded from server response
+QHash<QString, QList<QByteArray>> make_benchmark_attributes(const int i) {
+    const QByteArray number = QByteArray::number(i);
+
+    const QHash<QString, QList<QByteArray>> out = {
+        {QString(ATTRIBUTE_OBJECT_CLASS), {QByteArray("top"), QByteArray("person"), QByteArray("organizationalPerson"), QByteArray("user")}},
+        {QString(ATTRIBUTE_NAME), {"user-" + number}},
+        {QString(ATTRIBUTE_CN), {"user-" + number}},
+        {QString(ATTRIBUTE_DN), {"CN=user-" + number + ",CN=Users,DC=foodomain,DC=com"}},
+        {QString(ATTRIBUTE_DESCRIPTION), {"Description of user " + number}},
+        {QString(ATTRIBUTE_SAM_ACCOUNT_NAME), {"user-" + number}},
+        {QString(ATTRIBUTE_USER_PRINCIPAL_NAME), {"user-" + number + "@foodomain.com"}},
+        {QString(ATTRIBUTE_USER_ACCOUNT_CONTROL), {QByteArray("512")}},
+        {QString(ATTRIBUTE_WHEN_CHANGED), {QByteArray("20260101000000.0Z")}},
+        {QString(ATTRIBUTE_USN_CHANGED), {QByteArray::number(100000 + i)}},
+        {QString(ATTRIBUTE_MEMBER_OF), {QByteArray("CN=Domain Users,CN=Users,DC=foodomain,DC=com"), QByteArray("CN=group-") + QByteArray::number(i % 100) + ",DC=foodomain,DC=com"}},
+    };
+
+    return out;
+}
+
+size_t get_allocated_bytes() {
+    const struct mallinfo2 info = mallinfo2();
+
+    return info.uordblks;
+}
+
+QTEST_MAIN(ADMCTestAdObject)
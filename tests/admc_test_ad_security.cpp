@@ -104,6 +104,93 @@ void ADMCTestAdSecurity::remove_trustee() {
     }
 }
 
+void ADMCTestAdSecurity::get_trustee_name_map() {
+    ad_security_clear_trustee_name_cache();
+
+    const QByteArray everyone_sid = sid_string_to_bytes(SID_WORLD);
+    const QByteArray unknown_sid = sid_string_to_bytes("S-1-5-21-1-2-3-987654");
+
+    const QHash<QByteArray, QString> name_map = ad_security_get_trustee_name_map(ad, {test_trustee, everyone_sid, unknown_sid});
+
+    QCOMPARE(name_map.size(), 3);
+    QCOMPARE(name_map[everyone_sid], ad_security_get_well_known_trustee_name(everyone_sid));
+    QCOMPARE(name_map[unknown_sid], object_sid_display_value(unknown_sid));
+
+    const QString test_trustee_name = name_map[test_trustee];
+    QVERIFY(test_trustee_name != object_sid_display_value(test_trustee));
+
+    // Resolved names should be cached, unresolved
+    // shouldn't
+    QCOMPARE(ad_security_get_cached_trustee_name(test_trustee), test_trustee_name);
+    QVERIFY(ad_security_get_cached_trustee_name(unknown_sid).isEmpty());
+
+    // Single trustee version should give the same result
+    QCOMPARE(ad_security_get_trustee_name(ad, test_trustee), test_trustee_name);
+}
+
+// Index should give same states as direct lookup, also
+// after descriptor is edited
+void ADMCTestAdSecurity::descriptor_index() {
+    const QList<SecurityRight> right_list = ad_security_get_right_list_for_class(ad.adconfig(), class_list);
+    QVERIFY(!right_list.isEmpty());
+
+    const QList<QByteArray> trustee_list = security_descriptor_get_trustee_list(sd);
+
+    auto compare_states = [&](const SecurityDescriptorIndex &index, const QByteArray &trustee) {
+        const QList<SecurityRightState> state_list = index.get_right_state_list(trustee, right_list);
+        QCOMPARE(state_list.size(), right_list.size());
+
+        for (int i = 0; i < right_list.size(); i++) {
+            const SecurityRightState expected = security_descriptor_get_right_state(sd, trustee, right_list[i]);
+
+            for (int inherited = 0; inherited < SecurityRightStateInherited_COUNT; inherited++) {
+                for (int type = 0; type < SecurityRightStateType_COUNT; type++) {
+                    const SecurityRightStateInherited inherited_enum = (SecurityRightStateInherited) inherited;
+                    const SecurityRightStateType type_enum = (SecurityRightStateType) type;
+
+                    QCOMPARE(state_list[i].get(inherited_enum, type_enum), expected.get(inherited_enum, type_enum));
+                }
+            }
+        }
+    };
+
+    SecurityDescriptorIndex index;
+    index.load(sd);
+
+    for (const QByteArray &trustee : trustee_list) {
+        compare_states(index, trustee);
+    }
+
+    SecurityRight right{SEC_ADS_CREATE_CHILD, QByteArray(), QByteArray(), 0};
+    security_descriptor_add_right(sd, ad.adconfig(), class_list, test_trustee, right, true);
+    index.update_trustee(sd, test_trustee);
+
+    compare_states(index, test_trustee);
+}
+
+// Subordinate lists are cached per class, check that
+// cached list still uses inherited object type and flags
+// of the right that was passed in
+void ADMCTestAdSecurity::subordinate_right_list_cache() {
+    const SecurityRight right{SEC_ADS_GENERIC_READ, QByteArray(), QByteArray(), 0};
+    const QList<SecurityRight> first_list = ad_security_get_subordinate_right_list(ad.adconfig(), right, class_list);
+    QVERIFY(!first_list.isEmpty());
+
+    const QByteArray inherited_type = ad.adconfig()->guid_from_class(CLASS_USER);
+    const SecurityRight inherited_right{SEC_ADS_GENERIC_READ, QByteArray(), inherited_type, SEC_ACE_FLAG_CONTAINER_INHERIT};
+    const QList<SecurityRight> second_list = ad_security_get_subordinate_right_list(ad.adconfig(), inherited_right, class_list);
+    QCOMPARE(second_list.size(), first_list.size());
+
+    for (int i = 0; i < first_list.size(); i++) {
+        QCOMPARE(second_list[i].access_mask, first_list[i].access_mask);
+        QCOMPARE(second_list[i].object_type, first_list[i].object_type);
+        QCOMPARE(second_list[i].inherited_object_type, inherited_type);
+        QCOMPARE(second_list[i].flags, (uint8_t) SEC_ACE_FLAG_CONTAINER_INHERIT);
+    }
+
+    QCOMPARE(ad_security_get_right_list_for_class(ad.adconfig(), class_list), ad_security_get_right_list_for_class(ad.adconfig(), class_list));
+}
+
 // Removing generic read while full control is
 // allowed, should leave generic write, even though
 // they share a bit, and vice versa
@@ -43,6 +43,9 @@ private slots:
     void add_right();
     void remove_right();
     void remove_trustee();
+    void get_trustee_name_map();
+    void descriptor_index();
+    void subordinate_right_list_cache();
     void handle_generic_read_and_write_sharing_bit();
     void protected_against_deletion_data();
     void protected_against_deletion();
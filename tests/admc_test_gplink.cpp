@@ -34,6 +34,12 @@ const QString gplink_A = "[LDAP://cn={AAAAAAAA-AAAA-AAAA-AAAA-AAAAAAAAAAAA},cn=p
 const QString gplink_B = "[LDAP://cn={BBBBBBBB-BBBB-BBBB-BBBB-BBBBBBBBBBBB},cn=policies,cn=system,DC=foodomain,DC=com;1]";
 const QString gplink_C = "[LDAP://cn={CCCCCCCC-CCCC-CCCC-CCCC-CCCCCCCCCCCC},cn=policies,cn=system,DC=foodomain,DC=com;2]";
 
+// NOTE: number of links in a gplink of a large OU, for
+// benchmarks
+#define MANY_LINKS_COUNT 500
+
+QString make_many_links_gplink_string();
+
 void ADMCTestGplink::initTestCase() {
 }
 
@@ -294,4 +300,71 @@ void ADMCTestGplink::get_gpo_order() {
     QCOMPARE(actual_order, expected_order);
 }
 
+void ADMCTestGplink::parse_data() {
+    QTest::addColumn<QString>("gplink_string");
+    QTest::addColumn<QList<QString>>("expected_gpo_list");
+
+    QTest::newRow("empty") << "" << QList<QString>();
+    QTest::newRow("whitespace") << " " << QList<QString>();
+    QTest::newRow("too many separators") << "[LDAP://cn={AAAAAAAA-AAAA-AAAA-AAAA-AAAAAAAAAAAA},cn=policies,cn=system,DC=foodomain,DC=com;0;1]" << QList<QString>();
+    QTest::newRow("no separator") << "[LDAP://cn={AAAAAAAA-AAAA-AAAA-AAAA-AAAAAAAAAAAA},cn=policies,cn=system,DC=foodomain,DC=com]" << QList<QString>();
+    QTest::newRow("no prefix") << "[cn={AAAAAAAA-AAAA-AAAA-AAAA-AAAAAAAAAAAA},cn=policies,cn=system,DC=foodomain,DC=com;0]" << QList<QString>({dn_A});
+    QTest::newRow("no brackets") << "LDAP://cn={AAAAAAAA-AAAA-AAAA-AAAA-AAAAAAAAAAAA},cn=policies,cn=system,DC=foodomain,DC=com;0" << QList<QString>({dn_A});
+    QTest::newRow("extra brackets") << "[[LDAP://cn={AAAAAAAA-AAAA-AAAA-AAAA-AAAAAAAAAAAA},cn=policies,cn=system,DC=foodomain,DC=com;0]]" << QList<QString>({dn_A});
+    // NOTE: gpo list is in reverse order compared to gplink string
+    QTest::newRow("malformed part is skipped") << (gplink_A + "[garbage]" + gplink_B) << QList<QString>({dn_B, dn_A});
+}
+
+void ADMCTestGplink::parse() {
+    QFETCH(QString, gplink_string);
+    QFETCH(QList<QString>, expected_gpo_list);
+
+    const Gplink gplink(gplink_string);
+
+    QCOMPARE(gplink.get_gpo_list(), expected_gpo_list);
+}
+
+void ADMCTestGplink::many_links() {
+    const QString gplink_string = make_many_links_gplink_string();
+
+    const Gplink gplink(gplink_string);
+
+    QCOMPARE(gplink.get_gpo_list().size(), MANY_LINKS_COUNT);
+    QCOMPARE(gplink.get_max_order(), MANY_LINKS_COUNT);
+    QCOMPARE(gplink.to_string(), gplink_string);
+}
+
+void ADMCTestGplink::parse_benchmark() {
+    const QString gplink_string = make_many_links_gplink_string();
+
+    QBENCHMARK {
+        const Gplink gplink(gplink_string);
+        Q_UNUSED(gplink);
+    }
+}
+
+void ADMCTestGplink::to_string_benchmark() {
+    const Gplink gplink(make_many_links_gplink_string());
+
+    QString gplink_string;
+    QBENCHMARK {
+        gplink_string = gplink.to_string();
+    }
+
+    QVERIFY(!gplink_string.isEmpty());
+}
+
+QString make_many_links_gplink_string() {
+    QString out;
+
+    for (int i = 0; i < MANY_LINKS_COUNT; i++) {
+        const QString uuid = QString("%1-AAAA-AAAA-AAAA-AAAAAAAAAAAA").arg(i, 8, 16, QChar('0')).toUpper();
+        const int option = i % 4;
+
+        out += QString("[LDAP://cn={%1},cn=policies,cn=system,DC=foodomain,DC=com;%2]").arg(uuid).arg(option);
+    }
+
+    return out;
+}
+
 QTEST_MAIN(ADMCTestGplink)
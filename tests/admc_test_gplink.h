@@ -54,6 +54,11 @@ private slots:
     void get_gpo_list();
     void get_gpo_order_data();
     void get_gpo_order();
+    void parse_data();
+    void parse();
+    void many_links();
+    void parse_benchmark();
+    void to_string_benchmark();
 };
 
 #endif /* ADMC_TEST_GPLINK_H */
@@ -164,4 +164,56 @@ void ADMCTestPolicyResultsWidget::delete_link() {
     QCOMPARE(updated_gplink_contains_gpo, false);
 }
 
+void ADMCTestPolicyResultsWidget::effective_policy_list() {
+    // NOTE: precedence is computed from gplink manager's
+    // index only, so OU's don't have to exist on server
+    const QString ou_dn = test_object_dn(TEST_OU, CLASS_OU);
+    const QString child_dn = dn_from_name_and_parent("child", ou_dn, CLASS_OU);
+
+    auto find_policy = [&](const QString &target_ou_dn) {
+        const QList<EffectivePolicy> policy_list = g_gplink_manager->effective_policy_list(target_ou_dn);
+
+        for (const EffectivePolicy &policy : policy_list) {
+            if (policy.gpo_dn.toLower() == gpo.toLower()) {
+                return policy;
+            }
+        }
+
+        return EffectivePolicy();
+    };
+
+    Gplink gplink;
+    gplink.add(gpo);
+    g_gplink_manager->set_gplink(ou_dn, gplink.to_string());
+
+    // Link of parent is inherited by child
+    const EffectivePolicy inherited = find_policy(child_dn);
+    QCOMPARE(inherited.ou_dn, ou_dn);
+    QCOMPARE(inherited.is_enforced, false);
+
+    // Blocking inheritance on child hides parent's link
+    g_gplink_manager->set_inheritance_blocked(child_dn, true);
+    QVERIFY(find_policy(child_dn).gpo_dn.isEmpty());
+    QVERIFY(!find_policy(ou_dn).gpo_dn.isEmpty());
+
+    // Unless link is enforced
+    gplink.set_option(gpo, GplinkOption_Enforced, true);
+    g_gplink_manager->set_gplink(ou_dn, gplink.to_string());
+    const EffectivePolicy enforced = find_policy(child_dn);
+    QCOMPARE(enforced.ou_dn, ou_dn);
+    QCOMPARE(enforced.is_enforced, true);
+
+    // Disabled links don't apply
+    gplink.set_option(gpo, GplinkOption_Disabled, true);
+    g_gplink_manager->set_gplink(ou_dn, gplink.to_string());
+    QVERIFY(find_policy(ou_dn).gpo_dn.isEmpty());
+
+    QVERIFY(g_gplink_manager->linked_ou_list(gpo).contains(ou_dn));
+
+    g_gplink_manager->set_gplink(ou_dn, QString());
+    g_gplink_manager->set_inheritance_blocked(child_dn, false);
+
+    QVERIFY(!g_gplink_manager->linked_ou_list(gpo).contains(ou_dn));
+}
+
 QTEST_MAIN(ADMCTestPolicyResultsWidget)
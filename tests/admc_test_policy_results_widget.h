@@ -39,6 +39,7 @@ private slots:
     void load_empty();
     void load();
     void delete_link();
+    void effective_policy_list();
 
 private:
     PolicyResultsWidget *widget;